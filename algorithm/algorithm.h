@@ -5,7 +5,14 @@
 #ifndef STL_FROM_SCRATCH_ALGORITHM_H
 #define STL_FROM_SCRATCH_ALGORITHM_H
 
+#include "./non_modifying_sequence.h"
 #include "./modifying_sequence.h"
 #include "./permutation.h"
+#include "./binary_search.h"
+#include "./heap.h"
+#include "./sort.h"
+#include "./radix_sort.h"
+#include "./stable_sort.h"
+#include "./sorting_network.h"
 
 #endif //STL_FROM_SCRATCH_ALGORITHM_H
@@ -0,0 +1,48 @@
+#ifndef STL_FROM_SCRATCH_BINARY_SEARCH_H
+#define STL_FROM_SCRATCH_BINARY_SEARCH_H
+
+#include "../iterator/iterator_traits.h"
+
+namespace Readable {
+    /**
+     * 在有序序列[first, last)中找到第一个不小于 @arg value 的位置
+     * @param comp 比较函数，comp(a, b)为true表示a应排在b之前
+     */
+    template<typename ForwardIt, typename T, typename Compare>
+    ForwardIt lower_bound(ForwardIt first, ForwardIt last, const T &value, Compare comp) {
+        auto count = Readable::distance(first, last);
+        while (count > 0) {
+            auto half = count / 2;
+            ForwardIt middle = Readable::next(first, half);
+            if (comp(*middle, value)) {
+                first = ++middle;
+                count -= half + 1;
+            } else {
+                count = half;
+            }
+        }
+        return first;
+    }
+
+    /**
+     * 在有序序列[first, last)中找到第一个大于 @arg value 的位置
+     * @param comp 比较函数，comp(a, b)为true表示a应排在b之前
+     */
+    template<typename ForwardIt, typename T, typename Compare>
+    ForwardIt upper_bound(ForwardIt first, ForwardIt last, const T &value, Compare comp) {
+        auto count = Readable::distance(first, last);
+        while (count > 0) {
+            auto half = count / 2;
+            ForwardIt middle = Readable::next(first, half);
+            if (!comp(value, *middle)) {
+                first = ++middle;
+                count -= half + 1;
+            } else {
+                count = half;
+            }
+        }
+        return first;
+    }
+}
+
+#endif //STL_FROM_SCRATCH_BINARY_SEARCH_H
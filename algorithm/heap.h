@@ -0,0 +1,166 @@
+#ifndef STL_FROM_SCRATCH_HEAP_H
+#define STL_FROM_SCRATCH_HEAP_H
+
+#include <utility>
+#include "../iterator/iterator.h"
+#include "../functional/functional.h"
+
+namespace Readable {
+    namespace heap_detail {
+        /**
+         * 把 @arg value 从位置 @arg hole 向上移动到不小于top的合适位置
+         * 空出来的位置（hole）沿路径上移，父节点依次下移一层，最后把value放进去，每层只有一次移动而不是交换
+         */
+        template<typename RandomIt, typename Distance, typename T, typename Compare>
+        void push_hole_up(RandomIt first, Distance hole, Distance top, T value, Compare &comp) {
+            Distance parent = (hole - 1) / 2;
+            while (hole > top && comp(*(first + parent), value)) {
+                *(first + hole) = iter_move(first + parent);
+                hole = parent;
+                parent = (hole - 1) / 2;
+            }
+            *(first + hole) = std::move(value);
+        }
+
+        /**
+         * 位置 @arg hole 空出后，把 @arg value 放进以它为根的子堆
+         * 先让空位一直沿较大的子节点下沉到叶子，再把value从叶子向上调整：
+         * value通常来自堆的末尾，很可能属于底层，这样比每层都和两个子节点比较少一半比较
+         */
+        template<typename RandomIt, typename Distance, typename T, typename Compare>
+        void adjust_heap(RandomIt first, Distance hole, Distance length, T value, Compare &comp) {
+            const Distance top = hole;
+            Distance child = hole;
+            while (child < (length - 1) / 2) {
+                child = 2 * (child + 1);
+                if (comp(*(first + child), *(first + (child - 1)))) {
+                    --child;
+                }
+                *(first + hole) = iter_move(first + child);
+                hole = child;
+            }
+            // 长度为偶数时，最后一个内部节点只有左孩子
+            if ((length & 1) == 0 && child == (length - 2) / 2) {
+                child = 2 * (child + 1);
+                *(first + hole) = iter_move(first + (child - 1));
+                hole = child - 1;
+            }
+            push_hole_up(first, hole, top, std::move(value), comp);
+        }
+    }
+
+    /**
+     * [first, last - 1)是堆，把*(last - 1)加入堆中
+     */
+    template<typename RandomIt, typename Compare>
+    void push_heap(RandomIt first, RandomIt last, Compare comp) {
+        typedef typename iterator_traits<RandomIt>::value_type value_type;
+        typedef typename iterator_traits<RandomIt>::difference_type difference_type;
+        difference_type length = last - first;
+        if (length < 2) {
+            return;
+        }
+        value_type value = iter_move(last - 1);
+        heap_detail::push_hole_up(first, length - 1, difference_type(0), std::move(value), comp);
+    }
+
+    template<typename RandomIt>
+    void push_heap(RandomIt first, RandomIt last) {
+        Readable::push_heap(first, last, Readable::less<typename iterator_traits<RandomIt>::value_type>());
+    }
+
+    /**
+     * 把堆顶（最大的元素）换到last - 1，[first, last - 1)仍是堆
+     */
+    template<typename RandomIt, typename Compare>
+    void pop_heap(RandomIt first, RandomIt last, Compare comp) {
+        typedef typename iterator_traits<RandomIt>::value_type value_type;
+        typedef typename iterator_traits<RandomIt>::difference_type difference_type;
+        if (last - first < 2) {
+            return;
+        }
+        --last;
+        value_type value = iter_move(last);
+        *last = iter_move(first);
+        heap_detail::adjust_heap(first, difference_type(0), last - first, std::move(value), comp);
+    }
+
+    template<typename RandomIt>
+    void pop_heap(RandomIt first, RandomIt last) {
+        Readable::pop_heap(first, last, Readable::less<typename iterator_traits<RandomIt>::value_type>());
+    }
+
+    /**
+     * 把[first, last)调整成堆，O(n)
+     */
+    template<typename RandomIt, typename Compare>
+    void make_heap(RandomIt first, RandomIt last, Compare comp) {
+        typedef typename iterator_traits<RandomIt>::value_type value_type;
+        typedef typename iterator_traits<RandomIt>::difference_type difference_type;
+        difference_type length = last - first;
+        if (length < 2) {
+            return;
+        }
+        // 从最后一个内部节点开始依次向前调整
+        for (difference_type parent = (length - 2) / 2;; --parent) {
+            value_type value = iter_move(first + parent);
+            heap_detail::adjust_heap(first, parent, length, std::move(value), comp);
+            if (parent == 0) {
+                return;
+            }
+        }
+    }
+
+    template<typename RandomIt>
+    void make_heap(RandomIt first, RandomIt last) {
+        Readable::make_heap(first, last, Readable::less<typename iterator_traits<RandomIt>::value_type>());
+    }
+
+    /**
+     * 把堆[first, last)排成升序，O(nlogn)
+     */
+    template<typename RandomIt, typename Compare>
+    void sort_heap(RandomIt first, RandomIt last, Compare comp) {
+        while (last - first > 1) {
+            Readable::pop_heap(first, last, comp);
+            --last;
+        }
+    }
+
+    template<typename RandomIt>
+    void sort_heap(RandomIt first, RandomIt last) {
+        Readable::sort_heap(first, last, Readable::less<typename iterator_traits<RandomIt>::value_type>());
+    }
+
+    /**
+     * @return [first, last)中从first开始最长的堆的末尾
+     */
+    template<typename RandomIt, typename Compare>
+    RandomIt is_heap_until(RandomIt first, RandomIt last, Compare comp) {
+        typedef typename iterator_traits<RandomIt>::difference_type difference_type;
+        difference_type length = last - first;
+        for (difference_type child = 1; child < length; ++child) {
+            if (comp(*(first + (child - 1) / 2), *(first + child))) {
+                return first + child;
+            }
+        }
+        return last;
+    }
+
+    template<typename RandomIt>
+    RandomIt is_heap_until(RandomIt first, RandomIt last) {
+        return Readable::is_heap_until(first, last, Readable::less<typename iterator_traits<RandomIt>::value_type>());
+    }
+
+    template<typename RandomIt, typename Compare>
+    bool is_heap(RandomIt first, RandomIt last, Compare comp) {
+        return Readable::is_heap_until(first, last, comp) == last;
+    }
+
+    template<typename RandomIt>
+    bool is_heap(RandomIt first, RandomIt last) {
+        return Readable::is_heap_until(first, last) == last;
+    }
+}
+
+#endif //STL_FROM_SCRATCH_HEAP_H
@@ -1,32 +1,117 @@
 #ifndef STL_FROM_SCRATCH_MODIFYING_SEQUENCE_H
 #define STL_FROM_SCRATCH_MODIFYING_SEQUENCE_H
 
+#include <utility>
+#include "../iterator/iterator.h"
+#include "../memory/bitwise_copy.h"
 
 namespace Readable {
+    namespace modifying_sequence_detail {
+        template<typename InputIt, typename OutputIt>
+        OutputIt copy(InputIt first, InputIt last, OutputIt d_first, Readable::true_type) {
+            return bitwise_copy_detail::copy_bytes(first, last, d_first);
+        }
+
+        template<typename InputIt, typename OutputIt>
+        OutputIt copy(InputIt first, InputIt last, OutputIt d_first, Readable::false_type) {
+            while (first != last) {
+                *d_first++ = *first++;
+            }
+            return d_first;
+        }
+
+        template<typename BidirIt1, typename BidirIt2>
+        BidirIt2 copy_backward(BidirIt1 first, BidirIt1 last, BidirIt2 d_last, Readable::true_type) {
+            return bitwise_copy_detail::copy_bytes_backward(first, last, d_last);
+        }
+
+        template<typename BidirIt1, typename BidirIt2>
+        BidirIt2 copy_backward(BidirIt1 first, BidirIt1 last, BidirIt2 d_last, Readable::false_type) {
+            while (first != last) {
+                *(--d_last) = *(--last);
+            }
+            return d_last;
+        }
+
+        template<typename InputIt, typename OutputIt>
+        OutputIt move(InputIt first, InputIt last, OutputIt d_first, Readable::true_type) {
+            return bitwise_copy_detail::copy_bytes(first, last, d_first);
+        }
+
+        template<typename InputIt, typename OutputIt>
+        OutputIt move(InputIt first, InputIt last, OutputIt d_first, Readable::false_type) {
+            while (first != last) {
+                *d_first = iter_move(first);
+                ++d_first;
+                ++first;
+            }
+            return d_first;
+        }
+
+        template<typename BidirIt1, typename BidirIt2>
+        BidirIt2 move_backward(BidirIt1 first, BidirIt1 last, BidirIt2 d_last, Readable::true_type) {
+            return bitwise_copy_detail::copy_bytes_backward(first, last, d_last);
+        }
+
+        template<typename BidirIt1, typename BidirIt2>
+        BidirIt2 move_backward(BidirIt1 first, BidirIt1 last, BidirIt2 d_last, Readable::false_type) {
+            while (first != last) {
+                *(--d_last) = iter_move(--last);
+            }
+            return d_last;
+        }
+
+        template<typename ForwardIt, typename T>
+        void fill(ForwardIt first, ForwardIt last, const T &value, Readable::true_type) {
+            bitwise_copy_detail::fill_bytes(first, last, value);
+        }
+
+        template<typename ForwardIt, typename T>
+        void fill(ForwardIt first, ForwardIt last, const T &value, Readable::false_type) {
+            for (; first != last; ++first) {
+                *first = value;
+            }
+        }
+    }
+
+    /**
+     * 把[first, last)复制到d_first开始的位置
+     * 连续迭代器之间复制可以平凡复制、可以复制赋值的元素时直接memmove
+     */
+    template<typename InputIt, typename OutputIt>
+    OutputIt copy(InputIt first, InputIt last, OutputIt d_first) {
+        return modifying_sequence_detail::copy(first, last, d_first, Readable::integral_constant<bool,
+                bitwise_copy_detail::is_bitwise_copy_assignable<InputIt, OutputIt>::value>());
+    }
+
     template<typename BidirIt1, typename BidirIt2>
     BidirIt2 copy_backward(BidirIt1 first, BidirIt1 last, BidirIt2 d_last) {
-        while (first != last) {
-            *(--d_last) = *(--last);
-        }
-        return d_last;
+        return modifying_sequence_detail::copy_backward(first, last, d_last, Readable::integral_constant<bool,
+                bitwise_copy_detail::is_bitwise_copy_assignable<BidirIt1, BidirIt2>::value>());
     }
 
     template<typename BidirIt1, typename BidirIt2>
     BidirIt2 move_backward(BidirIt1 first,
                            BidirIt1 last,
                            BidirIt2 d_last) {
-        while (first != last) {
-            *(--d_last) = std::move(*(--last));
-        }
-        return d_last;
+        return modifying_sequence_detail::move_backward(first, last, d_last, Readable::integral_constant<bool,
+                bitwise_copy_detail::is_bitwise_move_assignable<BidirIt1, BidirIt2>::value>());
     }
 
     template<typename InputIt, typename OutputIt>
     OutputIt move(InputIt first, InputIt last, OutputIt d_first) {
-        while (first != last) {
-            *d_first++ = std::move(*first++);
-        }
-        return d_first;
+        return modifying_sequence_detail::move(first, last, d_first, Readable::integral_constant<bool,
+                bitwise_copy_detail::is_bitwise_move_assignable<InputIt, OutputIt>::value>());
+    }
+
+    /**
+     * 把[first, last)中的元素都赋值为value
+     * 连续迭代器上的单字节整数直接memset
+     */
+    template<typename ForwardIt, typename T>
+    void fill(ForwardIt first, ForwardIt last, const T &value) {
+        modifying_sequence_detail::fill(first, last, value, Readable::integral_constant<bool,
+                bitwise_copy_detail::is_byte_fillable<ForwardIt>::value>());
     }
 
     template<typename ForwardIt1, typename ForwardIt2>
@@ -38,8 +123,42 @@ namespace Readable {
     template<typename BidirIt>
     void reverse(BidirIt first, BidirIt last) {
         while ((first != last) && (first != --last)) {
-            std::iter_swap(first++, last);
+            Readable::iter_swap(first++, last);
+        }
+    }
+
+    /**
+     * 循环左移[first, last)，使*middle成为第一个元素
+     * 从middle开始把后段的元素逐个和前面交换；后段先用完时，前段剩下的部分对新的middle继续左移
+     * 只用循环，不会因为两段长度悬殊而递归很深；共O(n)次交换
+     * @return 原来的*first现在的位置
+     */
+    template<typename ForwardIt>
+    ForwardIt rotate(ForwardIt first, ForwardIt middle, ForwardIt last) {
+        if (first == middle) {
+            return last;
+        }
+        if (middle == last) {
+            return first;
+        }
+        ForwardIt read = middle;
+        do {
+            Readable::iter_swap(first++, read++);
+            if (first == middle) {
+                middle = read;
+            }
+        } while (read != last);
+        ForwardIt result = first;
+        read = middle;
+        while (read != last) {
+            Readable::iter_swap(first++, read++);
+            if (first == middle) {
+                middle = read;
+            } else if (read == last) {
+                read = middle;
+            }
         }
+        return result;
     }
 }
 
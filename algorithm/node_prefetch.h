@@ -0,0 +1,171 @@
+#ifndef STL_FROM_SCRATCH_NODE_PREFETCH_H
+#define STL_FROM_SCRATCH_NODE_PREFETCH_H
+
+#include <cstddef>
+#include "../memory/memory.h"
+#include "../containers/list.h"
+#include "../containers/forward_list.h"
+
+namespace Readable {
+    /**
+     * 带软件预取的遍历算法，用于list、forward_list等基于节点的容器
+     *
+     * 沿链表遍历时，每一步都要等上一个节点的next读出来才知道下一个节点在哪，节点不在缓存里时每一步都是一次完整的内存延迟
+     * 这里在遍历的同时让一个"前哨"迭代器走在前面 @arg distance 个节点，轮到处理一个节点时它已经被前哨读过，多半还在缓存里
+     * 收益主要来自前哨追指针和对元素的处理重叠起来，而不是预取指令本身：前哨仍然要等每个节点的next读出来
+     * 预取指令只帮前哨提前一步：前哨每前进到一个节点就对它发出预取，到下一步才读它的next，
+     * 这个节点的内存访问就和一个元素的处理重叠了
+     * 因此只在每个元素上的计算和一次内存访问的延迟相当（几百个时钟周期）时才有收益：
+     * 800万个地址打乱的节点、每个元素64到256次互相依赖的乘加时遍历快约三分之一；只求和时前哨和遍历在等同一串指针，和普通遍历差不多
+     * 只做少量计算的遍历应当先defragment，让节点连续存放，硬件预取器就够了
+     *
+     * distance太大时预取的节点可能在用到之前就被挤出缓存；在上面的测试中2到32之间差别不大
+     */
+    const std::size_t default_prefetch_distance = 8;
+
+    /**
+     * 对 @arg address 所在的缓存行发出读预取，不支持的编译器上什么也不做
+     */
+    inline void prefetch_read(const void *address) {
+#if defined(__GNUC__) || defined(__clang__)
+        __builtin_prefetch(address, 0, 3);
+#else
+        (void) address;
+#endif
+    }
+
+    namespace node_prefetch_detail {
+        /**
+         * 走在遍历位置前面的前哨迭代器，到达last后停止
+         */
+        template<typename ForwardIt>
+        class prefetch_cursor {
+        private:
+            ForwardIt ahead;
+            ForwardIt last;
+
+        public:
+            prefetch_cursor(ForwardIt first, ForwardIt last_, std::size_t distance) : ahead(first), last(last_) {
+                for (std::size_t i = 0; i < distance && ahead != last; ++i) {
+                    step();
+                }
+            }
+
+            /**
+             * 遍历位置前进一步时调用：前哨前进一步，并预取它新到达的节点
+             * 这个节点的next要到下一次step才读，预取和这之间对一个元素的处理重叠
+             */
+            void step() {
+                if (ahead != last) {
+                    ++ahead;
+                    if (ahead != last) {
+                        prefetch_read(Readable::addressof(*ahead));
+                    }
+                }
+            }
+        };
+    }
+
+    /**
+     * 带预取的for_each
+     * @param distance 预取的距离（节点数）
+     */
+    template<typename ForwardIt, typename UnaryFunction>
+    UnaryFunction prefetch_for_each(ForwardIt first, ForwardIt last, UnaryFunction f,
+                                    std::size_t distance = default_prefetch_distance) {
+        node_prefetch_detail::prefetch_cursor<ForwardIt> cursor(first, last, distance);
+        for (; first != last; ++first) {
+            cursor.step();
+            f(*first);
+        }
+        return f;
+    }
+
+    /**
+     * 带预取的find_if
+     * @param distance 预取的距离（节点数）
+     */
+    template<typename ForwardIt, typename UnaryPredicate>
+    ForwardIt prefetch_find_if(ForwardIt first, ForwardIt last, UnaryPredicate p,
+                               std::size_t distance = default_prefetch_distance) {
+        node_prefetch_detail::prefetch_cursor<ForwardIt> cursor(first, last, distance);
+        for (; first != last; ++first) {
+            cursor.step();
+            if (p(*first)) {
+                return first;
+            }
+        }
+        return last;
+    }
+
+    /**
+     * 带预取的accumulate
+     * @param op 二元操作，init = op(init, *it)
+     * @param distance 预取的距离（节点数）
+     */
+    template<typename ForwardIt, typename T, typename BinaryOperation>
+    T prefetch_accumulate(ForwardIt first, ForwardIt last, T init, BinaryOperation op,
+                          std::size_t distance = default_prefetch_distance) {
+        node_prefetch_detail::prefetch_cursor<ForwardIt> cursor(first, last, distance);
+        for (; first != last; ++first) {
+            cursor.step();
+            init = op(std::move(init), *first);
+        }
+        return init;
+    }
+
+    template<typename ForwardIt, typename T>
+    T prefetch_accumulate(ForwardIt first, ForwardIt last, T init) {
+        return prefetch_accumulate(first, last, std::move(init), [](const T &a, const T &b) { return a + b; });
+    }
+
+    /**
+     * 带预取的list::remove_if，删除 @arg l 中所有满足 @arg p 的元素
+     * @param distance 预取的距离（节点数），至少为1，使前哨不会指向正在删除的节点
+     * @return 删除的元素个数
+     */
+    template<typename T, typename Allocator, typename UnaryPredicate>
+    std::size_t prefetch_remove_if(list<T, Allocator> &l, UnaryPredicate p,
+                                   std::size_t distance = default_prefetch_distance) {
+        typedef typename list<T, Allocator>::iterator iterator;
+        node_prefetch_detail::prefetch_cursor<iterator> cursor(l.begin(), l.end(), distance ? distance : 1);
+        std::size_t removed = 0;
+        for (auto it = l.begin(); it != l.end();) {
+            cursor.step();
+            if (p(*it)) {
+                it = l.erase(it);
+                ++removed;
+            } else {
+                ++it;
+            }
+        }
+        return removed;
+    }
+
+    /**
+     * 带预取的forward_list::remove_if，删除 @arg l 中所有满足 @arg p 的元素
+     * @param distance 预取的距离（节点数），至少为1，使前哨不会指向正在删除的节点
+     * @return 删除的元素个数
+     */
+    template<typename T, typename Allocator, typename UnaryPredicate>
+    std::size_t prefetch_remove_if(forward_list<T, Allocator> &l, UnaryPredicate p,
+                                   std::size_t distance = default_prefetch_distance) {
+        typedef typename forward_list<T, Allocator>::iterator iterator;
+        node_prefetch_detail::prefetch_cursor<iterator> cursor(l.begin(), l.end(), distance ? distance : 1);
+        std::size_t removed = 0;
+        auto before = l.before_begin();
+        for (auto it = l.begin(); it != l.end();) {
+            cursor.step();
+            if (p(*it)) {
+                it = l.erase_after(before);
+                ++removed;
+            } else {
+                before = it;
+                ++it;
+            }
+        }
+        return removed;
+    }
+}
+
+#endif //STL_FROM_SCRATCH_NODE_PREFETCH_H
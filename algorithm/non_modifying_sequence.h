@@ -0,0 +1,48 @@
+#ifndef STL_FROM_SCRATCH_NON_MODIFYING_SEQUENCE_H
+#define STL_FROM_SCRATCH_NON_MODIFYING_SEQUENCE_H
+
+#include "../memory/bitwise_copy.h"
+
+namespace Readable {
+    namespace non_modifying_sequence_detail {
+        template<typename InputIt1, typename InputIt2>
+        bool equal(InputIt1 first1, InputIt1 last1, InputIt2 first2, Readable::true_type) {
+            return bitwise_copy_detail::equal_bytes(first1, last1, first2);
+        }
+
+        template<typename InputIt1, typename InputIt2>
+        bool equal(InputIt1 first1, InputIt1 last1, InputIt2 first2, Readable::false_type) {
+            for (; first1 != last1; ++first1, ++first2) {
+                if (!(*first1 == *first2)) {
+                    return false;
+                }
+            }
+            return true;
+        }
+    }
+
+    /**
+     * [first1, last1)和first2开始的同样长的区间是否逐个元素相等
+     * 连续迭代器上的整数、指针直接memcmp
+     */
+    template<typename InputIt1, typename InputIt2>
+    bool equal(InputIt1 first1, InputIt1 last1, InputIt2 first2) {
+        return non_modifying_sequence_detail::equal(first1, last1, first2, Readable::integral_constant<bool,
+                bitwise_copy_detail::is_bitwise_comparable<InputIt1, InputIt2>::value>());
+    }
+
+    /**
+     * 用 @arg p 判断两个元素是否相等
+     */
+    template<typename InputIt1, typename InputIt2, typename BinaryPredicate>
+    bool equal(InputIt1 first1, InputIt1 last1, InputIt2 first2, BinaryPredicate p) {
+        for (; first1 != last1; ++first1, ++first2) {
+            if (!p(*first1, *first2)) {
+                return false;
+            }
+        }
+        return true;
+    }
+}
+
+#endif //STL_FROM_SCRATCH_NON_MODIFYING_SEQUENCE_H
@@ -0,0 +1,88 @@
+#ifndef STL_FROM_SCRATCH_PARALLEL_LIST_SORT_H
+#define STL_FROM_SCRATCH_PARALLEL_LIST_SORT_H
+
+#include <cstdint>
+#include <utility>
+#include "./parallel_sort.h"
+#include "../containers/list.h"
+#include "../containers/vector.h"
+#include "../functional/functional.h"
+
+namespace Readable {
+    namespace parallel_list_sort_detail {
+        /**
+         * @arg nodes 中是排好序的节点，把元素依次移动到按地址排序的节点中，并让 @arg nodes 按地址排序
+         */
+        template<typename T>
+        void relocate_in_address_order(const parallel_policy &policy, Readable::vector<list_node_base *> &nodes) {
+            typedef list_node<T> node_type;
+            Readable::vector<T> values;
+            values.reserve(nodes.size());
+            for (auto the_node: nodes) {
+                values.push_back(std::move(((node_type *) the_node)->data));
+            }
+            // 不相关的指针之间不能直接用<比较，转成整数
+            Readable::parallel_stable_sort(policy, nodes.begin(), nodes.end(),
+                                           [](list_node_base *a, list_node_base *b) {
+                                               return reinterpret_cast<std::uintptr_t>(a) <
+                                                      reinterpret_cast<std::uintptr_t>(b);
+                                           });
+            for (std::size_t i = 0; i < nodes.size(); ++i) {
+                ((node_type *) nodes[i])->data = std::move(values[i]);
+            }
+        }
+
+        /**
+         * 按 @arg nodes 中的顺序重建以 @arg sentinel 为哨兵的整个环形链表
+         */
+        inline void relink_all(list_node_base *sentinel, const Readable::vector<list_node_base *> &nodes) {
+            list_node_base *prev = sentinel;
+            for (auto the_node: nodes) {
+                prev->next = the_node;
+                the_node->prev = prev;
+                prev = the_node;
+            }
+            prev->next = sentinel;
+            sentinel->prev = prev;
+        }
+    }
+
+    /**
+     * list的并行稳定排序
+     * 把所有节点的指针收集到数组中，用并行归并排序按元素排好，再一遍重建prev/next
+     * 链表很长时，指针数组的访问是连续的，比在链表上归并时逐个追指针更容易被预取，也可以分给多个线程
+     * 需要额外的size()个指针的空间
+     * 单独放在这个头文件中，只用到list::sort的代码不需要依赖线程池和线程库
+     *
+     * policy.relocate_nodes为true时，排好序后再把元素按顺序移动到按地址递增的节点里，
+     * 之后的顺序遍历就是顺序访问内存；这需要T可以移动赋值，并且迭代器仍指向原来的节点、但节点中的元素已经变了
+     * 否则只修改指针，所有迭代器仍然有效
+     */
+    template<typename T, typename Allocator, typename Compare>
+    void parallel_stable_sort(const parallel_policy &policy, list<T, Allocator> &l, Compare comp) {
+        typedef list_node<T> node_type;
+        if (l.size() < 2) {
+            return;
+        }
+        Readable::vector<list_node_base *> nodes;
+        nodes.reserve(l.size());
+        for (auto it = l.begin(); it != l.end(); ++it) {
+            nodes.push_back(it.node);
+        }
+        Readable::parallel_stable_sort(policy, nodes.begin(), nodes.end(),
+                                       [&comp](list_node_base *a, list_node_base *b) {
+                                           return comp(((node_type *) a)->data, ((node_type *) b)->data);
+                                       });
+        if (policy.relocate_nodes) {
+            parallel_list_sort_detail::relocate_in_address_order<T>(policy, nodes);
+        }
+        parallel_list_sort_detail::relink_all(l.end().node, nodes);
+    }
+
+    template<typename T, typename Allocator>
+    void parallel_stable_sort(const parallel_policy &policy, list<T, Allocator> &l) {
+        Readable::parallel_stable_sort(policy, l, Readable::less<T>());
+    }
+}
+
+#endif //STL_FROM_SCRATCH_PARALLEL_LIST_SORT_H
@@ -0,0 +1,534 @@
+#ifndef STL_FROM_SCRATCH_PARALLEL_SORT_H
+#define STL_FROM_SCRATCH_PARALLEL_SORT_H
+
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <type_traits>
+#include "./binary_search.h"
+#include "./sort.h"
+#include "../iterator/iterator.h"
+#include "../memory/memory.h"
+#include "../containers/vector.h"
+#include "../concurrency/thread_pool.h"
+
+namespace Readable {
+    /**
+     * 并行算法的执行策略
+     */
+    struct parallel_policy {
+        // 使用的线程数，为0时使用硬件线程数；pool不为空时忽略
+        std::size_t thread_count;
+        // 已有的线程池，为空时算法内部临时创建一个
+        work_stealing_pool *pool;
+        // 仅对链表排序有效：排序后把元素搬到按地址递增的节点中，使遍历顺序和内存顺序一致
+        bool relocate_nodes;
+
+        explicit parallel_policy(std::size_t threads = 0, bool relocate = false) :
+                thread_count(threads), pool(nullptr), relocate_nodes(relocate) {}
+
+        explicit parallel_policy(work_stealing_pool &existing_pool, bool relocate = false) :
+                thread_count(existing_pool.thread_count()), pool(&existing_pool), relocate_nodes(relocate) {}
+    };
+
+    namespace parallel_sort_detail {
+        // 小于这个长度的区间用插入排序
+        const std::ptrdiff_t insertion_sort_threshold = 32;
+        // 小于这个长度的归并不再拆分成并行任务
+        const std::ptrdiff_t sequential_merge_threshold = 8192;
+
+        /**
+         * 当前线程的部分抛出异常时，已经spawn的任务还引用着栈上的数据，必须先等它们结束
+         */
+        inline void wait_quietly(work_stealing_pool &pool, task_group &group) {
+            try {
+                pool.sync(group);
+            } catch (...) {
+            }
+        }
+
+        template<typename RandomIt, typename Compare>
+        void insertion_sort(RandomIt first, RandomIt last, Compare &comp) {
+            if (first == last) {
+                return;
+            }
+            for (RandomIt i = first + 1; i != last; ++i) {
+                // 不能用auto：迭代器解引用得到代理对象时，auto保存的是引用而不是元素的值
+                typename Readable::iterator_traits<RandomIt>::value_type value = iter_move(i);
+                RandomIt j = i;
+                for (; j != first && comp(value, *(j - 1)); --j) {
+                    *j = iter_move(j - 1);
+                }
+                *j = std::move(value);
+            }
+        }
+
+        /**
+         * 顺序地把两段有序序列归并到 @arg out ，相等时先取第一段的元素
+         */
+        template<typename InputIt1, typename InputIt2, typename OutputIt, typename Compare>
+        OutputIt move_merge(InputIt1 first1, InputIt1 last1, InputIt2 first2, InputIt2 last2,
+                            OutputIt out, Compare &comp) {
+            while (first1 != last1 && first2 != last2) {
+                if (comp(*first2, *first1)) {
+                    *out = iter_move(first2);
+                    ++first2;
+                } else {
+                    *out = iter_move(first1);
+                    ++first1;
+                }
+                ++out;
+            }
+            for (; first1 != last1; ++first1, ++out) {
+                *out = iter_move(first1);
+            }
+            for (; first2 != last2; ++first2, ++out) {
+                *out = iter_move(first2);
+            }
+            return out;
+        }
+
+        /**
+         * 把移到缓冲区的前半段和仍在原位的后半段[middle, last)归并到 @arg out 开始的位置
+         * 缓冲区取完时，后半段剩下的元素已经在最终位置上，不能再移动：把元素移动给自己会清空std::string等类型
+         */
+        template<typename BufferIt, typename RandomIt, typename Compare>
+        void merge_from_buffer(BufferIt buffer, BufferIt buffer_end, RandomIt middle, RandomIt last,
+                               RandomIt out, Compare &comp) {
+            while (buffer != buffer_end && middle != last) {
+                if (comp(*middle, *buffer)) {
+                    *out = iter_move(middle);
+                    ++middle;
+                } else {
+                    *out = iter_move(buffer);
+                    ++buffer;
+                }
+                ++out;
+            }
+            for (; buffer != buffer_end; ++buffer, ++out) {
+                *out = iter_move(buffer);
+            }
+        }
+
+        /**
+         * 并行地把两段有序序列归并到 @arg out
+         * 在较长的一段取中点，用二分查找在另一段中找到对应的切分点，两边的归并互不相干，可以并行
+         */
+        template<typename RandomIt1, typename RandomIt2, typename OutputIt, typename Compare>
+        void parallel_move_merge(work_stealing_pool &pool,
+                                 RandomIt1 first1, RandomIt1 last1, RandomIt2 first2, RandomIt2 last2,
+                                 OutputIt out, Compare &comp) {
+            auto length1 = last1 - first1;
+            auto length2 = last2 - first2;
+            if (length1 + length2 <= sequential_merge_threshold) {
+                move_merge(first1, last1, first2, last2, out, comp);
+                return;
+            }
+            RandomIt1 cut1;
+            RandomIt2 cut2;
+            if (length1 >= length2) {
+                cut1 = first1 + length1 / 2;
+                // 第二段中严格小于*cut1的元素排在*cut1之前
+                cut2 = Readable::lower_bound(first2, last2, *cut1, comp);
+            } else {
+                cut2 = first2 + length2 / 2;
+                // 第一段中不大于*cut2的元素排在*cut2之前（保持稳定）
+                cut1 = Readable::upper_bound(first1, last1, *cut2, comp);
+            }
+            OutputIt out_middle = out + ((cut1 - first1) + (cut2 - first2));
+            task_group group;
+            pool.spawn(group, [&pool, first1, cut1, first2, cut2, out, &comp]() {
+                parallel_move_merge(pool, first1, cut1, first2, cut2, out, comp);
+            });
+            try {
+                parallel_move_merge(pool, cut1, last1, cut2, last2, out_middle, comp);
+            } catch (...) {
+                wait_quietly(pool, group);
+                throw;
+            }
+            pool.sync(group);
+        }
+
+        /**
+         * 用 @arg buffer 作为辅助空间顺序地稳定排序[first, last)
+         * buffer中至少要有(last - first) / 2个已构造的元素
+         */
+        template<typename RandomIt, typename BufferIt, typename Compare>
+        void sequential_merge_sort(RandomIt first, RandomIt last, BufferIt buffer, Compare &comp) {
+            auto length = last - first;
+            if (length <= insertion_sort_threshold) {
+                insertion_sort(first, last, comp);
+                return;
+            }
+            RandomIt middle = first + length / 2;
+            sequential_merge_sort(first, middle, buffer, comp);
+            sequential_merge_sort(middle, last, buffer, comp);
+            if (!comp(*middle, *(middle - 1))) {
+                // 两半已经首尾有序
+                return;
+            }
+            BufferIt buffer_end = buffer;
+            for (RandomIt it = first; it != middle; ++it, ++buffer_end) {
+                *buffer_end = iter_move(it);
+            }
+            merge_from_buffer(buffer, buffer_end, middle, last, first, comp);
+        }
+
+        /**
+         * 并行归并排序的递归部分
+         * [first, last)和[buffer, buffer + (last - first))是两块同样大小的空间，
+         * 排序结果放在哪一块由 @arg result_in_buffer 决定，这样每一层的归并都可以从一块直接写到另一块
+         */
+        template<typename RandomIt, typename BufferIt, typename Compare>
+        void parallel_merge_sort(work_stealing_pool &pool, RandomIt first, RandomIt last, BufferIt buffer,
+                                 bool result_in_buffer, std::ptrdiff_t leaf_size, Compare &comp) {
+            auto length = last - first;
+            if (length <= leaf_size) {
+                sequential_merge_sort(first, last, buffer, comp);
+                if (result_in_buffer) {
+                    for (RandomIt it = first; it != last; ++it, ++buffer) {
+                        *buffer = iter_move(it);
+                    }
+                }
+                return;
+            }
+            auto half = length / 2;
+            RandomIt middle = first + half;
+            BufferIt buffer_middle = buffer + half;
+            // 两半的结果放在另一块空间里，再归并回目标空间
+            task_group group;
+            pool.spawn(group, [&pool, first, middle, buffer, result_in_buffer, leaf_size, &comp]() {
+                parallel_merge_sort(pool, first, middle, buffer, !result_in_buffer, leaf_size, comp);
+            });
+            try {
+                parallel_merge_sort(pool, middle, last, buffer_middle, !result_in_buffer, leaf_size, comp);
+            } catch (...) {
+                wait_quietly(pool, group);
+                throw;
+            }
+            pool.sync(group);
+            if (result_in_buffer) {
+                parallel_move_merge(pool, first, middle, middle, last, buffer, comp);
+            } else {
+                parallel_move_merge(pool, buffer, buffer_middle, buffer_middle, buffer + length, first, comp);
+            }
+        }
+
+        template<typename RandomIt, typename Compare>
+        void parallel_stable_sort(work_stealing_pool &pool, RandomIt first, RandomIt last, Compare &comp) {
+            typedef typename Readable::iterator_traits<RandomIt>::value_type value_type;
+            typedef Readable::allocator<value_type> buffer_allocator;
+            auto length = last - first;
+            if (length < 2) {
+                return;
+            }
+            // 输入先整体移动构造到辅助空间中，再以辅助空间为源排序，结果写回[first, last)
+            // 两块空间中都是已构造的对象，之后只用移动赋值；不复制元素，只能移动的类型也可以排序
+            // 移动构造抛出异常时已经移走的元素留在被移走后的状态
+            value_type *buffer = buffer_allocator::allocate(static_cast<std::size_t>(length));
+            std::ptrdiff_t built = 0;
+            try {
+                for (; built < length; ++built) {
+                    ::new(static_cast<void *>(buffer + built)) value_type(iter_move(first + built));
+                }
+            } catch (...) {
+                Readable::destroy(buffer, buffer + built);
+                buffer_allocator::deallocate(buffer, static_cast<std::size_t>(length));
+                throw;
+            }
+            // 每个线程分到若干块，块太小时调度开销会超过收益
+            std::ptrdiff_t leaf_size = length / static_cast<std::ptrdiff_t>(pool.thread_count() * 4);
+            if (leaf_size < sequential_merge_threshold) {
+                leaf_size = sequential_merge_threshold;
+            }
+            try {
+                parallel_merge_sort(pool, buffer, buffer + length, first, true, leaf_size, comp);
+            } catch (...) {
+                Readable::destroy(buffer, buffer + length);
+                buffer_allocator::deallocate(buffer, static_cast<std::size_t>(length));
+                throw;
+            }
+            Readable::destroy(buffer, buffer + length);
+            buffer_allocator::deallocate(buffer, static_cast<std::size_t>(length));
+        }
+
+        // 小于这个长度的区间直接顺序排序
+        const std::ptrdiff_t sequential_sort_threshold = 1 << 16;
+        // 每个线程分到的桶数，桶多一些，大小不均时工作窃取更容易平衡负载
+        const std::size_t buckets_per_thread = 8;
+        // 桶的数量上限，桶号要放得进std::uint16_t（加上等值桶是2 * max_bucket_count - 1个）
+        const std::size_t max_bucket_count = 1024;
+        // 每个桶抽取的样本数，越多分隔元素越均匀
+        const std::size_t oversampling = 16;
+
+        /**
+         * 只负责释放的未初始化空间，其中对象的构造和析构由使用者负责
+         */
+        template<typename T>
+        class raw_buffer {
+        private:
+            T *data_;
+            std::size_t size_;
+
+        public:
+            explicit raw_buffer(std::size_t size) : data_(Readable::allocator<T>::allocate(size)), size_(size) {}
+
+            raw_buffer(const raw_buffer &) = delete;
+
+            raw_buffer &operator=(const raw_buffer &) = delete;
+
+            ~raw_buffer() {
+                Readable::allocator<T>::deallocate(data_, size_);
+            }
+
+            T *data() const {
+                return data_;
+            }
+        };
+
+        /**
+         * 在当前线程和线程池中并行执行f(0), f(1), ..., f(task_count - 1)，全部完成后返回
+         */
+        template<typename Function>
+        void run_tasks(work_stealing_pool &pool, std::size_t task_count, Function &f) {
+            task_group group;
+            for (std::size_t i = 1; i < task_count; ++i) {
+                pool.spawn(group, [&f, i]() {
+                    f(i);
+                });
+            }
+            try {
+                f(0);
+            } catch (...) {
+                wait_quietly(pool, group);
+                throw;
+            }
+            pool.sync(group);
+        }
+
+        /**
+         * 样本排序中把元素分到桶里的分类器
+         * 有序且互不相等的m个分隔元素s[0] < s[1] < ... < s[m - 1]把元素分成2m + 1个桶：
+         * 桶2j是严格位于s[j - 1]和s[j]之间的元素，桶2j - 1是等于s[j - 1]的元素
+         * 等值桶中的元素互相等价，不需要再排序，大量重复的键也就不会集中到同一个桶里
+         */
+        template<typename T, typename Compare>
+        class sample_sort_classifier {
+        private:
+            const T *splitters;
+            std::size_t splitter_count;
+            Compare &comp;
+
+        public:
+            sample_sort_classifier(const T *splitters_, std::size_t splitter_count_, Compare &comp_) :
+                    splitters(splitters_), splitter_count(splitter_count_), comp(comp_) {}
+
+            std::size_t bucket_count() const {
+                return 2 * splitter_count + 1;
+            }
+
+            static bool is_equal_bucket(std::size_t bucket) {
+                return (bucket & 1) != 0;
+            }
+
+            template<typename U>
+            std::size_t operator()(const U &value) const {
+                // 不大于value的分隔元素的个数
+                std::size_t j = static_cast<std::size_t>(
+                        Readable::upper_bound(splitters, splitters + splitter_count, value, comp) - splitters);
+                if (j > 0 && !comp(splitters[j - 1], value)) {
+                    return 2 * j - 1;
+                }
+                return 2 * j;
+            }
+        };
+
+        /**
+         * 从[first, first + length)中等距离地抽样、排序，选出互不相等的分隔元素
+         */
+        template<typename RandomIt, typename Compare>
+        void choose_splitters(RandomIt first, std::ptrdiff_t length, std::size_t bucket_count, Compare &comp,
+                              Readable::vector<typename Readable::iterator_traits<RandomIt>::value_type> &splitters) {
+            typedef typename Readable::iterator_traits<RandomIt>::value_type value_type;
+            std::size_t sample_count = bucket_count * oversampling;
+            Readable::vector<value_type> samples;
+            samples.reserve(sample_count);
+            // 用简单的线性同余生成器取随机位置，有规律的输入（比如周期性的）不会让样本都落在同一类值上
+            std::uint64_t state = static_cast<std::uint64_t>(length);
+            for (std::size_t i = 0; i < sample_count; ++i) {
+                state = state * 6364136223846793005ULL + 1442695040888963407ULL;
+                samples.push_back(*(first + static_cast<std::ptrdiff_t>((state >> 33) % length)));
+            }
+            Readable::sort(samples.begin(), samples.end(), comp);
+            splitters.reserve(bucket_count - 1);
+            for (std::size_t i = 1; i < bucket_count; ++i) {
+                const value_type &candidate = samples[i * oversampling - 1];
+                if (splitters.empty() || comp(splitters.back(), candidate)) {
+                    splitters.push_back(candidate);
+                }
+            }
+        }
+
+        /**
+         * 并行样本排序
+         * 1. 抽样选出分隔元素，把值域分成若干个桶，桶的数量是线程数的若干倍
+         * 2. 输入分成和线程数相同的块，并行地给每个元素分类并统计每块中每个桶的元素数
+         * 3. 由统计结果算出每块的每个桶在辅助空间中的位置，并行地把元素移动过去，同一个桶的元素连续存放
+         * 4. 每个桶是一个独立的任务，用顺序的sort排序后移回原位；等值桶不需要排序
+         * 每个元素只被移动两次，桶之间没有依赖，不像归并排序那样每一层都要同步
+         * 需要和输入同样大小的辅助空间和每个元素2字节的桶号
+         */
+        template<typename RandomIt, typename Compare>
+        void parallel_sample_sort(work_stealing_pool &pool, RandomIt first, RandomIt last, Compare &comp) {
+            typedef typename Readable::iterator_traits<RandomIt>::value_type value_type;
+            std::ptrdiff_t length = last - first;
+            std::size_t thread_count = pool.thread_count();
+            if (length < sequential_sort_threshold || thread_count < 2) {
+                Readable::sort(first, last, comp);
+                return;
+            }
+            std::size_t target_buckets = thread_count * buckets_per_thread;
+            if (target_buckets > max_bucket_count) {
+                target_buckets = max_bucket_count;
+            }
+            Readable::vector<value_type> splitters;
+            choose_splitters(first, length, target_buckets, comp, splitters);
+            sample_sort_classifier<value_type, Compare> classify(splitters.begin(), splitters.size(), comp);
+            const std::size_t bucket_count = classify.bucket_count();
+
+            // 分类：每块统计各个桶的元素数，桶号记下来，移动时不必再比较一遍
+            const std::size_t block_count = thread_count;
+            const std::ptrdiff_t block_size = (length + static_cast<std::ptrdiff_t>(block_count) - 1) /
+                                              static_cast<std::ptrdiff_t>(block_count);
+            raw_buffer<std::uint16_t> oracle(static_cast<std::size_t>(length));
+            Readable::vector<std::size_t> positions(block_count * bucket_count);
+            auto classify_block = [&](std::size_t block) {
+                std::ptrdiff_t begin = static_cast<std::ptrdiff_t>(block) * block_size;
+                std::ptrdiff_t end = begin + block_size < length ? begin + block_size : length;
+                std::size_t *counts = positions.begin() + block * bucket_count;
+                for (std::ptrdiff_t i = begin; i < end; ++i) {
+                    std::size_t bucket = classify(*(first + i));
+                    oracle.data()[i] = static_cast<std::uint16_t>(bucket);
+                    ++counts[bucket];
+                }
+            };
+            run_tasks(pool, block_count, classify_block);
+
+            // 按桶优先、块其次的顺序求前缀和，得到每块的每个桶的起始位置
+            Readable::vector<std::size_t> bucket_begin(bucket_count + 1);
+            std::size_t sum = 0;
+            for (std::size_t bucket = 0; bucket < bucket_count; ++bucket) {
+                bucket_begin[bucket] = sum;
+                for (std::size_t block = 0; block < block_count; ++block) {
+                    std::size_t count = positions[block * bucket_count + bucket];
+                    positions[block * bucket_count + bucket] = sum;
+                    sum += count;
+                }
+            }
+            bucket_begin[bucket_count] = sum;
+
+            // 移动到辅助空间：移动构造不会抛出异常（见parallel_sort的分派），之后辅助空间中的元素都已构造
+            raw_buffer<value_type> buffer(static_cast<std::size_t>(length));
+            auto distribute_block = [&](std::size_t block) {
+                std::ptrdiff_t begin = static_cast<std::ptrdiff_t>(block) * block_size;
+                std::ptrdiff_t end = begin + block_size < length ? begin + block_size : length;
+                std::size_t *next = positions.begin() + block * bucket_count;
+                for (std::ptrdiff_t i = begin; i < end; ++i) {
+                    ::new(static_cast<void *>(buffer.data() + next[oracle.data()[i]]++)) value_type(
+                            iter_move(first + i));
+                }
+            };
+            run_tasks(pool, block_count, distribute_block);
+
+            // 各个桶独立排序，排好后移回原位
+            Readable::vector<char> moved_back(bucket_count, 0);
+            auto sort_bucket = [&](std::size_t bucket) {
+                value_type *bucket_first = buffer.data() + bucket_begin[bucket];
+                value_type *bucket_last = buffer.data() + bucket_begin[bucket + 1];
+                if (!sample_sort_classifier<value_type, Compare>::is_equal_bucket(bucket)) {
+                    Readable::sort(bucket_first, bucket_last, comp);
+                }
+                RandomIt out = first + static_cast<std::ptrdiff_t>(bucket_begin[bucket]);
+                for (value_type *it = bucket_first; it != bucket_last; ++it, ++out) {
+                    *out = std::move(*it);
+                }
+                moved_back[bucket] = 1;
+            };
+            try {
+                run_tasks(pool, bucket_count, sort_bucket);
+            } catch (...) {
+                // 比较函数抛出了异常：还没有移回的桶原样移回，输入中的元素都是有效的，但顺序不确定
+                for (std::size_t bucket = 0; bucket < bucket_count; ++bucket) {
+                    if (!moved_back[bucket]) {
+                        for (std::size_t i = bucket_begin[bucket]; i < bucket_begin[bucket + 1]; ++i) {
+                            *(first + static_cast<std::ptrdiff_t>(i)) = std::move(buffer.data()[i]);
+                        }
+                    }
+                }
+                Readable::destroy(buffer.data(), buffer.data() + length);
+                throw;
+            }
+            Readable::destroy(buffer.data(), buffer.data() + length);
+        }
+
+        template<typename RandomIt, typename Compare>
+        void parallel_sort(work_stealing_pool &pool, RandomIt first, RandomIt last, Compare &comp, std::true_type) {
+            parallel_sample_sort(pool, first, last, comp);
+        }
+
+        template<typename RandomIt, typename Compare>
+        void parallel_sort(work_stealing_pool &pool, RandomIt first, RandomIt last, Compare &comp, std::false_type) {
+            parallel_stable_sort(pool, first, last, comp);
+        }
+    }
+
+    /**
+     * 并行稳定排序
+     * 并行归并排序：递归地把区间一分为二并行排序，再用并行归并合并，需要和输入同样大小的辅助空间
+     * @param policy 执行策略
+     * @param comp 比较函数
+     */
+    template<typename RandomIt, typename Compare>
+    void parallel_stable_sort(const parallel_policy &policy, RandomIt first, RandomIt last, Compare comp) {
+        if (policy.pool) {
+            parallel_sort_detail::parallel_stable_sort(*policy.pool, first, last, comp);
+        } else {
+            work_stealing_pool pool(policy.thread_count);
+            parallel_sort_detail::parallel_stable_sort(pool, first, last, comp);
+        }
+    }
+
+    template<typename RandomIt>
+    void parallel_stable_sort(const parallel_policy &policy, RandomIt first, RandomIt last) {
+        Readable::parallel_stable_sort(policy, first, last,
+                                       Readable::less<typename Readable::iterator_traits<RandomIt>::value_type>());
+    }
+
+    /**
+     * 并行排序，不稳定
+     * 并行样本排序：抽样把值域分成比线程数多的若干个桶，并行地把元素分到桶中，再并行地排序每个桶
+     * 需要和输入同样大小的辅助空间；元素的移动操作可能抛出异常时退回到parallel_stable_sort
+     * @param policy 执行策略
+     * @param comp 比较函数
+     */
+    template<typename RandomIt, typename Compare>
+    void parallel_sort(const parallel_policy &policy, RandomIt first, RandomIt last, Compare comp) {
+        typedef typename Readable::iterator_traits<RandomIt>::value_type value_type;
+        typedef std::integral_constant<bool, std::is_nothrow_move_constructible<value_type>::value &&
+                                             std::is_nothrow_move_assignable<value_type>::value> nothrow_move;
+        if (policy.pool) {
+            parallel_sort_detail::parallel_sort(*policy.pool, first, last, comp, nothrow_move());
+        } else {
+            work_stealing_pool pool(policy.thread_count);
+            parallel_sort_detail::parallel_sort(pool, first, last, comp, nothrow_move());
+        }
+    }
+
+    template<typename RandomIt>
+    void parallel_sort(const parallel_policy &policy, RandomIt first, RandomIt last) {
+        Readable::parallel_sort(policy, first, last,
+                                Readable::less<typename Readable::iterator_traits<RandomIt>::value_type>());
+    }
+}
+
+#endif //STL_FROM_SCRATCH_PARALLEL_SORT_H
@@ -12,25 +12,24 @@ namespace Readable {
         --cursor;
         if (first == cursor) return false;
 
-        BidirectionIterator before_cursor = next(cursor, -1);
+        BidirectionIterator before_cursor = Readable::next(cursor, -1);
         // find last pair which (*before_cursor < *cursor)
-        while (*before_cursor >= *cursor && before_cursor != first) {
+        while (!(*before_cursor < *cursor) && before_cursor != first) {
             --cursor;
             --before_cursor;
         }
         if (*before_cursor < *cursor) {
-            BidirectionIterator last_larger_than_before_cursor = next(last, -1);
-            // find last element > *before_cursor
-            while (*last_larger_than_before_cursor < *before_cursor)
+            BidirectionIterator last_larger_than_before_cursor = Readable::next(last, -1);
+            // find last element > *before_cursor, equal elements must be skipped
+            while (!(*before_cursor < *last_larger_than_before_cursor))
                 --last_larger_than_before_cursor;
-            iter_swap(before_cursor, last_larger_than_before_cursor);
-            reverse(cursor, last);
+            Readable::iter_swap(before_cursor, last_larger_than_before_cursor);
+            Readable::reverse(cursor, last);
             return true;
         }
-        if (before_cursor == first) {
-            Readable::reverse(first, last);
-            return false;
-        }
+        // already the last permutation
+        Readable::reverse(first, last);
+        return false;
     }
 
     template<typename BidirectionIterator>
@@ -41,25 +40,24 @@ namespace Readable {
         --cursor;
         if (first == cursor) return false;
 
-        BidirectionIterator before_cursor = next(cursor, -1);
-        // find last pair which (*before_cursor < *cursor)
-        while (*before_cursor < *cursor && before_cursor != first) {
+        BidirectionIterator before_cursor = Readable::next(cursor, -1);
+        // find last pair which (*cursor < *before_cursor)
+        while (!(*cursor < *before_cursor) && before_cursor != first) {
             --cursor;
             --before_cursor;
         }
-        if (*before_cursor >= *cursor) {
-            BidirectionIterator last_larger_than_before_cursor = next(last, -1);
-            // find last element > *before_cursor
-            while (*last_larger_than_before_cursor > *before_cursor)
-                --last_larger_than_before_cursor;
-            iter_swap(before_cursor, last_larger_than_before_cursor);
-            reverse(cursor, last);
+        if (*cursor < *before_cursor) {
+            BidirectionIterator last_smaller_than_before_cursor = Readable::next(last, -1);
+            // find last element < *before_cursor, equal elements must be skipped
+            while (!(*last_smaller_than_before_cursor < *before_cursor))
+                --last_smaller_than_before_cursor;
+            Readable::iter_swap(before_cursor, last_smaller_than_before_cursor);
+            Readable::reverse(cursor, last);
             return true;
         }
-        if (before_cursor == first) {
-            Readable::reverse(first, last);
-            return false;
-        }
+        // already the first permutation
+        Readable::reverse(first, last);
+        return false;
     }
 }
 #endif //STL_FROM_SCRATCH_PERMUTATION_H
@@ -0,0 +1,428 @@
+#ifndef STL_FROM_SCRATCH_RADIX_SORT_H
+#define STL_FROM_SCRATCH_RADIX_SORT_H
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include "./modifying_sequence.h"
+#include "../iterator/iterator.h"
+#include "../memory/allocator.h"
+#include "../memory/bitwise_copy.h"
+#include "../type_traits/type_traits.h"
+
+namespace Readable {
+    namespace radix_detail {
+        template<std::size_t Size>
+        struct unsigned_of;
+
+        template<>
+        struct unsigned_of<1> {
+            typedef std::uint8_t type;
+        };
+
+        template<>
+        struct unsigned_of<2> {
+            typedef std::uint16_t type;
+        };
+
+        template<>
+        struct unsigned_of<4> {
+            typedef std::uint32_t type;
+        };
+
+        template<>
+        struct unsigned_of<8> {
+            typedef std::uint64_t type;
+        };
+
+        /**
+         * 把键转换成无符号整数，使无符号整数的大小顺序和键的 < 顺序一致，之后按字节分配即可
+         */
+        template<typename T,
+                bool Integral = Readable::is_integral<T>::value,
+                bool Floating = std::is_floating_point<T>::value>
+        struct key_traits {
+            static const bool sortable = false;
+        };
+
+        /**
+         * 整数：有符号数把符号位取反，负数就排在非负数之前
+         */
+        template<typename T>
+        struct key_traits<T, true, false> {
+            static const bool sortable = true;
+            typedef typename unsigned_of<sizeof(T)>::type key_type;
+
+            static key_type to_key(T value) {
+                const key_type sign_bit = std::is_signed<T>::value ?
+                                          key_type(key_type(1) << (sizeof(T) * 8 - 1)) : key_type(0);
+                return key_type(static_cast<key_type>(value) ^ sign_bit);
+            }
+        };
+
+        /**
+         * IEEE 754浮点数：非负数把符号位置1，负数所有位取反（绝对值越大越靠前）
+         * -0.0排在+0.0之前，NaN按符号分别排在两端；这和 < 只在互相等价或者本来就无法比较的元素上不同
+         */
+        template<typename T>
+        struct key_traits<T, false, true> {
+            static const bool sortable = std::numeric_limits<T>::is_iec559 && (sizeof(T) == 4 || sizeof(T) == 8);
+            typedef typename unsigned_of<sizeof(T) == 4 ? 4 : 8>::type key_type;
+
+            static key_type to_key(T value) {
+                key_type bits;
+                std::memcpy(&bits, &value, sizeof(bits));
+                const key_type sign_bit = key_type(1) << (sizeof(key_type) * 8 - 1);
+                return (bits & sign_bit) ? key_type(~bits) : key_type(bits | sign_bit);
+            }
+        };
+
+        /**
+         * 元素本身就是键
+         */
+        template<typename T>
+        struct identity_key {
+            typedef typename key_traits<T>::key_type key_type;
+
+            key_type operator()(const T &value) const {
+                return key_traits<T>::to_key(value);
+            }
+        };
+
+        /**
+         * 用 @arg extract 从元素中取出键（整数或浮点数）
+         */
+        template<typename Extractor, typename T>
+        struct extracted_key {
+            typedef typename std::decay<decltype(std::declval<const Extractor &>()(std::declval<const T &>()))>::type
+                    extracted_type;
+            typedef typename key_traits<extracted_type>::key_type key_type;
+
+            Extractor extract;
+
+            explicit extracted_key(Extractor extract_) : extract(std::move(extract_)) {}
+
+            key_type operator()(const T &value) const {
+                return key_traits<extracted_type>::to_key(extract(value));
+            }
+        };
+
+        /**
+         * 降序：键的所有位取反
+         */
+        template<typename KeyFunction>
+        struct inverted_key {
+            typedef typename KeyFunction::key_type key_type;
+
+            KeyFunction key;
+
+            explicit inverted_key(KeyFunction key_) : key(std::move(key_)) {}
+
+            template<typename T>
+            key_type operator()(const T &value) const {
+                return key_type(~key(value));
+            }
+        };
+
+        // 按字节分配，每一趟256个桶
+        const int radix_bits = 8;
+        const std::size_t radix = std::size_t(1) << radix_bits;
+        // MSD中小于这个长度的桶用插入排序
+        const std::ptrdiff_t msd_insertion_sort_threshold = 32;
+
+        template<typename Key>
+        std::size_t digit(Key key, int shift) {
+            return static_cast<std::size_t>((key >> shift) & (radix - 1));
+        }
+
+        template<typename RandomIt, typename KeyFunction>
+        void insertion_sort_by_key(RandomIt first, RandomIt last, const KeyFunction &key) {
+            typedef typename iterator_traits<RandomIt>::value_type value_type;
+            if (first == last) {
+                return;
+            }
+            for (RandomIt current = first + 1; current != last; ++current) {
+                auto current_key = key(*current);
+                RandomIt hole = current;
+                if (current_key < key(*(hole - 1))) {
+                    value_type value = iter_move(current);
+                    do {
+                        *hole = iter_move(hole - 1);
+                        --hole;
+                    } while (hole != first && current_key < key(*(hole - 1)));
+                    *hole = std::move(value);
+                }
+            }
+        }
+
+        /**
+         * 统计 @arg length 个元素每个字节的直方图，只遍历一次
+         */
+        template<typename T, typename KeyFunction>
+        void count_digits(const T *data, std::size_t length, const KeyFunction &key,
+                          std::size_t (*counts)[radix]) {
+            typedef typename KeyFunction::key_type key_type;
+            std::memset(counts, 0, sizeof(key_type) * sizeof(*counts));
+            for (std::size_t i = 0; i < length; ++i) {
+                key_type k = key(data[i]);
+                for (int d = 0; d < static_cast<int>(sizeof(key_type)); ++d) {
+                    ++counts[d][digit(k, d * radix_bits)];
+                }
+            }
+        }
+
+        /**
+         * 把直方图变成每个桶的起始位置
+         */
+        inline void exclusive_prefix_sum(std::size_t *offsets) {
+            std::size_t sum = 0;
+            for (std::size_t bucket = 0; bucket < radix; ++bucket) {
+                std::size_t count = offsets[bucket];
+                offsets[bucket] = sum;
+                sum += count;
+            }
+        }
+
+        /**
+         * 按第 @arg shift 位开始的字节把 @arg from 中的元素稳定地分配到 @arg to，offsets是各桶的起始位置
+         * 元素逐个复制到未初始化的空间，要求可以平凡复制
+         */
+        template<typename T, typename KeyFunction>
+        void scatter(const T *from, T *to, std::size_t length, const KeyFunction &key, int shift, std::size_t *offsets) {
+            for (std::size_t i = 0; i < length; ++i) {
+                ::new(static_cast<void *>(to + offsets[digit(key(from[i]), shift)]++)) T(from[i]);
+            }
+        }
+
+        /**
+         * LSD基数排序：从最低字节到最高字节，每一趟按当前字节稳定地分配到另一块空间，再交换两块空间的角色
+         * 所有字节的直方图在第一遍扫描时一起统计；某一字节上所有元素都相同时这一趟不改变顺序，直接跳过
+         * （比如只用到低几个字节的大整数、正数的符号字节）
+         * 结果是稳定的，最后在 @arg data 中
+         * @param scratch 和data一样大的未初始化空间
+         */
+        template<typename T, typename KeyFunction>
+        void lsd_radix_sort(T *data, T *scratch, std::size_t length, const KeyFunction &key) {
+            typedef typename KeyFunction::key_type key_type;
+            std::size_t counts[sizeof(key_type)][radix];
+            count_digits(data, length, key, counts);
+            T *from = data;
+            T *to = scratch;
+            for (int d = 0; d < static_cast<int>(sizeof(key_type)); ++d) {
+                const int shift = d * radix_bits;
+                if (counts[d][digit(key(from[0]), shift)] == length) {
+                    continue;
+                }
+                exclusive_prefix_sum(counts[d]);
+                scatter(from, to, length, key, shift, counts[d]);
+                std::swap(from, to);
+            }
+            if (from != data) {
+                std::memcpy(static_cast<void *>(data), static_cast<const void *>(from), length * sizeof(T));
+            }
+        }
+
+        // 不超过这么多字节的区间直接用LSD：数据和另一块空间都能留在缓存中，每一趟分配都很快
+        const std::size_t lsd_max_bytes = std::size_t(1) << 20;
+
+        /**
+         * 超出缓存的数据上，LSD的每一趟都要完整地读写一遍内存，64位的键要八趟
+         * 所以先按最高的、不是所有元素都相同的字节分配到 @arg scratch（一趟顺序读、256路顺序写），
+         * 每个桶通常就能放进缓存，再用LSD排序桶内更低的字节，桶在data中对应的位置正好空出来当作另一块空间
+         * 结果是稳定的，最后在 @arg data 中
+         */
+        template<typename T, typename KeyFunction>
+        void msd_radix_sort(T *data, T *scratch, std::size_t length, const KeyFunction &key) {
+            typedef typename KeyFunction::key_type key_type;
+            if (length * sizeof(T) <= lsd_max_bytes) {
+                lsd_radix_sort(data, scratch, length, key);
+                return;
+            }
+            std::size_t counts[sizeof(key_type)][radix];
+            count_digits(data, length, key, counts);
+            int d = static_cast<int>(sizeof(key_type)) - 1;
+            for (; d >= 0 && counts[d][digit(key(data[0]), d * radix_bits)] == length; --d) {
+            }
+            if (d < 0) {
+                return;
+            }
+            std::size_t *offsets = counts[d];
+            exclusive_prefix_sum(offsets);
+            scatter(data, scratch, length, key, d * radix_bits, offsets);
+            // 分配之后offsets[b]是桶b的末尾
+            std::size_t begin = 0;
+            for (std::size_t bucket = 0; bucket < radix; ++bucket) {
+                std::size_t end = offsets[bucket];
+                if (d > 0 && end - begin > 1) {
+                    msd_radix_sort(scratch + begin, data + begin, end - begin, key);
+                }
+                begin = end;
+            }
+            std::memcpy(static_cast<void *>(data), static_cast<const void *>(scratch), length * sizeof(T));
+        }
+
+        /**
+         * MSD原地基数排序（American flag sort, McIlroy, Bostic, McIlroy 1993）
+         * 统计当前字节的直方图，算出每个桶的范围，再沿着置换环把元素直接交换到所属的桶中，不需要辅助空间；
+         * 然后对每个桶按下一字节递归。所有元素落在同一个桶时跳过这一字节
+         * 只要求随机访问迭代器和可以交换的元素；不稳定
+         * @note 沿置换环交换时下一次访问的位置取决于刚读到的元素，大数据上受内存延迟限制，
+         * 元素可以平凡复制并且连续存放时radix_sort用需要辅助空间但快得多的分配
+         * @param shift 当前字节的位移
+         */
+        template<typename RandomIt, typename KeyFunction>
+        void american_flag_sort(RandomIt first, RandomIt last, const KeyFunction &key, int shift) {
+            while (true) {
+                std::ptrdiff_t length = last - first;
+                if (length <= msd_insertion_sort_threshold) {
+                    insertion_sort_by_key(first, last, key);
+                    return;
+                }
+                std::ptrdiff_t bucket_end[radix];
+                std::ptrdiff_t next[radix];
+                std::memset(bucket_end, 0, sizeof(bucket_end));
+                for (RandomIt it = first; it != last; ++it) {
+                    ++bucket_end[digit(key(*it), shift)];
+                }
+                if (bucket_end[digit(key(*first), shift)] == length) {
+                    if (shift == 0) {
+                        return;
+                    }
+                    shift -= radix_bits;
+                    continue;
+                }
+                std::ptrdiff_t sum = 0;
+                for (std::size_t bucket = 0; bucket < radix; ++bucket) {
+                    next[bucket] = sum;
+                    sum += bucket_end[bucket];
+                    bucket_end[bucket] = sum;
+                }
+                // next[b]之前的元素都已经在桶b中；把next[b]处的元素换到它所属的桶，直到换来的元素属于桶b
+                for (std::size_t bucket = 0; bucket < radix; ++bucket) {
+                    for (; next[bucket] < bucket_end[bucket]; ++next[bucket]) {
+                        RandomIt position = first + next[bucket];
+                        std::size_t owner = digit(key(*position), shift);
+                        while (owner != bucket) {
+                            Readable::iter_swap(position, first + next[owner]++);
+                            owner = digit(key(*position), shift);
+                        }
+                    }
+                }
+                if (shift == 0) {
+                    return;
+                }
+                std::ptrdiff_t begin = 0;
+                for (std::size_t bucket = 0; bucket < radix; ++bucket) {
+                    if (bucket_end[bucket] - begin > 1) {
+                        radix_detail::american_flag_sort(first + begin, first + bucket_end[bucket], key, shift - radix_bits);
+                    }
+                    begin = bucket_end[bucket];
+                }
+                return;
+            }
+        }
+
+        template<typename RandomIt, typename KeyFunction>
+        void american_flag_sort(RandomIt first, RandomIt last, const KeyFunction &key) {
+            if (last - first < 2) {
+                return;
+            }
+            radix_detail::american_flag_sort(first, last, key,
+                               static_cast<int>(sizeof(typename KeyFunction::key_type) * 8) - radix_bits);
+        }
+
+        /**
+         * 连续存放并且可以平凡复制的元素用分配的方式排序，需要和输入一样大的辅助空间
+         */
+        template<typename RandomIt, typename KeyFunction>
+        void radix_sort(RandomIt first, RandomIt last, const KeyFunction &key, Readable::true_type) {
+            typedef typename iterator_traits<RandomIt>::value_type value_type;
+            std::size_t length = static_cast<std::size_t>(last - first);
+            value_type *scratch = Readable::allocator<value_type>::allocate(length);
+            try {
+                msd_radix_sort(bitwise_copy_detail::to_address(first), scratch, length, key);
+            } catch (...) {
+                Readable::allocator<value_type>::deallocate(scratch, length);
+                throw;
+            }
+            Readable::allocator<value_type>::deallocate(scratch, length);
+        }
+
+        /**
+         * 其他元素只能原地交换
+         */
+        template<typename RandomIt, typename KeyFunction>
+        void radix_sort(RandomIt first, RandomIt last, const KeyFunction &key, Readable::false_type) {
+            radix_detail::american_flag_sort(first, last, key);
+        }
+
+        template<typename RandomIt, typename KeyFunction>
+        void radix_sort(RandomIt first, RandomIt last, const KeyFunction &key) {
+            typedef typename iterator_traits<RandomIt>::value_type value_type;
+            if (last - first < 2) {
+                return;
+            }
+            radix_detail::radix_sort(first, last, key, Readable::integral_constant<bool,
+                    Readable::is_contiguous_iterator<RandomIt>::value &&
+                    Readable::is_trivially_copyable<value_type>::value>());
+        }
+    }
+
+    /**
+     * T是否可以直接用基数排序：整数（包括bool和字符类型）、IEEE 754的float和double
+     */
+    template<typename T>
+    struct is_radix_sortable : public Readable::integral_constant<bool, radix_detail::key_traits<T>::sortable> {
+    };
+
+    /**
+     * 按元素本身的大小升序排列，元素是整数或浮点数，O(n * sizeof(T))
+     * 连续存放时用LSD（数据超出缓存时先按最高的有效字节分桶），需要和输入一样大的辅助空间；
+     * 不连续时用原地的American flag sort
+     */
+    template<typename RandomIt>
+    void radix_sort(RandomIt first, RandomIt last) {
+        typedef typename iterator_traits<RandomIt>::value_type value_type;
+        static_assert(is_radix_sortable<value_type>::value, "radix_sort requires integral or floating-point elements");
+        radix_detail::radix_sort(first, last, radix_detail::identity_key<value_type>());
+    }
+
+    /**
+     * 按 @arg extract 取出的键（整数或浮点数）升序排列，用于按某个字段排序结构体
+     * 元素可以平凡复制并且连续存放时排序是稳定的；否则用原地的American flag sort，不稳定
+     */
+    template<typename RandomIt, typename Extractor>
+    void radix_sort(RandomIt first, RandomIt last, Extractor extract) {
+        typedef typename iterator_traits<RandomIt>::value_type value_type;
+        typedef radix_detail::extracted_key<Extractor, value_type> key_function;
+        static_assert(is_radix_sortable<typename key_function::extracted_type>::value,
+                      "the key must be integral or floating-point");
+        radix_detail::radix_sort(first, last, key_function(std::move(extract)));
+    }
+
+    /**
+     * 原地的MSD基数排序，不需要辅助空间，不稳定
+     */
+    template<typename RandomIt>
+    void american_flag_sort(RandomIt first, RandomIt last) {
+        typedef typename iterator_traits<RandomIt>::value_type value_type;
+        static_assert(is_radix_sortable<value_type>::value,
+                      "american_flag_sort requires integral or floating-point elements");
+        radix_detail::american_flag_sort(first, last, radix_detail::identity_key<value_type>());
+    }
+
+    template<typename RandomIt, typename Extractor>
+    void american_flag_sort(RandomIt first, RandomIt last, Extractor extract) {
+        typedef typename iterator_traits<RandomIt>::value_type value_type;
+        typedef radix_detail::extracted_key<Extractor, value_type> key_function;
+        static_assert(is_radix_sortable<typename key_function::extracted_type>::value,
+                      "the key must be integral or floating-point");
+        radix_detail::american_flag_sort(first, last, key_function(std::move(extract)));
+    }
+}
+
+#endif //STL_FROM_SCRATCH_RADIX_SORT_H
@@ -0,0 +1,601 @@
+#ifndef STL_FROM_SCRATCH_SORT_H
+#define STL_FROM_SCRATCH_SORT_H
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <type_traits>
+#include <utility>
+#include "./heap.h"
+#include "./modifying_sequence.h"
+#include "./radix_sort.h"
+#include "./sorting_network.h"
+#include "../iterator/iterator.h"
+#include "../functional/functional.h"
+
+namespace Readable {
+    /**
+     * @return [first, last)中从first开始最长的有序前缀的末尾
+     */
+    template<typename ForwardIt, typename Compare>
+    ForwardIt is_sorted_until(ForwardIt first, ForwardIt last, Compare comp) {
+        if (first == last) {
+            return last;
+        }
+        ForwardIt next = first;
+        while (++next != last) {
+            if (comp(*next, *first)) {
+                return next;
+            }
+            first = next;
+        }
+        return last;
+    }
+
+    template<typename ForwardIt>
+    ForwardIt is_sorted_until(ForwardIt first, ForwardIt last) {
+        return Readable::is_sorted_until(first, last, Readable::less<typename iterator_traits<ForwardIt>::value_type>());
+    }
+
+    template<typename ForwardIt, typename Compare>
+    bool is_sorted(ForwardIt first, ForwardIt last, Compare comp) {
+        return Readable::is_sorted_until(first, last, comp) == last;
+    }
+
+    template<typename ForwardIt>
+    bool is_sorted(ForwardIt first, ForwardIt last) {
+        return Readable::is_sorted_until(first, last) == last;
+    }
+
+    /**
+     * pattern-defeating quicksort（Orson Peters, 2016）
+     * 在introsort的基础上：
+     * 1. 划分后如果区间本来就已经划分好，用有限次数的插入排序试探是否已经有序，有序的输入是O(n)
+     * 2. 等于左侧边界元素（上一轮的轴）的轴说明有大量重复元素，把等于轴的元素整体划到左边跳过
+     * 3. 划分严重不平衡时打乱几个元素破坏可能导致退化的模式，次数用完后改用堆排序，保证O(nlogn)
+     * 4. 比较廉价的算术类型用BlockQuicksort的分块划分：先无分支地记录放错一侧的元素的偏移，再成批交换，避免分支预测失败
+     */
+    namespace sort_detail {
+        // 小于这个长度的区间用插入排序
+        const std::ptrdiff_t insertion_sort_threshold = 24;
+        // 大于这个长度的区间用九数取中（ninther）选轴
+        const std::ptrdiff_t ninther_threshold = 128;
+        // 试探性的插入排序最多移动这么多次，超过就放弃
+        const std::ptrdiff_t partial_insertion_sort_limit = 8;
+        // 分块划分中每块的元素数，偏移用unsigned char保存
+        const std::ptrdiff_t block_size = 64;
+        const std::size_t cache_line_size = 64;
+
+        /**
+         * 比较是否足够廉价、可以用分块划分：算术类型，并且比较函数就是内置的 < 或 >
+         * 其他比较函数可能有副作用或者很昂贵，分块划分中多出的比较得不偿失
+         */
+        template<typename Compare, typename T>
+        struct is_builtin_compare : public std::false_type {
+        };
+
+        template<typename T>
+        struct is_builtin_compare<Readable::less<T>, T> : public std::true_type {
+        };
+
+        template<typename T>
+        struct is_builtin_compare<std::less<T>, T> : public std::true_type {
+        };
+
+        template<typename T>
+        struct is_builtin_compare<std::greater<T>, T> : public std::true_type {
+        };
+
+        template<typename RandomIt, typename Compare>
+        struct use_block_partition : public std::integral_constant<bool,
+                std::is_arithmetic<typename iterator_traits<RandomIt>::value_type>::value &&
+                is_builtin_compare<Compare, typename iterator_traits<RandomIt>::value_type>::value> {
+        };
+
+        // 不少于这么多元素时，整数和浮点数改用基数排序
+        const std::ptrdiff_t radix_sort_threshold = 256;
+
+        /**
+         * 比较函数是内置的 < 时按元素本身的键排序，是 > 时按取反的键排序
+         */
+        template<typename Compare, typename T>
+        struct radix_key {
+            typedef radix_detail::identity_key<T> type;
+
+            static type make() {
+                return type();
+            }
+        };
+
+        template<typename T>
+        struct radix_key<std::greater<T>, T> {
+            typedef radix_detail::inverted_key<radix_detail::identity_key<T> > type;
+
+            static type make() {
+                return type(radix_detail::identity_key<T>());
+            }
+        };
+
+        /**
+         * 连续存放的整数和浮点数，比较函数是内置的 < 或 >，可以改用基数排序
+         */
+        template<typename RandomIt, typename Compare>
+        struct use_radix_sort : public std::integral_constant<bool,
+                use_block_partition<RandomIt, Compare>::value &&
+                Readable::is_radix_sortable<typename iterator_traits<RandomIt>::value_type>::value &&
+                Readable::is_contiguous_iterator<RandomIt>::value> {
+        };
+
+        /**
+         * 基数排序每个元素的开销和n无关，比较排序是O(logn)；但8字节的键要分配八趟，
+         * 数据超出缓存后每一趟都受内存带宽限制，实测不如pdqsort，这时仍用比较排序
+         * @return 是否已经排好
+         */
+        template<typename RandomIt, typename Compare>
+        bool try_radix_sort(RandomIt first, RandomIt last, std::true_type) {
+            typedef typename iterator_traits<RandomIt>::value_type value_type;
+            std::ptrdiff_t size = last - first;
+            if (size < radix_sort_threshold ||
+                (sizeof(value_type) > 4 &&
+                 static_cast<std::size_t>(size) * sizeof(value_type) > radix_detail::lsd_max_bytes)) {
+                return false;
+            }
+            radix_detail::radix_sort(first, last, radix_key<Compare, value_type>::make());
+            return true;
+        }
+
+        template<typename RandomIt, typename Compare>
+        bool try_radix_sort(RandomIt, RandomIt, std::false_type) {
+            return false;
+        }
+
+        template<typename T>
+        int log2(T n) {
+            int result = 0;
+            while (n >>= 1) {
+                ++result;
+            }
+            return result;
+        }
+
+        template<typename RandomIt, typename Compare>
+        void insertion_sort(RandomIt first, RandomIt last, Compare &comp) {
+            typedef typename iterator_traits<RandomIt>::value_type value_type;
+            if (first == last) {
+                return;
+            }
+            for (RandomIt current = first + 1; current != last; ++current) {
+                RandomIt hole = current;
+                RandomIt previous = current - 1;
+                if (comp(*hole, *previous)) {
+                    value_type value = iter_move(hole);
+                    do {
+                        *hole = iter_move(previous);
+                        --hole;
+                    } while (hole != first && comp(value, *--previous));
+                    *hole = std::move(value);
+                }
+            }
+        }
+
+        /**
+         * 插入排序，但不检查是否越过了first
+         * 要求first之前的元素不大于[first, last)中的任何元素，它起到哨兵的作用
+         */
+        template<typename RandomIt, typename Compare>
+        void unguarded_insertion_sort(RandomIt first, RandomIt last, Compare &comp) {
+            typedef typename iterator_traits<RandomIt>::value_type value_type;
+            if (first == last) {
+                return;
+            }
+            for (RandomIt current = first + 1; current != last; ++current) {
+                RandomIt hole = current;
+                RandomIt previous = current - 1;
+                if (comp(*hole, *previous)) {
+                    value_type value = iter_move(hole);
+                    do {
+                        *hole = iter_move(previous);
+                        --hole;
+                    } while (comp(value, *--previous));
+                    *hole = std::move(value);
+                }
+            }
+        }
+
+        /**
+         * 试探性的插入排序，元素移动的总次数超过partial_insertion_sort_limit时放弃
+         * @return 是否完成了排序
+         */
+        template<typename RandomIt, typename Compare>
+        bool partial_insertion_sort(RandomIt first, RandomIt last, Compare &comp) {
+            typedef typename iterator_traits<RandomIt>::value_type value_type;
+            if (first == last) {
+                return true;
+            }
+            std::ptrdiff_t moved = 0;
+            for (RandomIt current = first + 1; current != last; ++current) {
+                RandomIt hole = current;
+                RandomIt previous = current - 1;
+                if (comp(*hole, *previous)) {
+                    value_type value = iter_move(hole);
+                    do {
+                        *hole = iter_move(previous);
+                        --hole;
+                    } while (hole != first && comp(value, *--previous));
+                    *hole = std::move(value);
+                    moved += current - hole;
+                }
+                if (moved > partial_insertion_sort_limit) {
+                    return false;
+                }
+            }
+            return true;
+        }
+
+        template<typename RandomIt, typename Compare>
+        void sort2(RandomIt a, RandomIt b, Compare &comp) {
+            if (comp(*b, *a)) {
+                Readable::iter_swap(a, b);
+            }
+        }
+
+        /**
+         * 把*a, *b, *c排成有序，中位数在b
+         */
+        template<typename RandomIt, typename Compare>
+        void sort3(RandomIt a, RandomIt b, RandomIt c, Compare &comp) {
+            sort2(a, b, comp);
+            sort2(b, c, comp);
+            sort2(a, b, comp);
+        }
+
+        inline unsigned char *align_cache_line(unsigned char *p) {
+            std::uintptr_t address = reinterpret_cast<std::uintptr_t>(p);
+            address = (address + cache_line_size - 1) & ~(std::uintptr_t(cache_line_size) - 1);
+            return reinterpret_cast<unsigned char *>(address);
+        }
+
+        /**
+         * 交换左右两块中记录的放错一侧的元素：first + offsets_left[i]和last - offsets_right[i]
+         * 两侧数量不等时用一次循环移动代替逐对交换，每个元素只移动一次而不是三次
+         */
+        template<typename RandomIt>
+        void swap_offsets(RandomIt first, RandomIt last, unsigned char *offsets_left, unsigned char *offsets_right,
+                          std::size_t count, bool use_swaps) {
+            typedef typename iterator_traits<RandomIt>::value_type value_type;
+            if (use_swaps) {
+                for (std::size_t i = 0; i < count; ++i) {
+                    Readable::iter_swap(first + offsets_left[i], last - offsets_right[i]);
+                }
+            } else if (count > 0) {
+                RandomIt left = first + offsets_left[0];
+                RandomIt right = last - offsets_right[0];
+                value_type value = iter_move(left);
+                *left = iter_move(right);
+                for (std::size_t i = 1; i < count; ++i) {
+                    left = first + offsets_left[i];
+                    *right = iter_move(left);
+                    right = last - offsets_right[i];
+                    *left = iter_move(right);
+                }
+                *right = std::move(value);
+            }
+        }
+
+        /**
+         * 以*first为轴划分[first, last)，等于轴的元素放在右边
+         * @return 轴的最终位置，以及划分前区间是否已经划分好（没有发生交换）
+         * @note 要求轴不是区间中的最大元素（选轴时的sort3保证了这一点），或者first之后有不小于轴的元素做哨兵
+         */
+        template<typename RandomIt, typename Compare>
+        std::pair<RandomIt, bool> partition_right(RandomIt first, RandomIt last, Compare &comp, std::false_type) {
+            typedef typename iterator_traits<RandomIt>::value_type value_type;
+            value_type pivot = iter_move(first);
+            RandomIt begin = first;
+            // 找到左边第一个不小于轴的元素，和右边第一个小于轴的元素
+            while (comp(*++first, pivot)) {
+            }
+            if (first - 1 == begin) {
+                // 左边没有小于轴的元素时，右边可能也没有，需要检查边界
+                while (first < last && !comp(*--last, pivot)) {
+                }
+            } else {
+                while (!comp(*--last, pivot)) {
+                }
+            }
+            bool already_partitioned = first >= last;
+            while (first < last) {
+                Readable::iter_swap(first, last);
+                while (comp(*++first, pivot)) {
+                }
+                while (!comp(*--last, pivot)) {
+                }
+            }
+            RandomIt pivot_position = first - 1;
+            *begin = iter_move(pivot_position);
+            *pivot_position = std::move(pivot);
+            return std::make_pair(pivot_position, already_partitioned);
+        }
+
+        /**
+         * 和上面相同的划分，用BlockQuicksort（Edelkamp, Weiß）的分块方法
+         * 每次从左右两端各取一块，比较结果直接累加到计数上，把放错一侧的元素的偏移记下来（没有依赖比较结果的分支），再成批交换
+         */
+        template<typename RandomIt, typename Compare>
+        std::pair<RandomIt, bool> partition_right(RandomIt first, RandomIt last, Compare &comp, std::true_type) {
+            typedef typename iterator_traits<RandomIt>::value_type value_type;
+            value_type pivot = iter_move(first);
+            RandomIt begin = first;
+            while (comp(*++first, pivot)) {
+            }
+            if (first - 1 == begin) {
+                while (first < last && !comp(*--last, pivot)) {
+                }
+            } else {
+                while (!comp(*--last, pivot)) {
+                }
+            }
+            bool already_partitioned = first >= last;
+            if (!already_partitioned) {
+                Readable::iter_swap(first, last);
+                ++first;
+
+                unsigned char offsets_left_storage[block_size + cache_line_size];
+                unsigned char offsets_right_storage[block_size + cache_line_size];
+                unsigned char *offsets_left = align_cache_line(offsets_left_storage);
+                unsigned char *offsets_right = align_cache_line(offsets_right_storage);
+
+                RandomIt offsets_left_base = first;
+                RandomIt offsets_right_base = last;
+                std::size_t count_left = 0, count_right = 0, start_left = 0, start_right = 0;
+                while (first < last) {
+                    // 上一轮某一侧的偏移用完了才重新填这一侧；剩下不足两块时在两侧之间分配
+                    std::size_t unknown = static_cast<std::size_t>(last - first);
+                    std::size_t left_split = count_left == 0 ? (count_right == 0 ? unknown / 2 : unknown) : 0;
+                    std::size_t right_split = count_right == 0 ? (unknown - left_split) : 0;
+                    if (left_split > static_cast<std::size_t>(block_size)) {
+                        left_split = block_size;
+                    }
+                    if (right_split > static_cast<std::size_t>(block_size)) {
+                        right_split = block_size;
+                    }
+                    for (std::size_t i = 0; i < left_split; ++i) {
+                        offsets_left[count_left] = static_cast<unsigned char>(i);
+                        count_left += !comp(*first, pivot);
+                        ++first;
+                    }
+                    for (std::size_t i = 0; i < right_split;) {
+                        offsets_right[count_right] = static_cast<unsigned char>(++i);
+                        count_right += comp(*--last, pivot);
+                    }
+
+                    std::size_t count = count_left < count_right ? count_left : count_right;
+                    swap_offsets(offsets_left_base, offsets_right_base, offsets_left + start_left,
+                                 offsets_right + start_right, count, count_left == count_right);
+                    count_left -= count;
+                    count_right -= count;
+                    start_left += count;
+                    start_right += count;
+                    if (count_left == 0) {
+                        start_left = 0;
+                        offsets_left_base = first;
+                    }
+                    if (count_right == 0) {
+                        start_right = 0;
+                        offsets_right_base = last;
+                    }
+                }
+
+                // 所有元素都已比较过，把一侧剩下的放错的元素换到中间
+                if (count_left) {
+                    offsets_left += start_left;
+                    while (count_left--) {
+                        Readable::iter_swap(offsets_left_base + offsets_left[count_left], --last);
+                    }
+                    first = last;
+                }
+                if (count_right) {
+                    offsets_right += start_right;
+                    while (count_right--) {
+                        Readable::iter_swap(offsets_right_base - offsets_right[count_right], first);
+                        ++first;
+                    }
+                    last = first;
+                }
+            }
+            RandomIt pivot_position = first - 1;
+            *begin = iter_move(pivot_position);
+            *pivot_position = std::move(pivot);
+            return std::make_pair(pivot_position, already_partitioned);
+        }
+
+        /**
+         * 以*first为轴划分[first, last)，等于轴的元素放在左边
+         * 只在轴等于左侧边界元素（上一轮的轴）时使用：这时区间中没有小于轴的元素，划分后左边全都等于轴，不需要再排序
+         * @return 轴的最终位置
+         */
+        template<typename RandomIt, typename Compare>
+        RandomIt partition_left(RandomIt first, RandomIt last, Compare &comp) {
+            typedef typename iterator_traits<RandomIt>::value_type value_type;
+            value_type pivot = iter_move(first);
+            RandomIt begin = first;
+            RandomIt end = last;
+            while (comp(pivot, *--last)) {
+            }
+            if (last + 1 == end) {
+                while (first < last && !comp(pivot, *++first)) {
+                }
+            } else {
+                while (!comp(pivot, *++first)) {
+                }
+            }
+            while (first < last) {
+                Readable::iter_swap(first, last);
+                while (comp(pivot, *--last)) {
+                }
+                while (!comp(pivot, *++first)) {
+                }
+            }
+            *begin = iter_move(last);
+            *last = std::move(pivot);
+            return last;
+        }
+
+        /**
+         * 划分严重不平衡时，把区间中几个固定位置的元素换到选轴的位置上，打破让选轴一直失败的输入模式
+         */
+        template<typename RandomIt>
+        void break_patterns(RandomIt first, RandomIt pivot_position, RandomIt last) {
+            std::ptrdiff_t left_size = pivot_position - first;
+            std::ptrdiff_t right_size = last - (pivot_position + 1);
+            if (left_size >= insertion_sort_threshold) {
+                Readable::iter_swap(first, first + left_size / 4);
+                Readable::iter_swap(pivot_position - 1, pivot_position - left_size / 4);
+                if (left_size > ninther_threshold) {
+                    Readable::iter_swap(first + 1, first + (left_size / 4 + 1));
+                    Readable::iter_swap(first + 2, first + (left_size / 4 + 2));
+                    Readable::iter_swap(pivot_position - 2, pivot_position - (left_size / 4 + 1));
+                    Readable::iter_swap(pivot_position - 3, pivot_position - (left_size / 4 + 2));
+                }
+            }
+            if (right_size >= insertion_sort_threshold) {
+                Readable::iter_swap(pivot_position + 1, pivot_position + (1 + right_size / 4));
+                Readable::iter_swap(last - 1, last - right_size / 4);
+                if (right_size > ninther_threshold) {
+                    Readable::iter_swap(pivot_position + 2, pivot_position + (2 + right_size / 4));
+                    Readable::iter_swap(pivot_position + 3, pivot_position + (3 + right_size / 4));
+                    Readable::iter_swap(last - 2, last - (1 + right_size / 4));
+                    Readable::iter_swap(last - 3, last - (2 + right_size / 4));
+                }
+            }
+        }
+
+        /**
+         * 划分到很小的区间：比较廉价的算术类型用排序网络，没有依赖数据的分支；其他元素用插入排序
+         */
+        template<typename RandomIt, typename Compare>
+        void small_sort(RandomIt first, RandomIt last, Compare &comp, bool leftmost, std::true_type) {
+            Readable::small_sort(first, last, comp);
+        }
+
+        template<typename RandomIt, typename Compare>
+        void small_sort(RandomIt first, RandomIt last, Compare &comp, bool leftmost, std::false_type) {
+            if (leftmost) {
+                insertion_sort(first, last, comp);
+            } else {
+                unguarded_insertion_sort(first, last, comp);
+            }
+        }
+
+        /**
+         * @param bad_allowed 还允许多少次不平衡的划分，用完后改用堆排序
+         * @param leftmost [first, last)是否是整个区间最左边的部分，否则first之前的元素不大于区间中的任何元素
+         * @param block_partition 是否使用分块划分
+         */
+        template<typename RandomIt, typename Compare, typename BlockPartition>
+        void pdqsort_loop(RandomIt first, RandomIt last, Compare &comp, int bad_allowed, bool leftmost,
+                          BlockPartition block_partition) {
+            while (true) {
+                std::ptrdiff_t size = last - first;
+                if (size < insertion_sort_threshold) {
+                    small_sort(first, last, comp, leftmost, block_partition);
+                    return;
+                }
+
+                // 选轴：中位数放到first
+                std::ptrdiff_t half = size / 2;
+                if (size > ninther_threshold) {
+                    sort3(first, first + half, last - 1, comp);
+                    sort3(first + 1, first + (half - 1), last - 2, comp);
+                    sort3(first + 2, first + (half + 1), last - 3, comp);
+                    sort3(first + (half - 1), first + half, first + (half + 1), comp);
+                    Readable::iter_swap(first, first + half);
+                } else {
+                    sort3(first + half, first, last - 1, comp);
+                }
+
+                // 轴等于左侧的上一个轴：区间中没有比它小的元素，把等于轴的元素都放到左边，只需继续排右边
+                if (!leftmost && !comp(*(first - 1), *first)) {
+                    first = partition_left(first, last, comp) + 1;
+                    continue;
+                }
+
+                std::pair<RandomIt, bool> result = partition_right(first, last, comp, block_partition);
+                RandomIt pivot_position = result.first;
+                bool already_partitioned = result.second;
+
+                std::ptrdiff_t left_size = pivot_position - first;
+                std::ptrdiff_t right_size = last - (pivot_position + 1);
+                if (left_size < size / 8 || right_size < size / 8) {
+                    if (--bad_allowed == 0) {
+                        Readable::make_heap(first, last, comp);
+                        Readable::sort_heap(first, last, comp);
+                        return;
+                    }
+                    break_patterns(first, pivot_position, last);
+                } else if (already_partitioned && partial_insertion_sort(first, pivot_position, comp) &&
+                           partial_insertion_sort(pivot_position + 1, last, comp)) {
+                    // 划分时没有交换，两边又都几乎有序：整个区间已经排好
+                    return;
+                }
+
+                // 递归排左边，循环排右边
+                pdqsort_loop(first, pivot_position, comp, bad_allowed, leftmost, block_partition);
+                first = pivot_position + 1;
+                leftmost = false;
+            }
+        }
+
+        /**
+         * 整个区间已经有序或者逆序时直接处理，O(n)
+         * 扫描在第一个不符合的位置就停止，对于无序的输入几乎没有开销
+         * @return 是否已经处理完
+         */
+        template<typename RandomIt, typename Compare>
+        bool sort_monotonic(RandomIt first, RandomIt last, Compare &comp) {
+            RandomIt next = first + 1;
+            if (!comp(*next, *first)) {
+                for (; next != last && !comp(*next, *(next - 1)); ++next) {
+                }
+                return next == last;
+            }
+            // 非增的序列反转后就是非减的
+            for (; next != last && !comp(*(next - 1), *next); ++next) {
+            }
+            if (next == last) {
+                Readable::reverse(first, last);
+                return true;
+            }
+            return false;
+        }
+    }
+
+    /**
+     * 不稳定排序，最坏O(nlogn)，有序、逆序的输入O(n)
+     * 连续存放的整数和浮点数按内置的 < 或 > 排序时，在基数排序更快的规模上自动改用基数排序
+     * @param comp 比较函数
+     */
+    template<typename RandomIt, typename Compare>
+    void sort(RandomIt first, RandomIt last, Compare comp) {
+        std::ptrdiff_t size = last - first;
+        if (size < 2) {
+            return;
+        }
+        if (size >= sort_detail::insertion_sort_threshold && sort_detail::sort_monotonic(first, last, comp)) {
+            return;
+        }
+        if (sort_detail::try_radix_sort<RandomIt, Compare>(first, last,
+                                                           sort_detail::use_radix_sort<RandomIt, Compare>())) {
+            return;
+        }
+        sort_detail::pdqsort_loop(first, last, comp, sort_detail::log2(size), true,
+                                  sort_detail::use_block_partition<RandomIt, Compare>());
+    }
+
+    template<typename RandomIt>
+    void sort(RandomIt first, RandomIt last) {
+        Readable::sort(first, last, Readable::less<typename iterator_traits<RandomIt>::value_type>());
+    }
+}
+
+#endif //STL_FROM_SCRATCH_SORT_H
@@ -0,0 +1,263 @@
+#ifndef STL_FROM_SCRATCH_SORTING_NETWORK_H
+#define STL_FROM_SCRATCH_SORTING_NETWORK_H
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+#include <utility>
+#include "./modifying_sequence.h"
+#include "../iterator/iterator.h"
+#include "../functional/functional.h"
+#include "../utility/utility.h"
+
+namespace Readable {
+    namespace sorting_network_detail {
+        // 排序网络支持的最大长度
+        const std::size_t max_network_size = 32;
+
+        constexpr std::size_t ceil_power_of_two(std::size_t n, std::size_t power = 1) {
+            return power >= n ? power : ceil_power_of_two(n, power * 2);
+        }
+
+        // 比较交换的三种实现
+        typedef std::integral_constant<int, 0> exchange_by_swap;
+        typedef std::integral_constant<int, 1> exchange_by_select;
+        typedef std::integral_constant<int, 2> exchange_by_mask;
+
+        template<std::size_t Size>
+        struct unsigned_of_size {
+            typedef void type;
+        };
+
+        template<>
+        struct unsigned_of_size<4> {
+            typedef std::uint32_t type;
+        };
+
+        template<>
+        struct unsigned_of_size<8> {
+            typedef std::uint64_t type;
+        };
+
+        /**
+         * 整数和指针用条件选择代替交换：两次赋值都执行，编译成cmov，没有难以预测的分支
+         * float和double的条件选择会被编译器合并回分支，改为在同样大小的整数上用掩码交换
+         * 其他元素（以及解引用得到代理对象的迭代器）比较后按需交换
+         */
+        template<typename RandomIt, typename T = typename iterator_traits<RandomIt>::value_type>
+        struct exchange_method : public std::integral_constant<int,
+                std::is_integral<T>::value || std::is_pointer<T>::value ? exchange_by_select::value :
+                std::is_floating_point<T>::value &&
+                !std::is_void<typename unsigned_of_size<sizeof(T)>::type>::value ? exchange_by_mask::value :
+                exchange_by_swap::value> {
+        };
+
+        template<typename RandomIt, typename Compare>
+        void compare_exchange(RandomIt a, RandomIt b, Compare &comp, exchange_by_select) {
+            typedef typename iterator_traits<RandomIt>::value_type value_type;
+            value_type x = *a;
+            value_type y = *b;
+            bool swapped = comp(y, x);
+            *a = swapped ? y : x;
+            *b = swapped ? x : y;
+        }
+
+        template<typename RandomIt, typename Compare>
+        void compare_exchange(RandomIt a, RandomIt b, Compare &comp, exchange_by_mask) {
+            typedef typename iterator_traits<RandomIt>::value_type value_type;
+            typedef typename unsigned_of_size<sizeof(value_type)>::type bits_type;
+            value_type x = *a;
+            value_type y = *b;
+            bits_type mask = bits_type(0) - static_cast<bits_type>(comp(y, x));
+            bits_type x_bits, y_bits;
+            std::memcpy(&x_bits, &x, sizeof(x));
+            std::memcpy(&y_bits, &y, sizeof(y));
+            bits_type difference = (x_bits ^ y_bits) & mask;
+            x_bits ^= difference;
+            y_bits ^= difference;
+            std::memcpy(&x, &x_bits, sizeof(x));
+            std::memcpy(&y, &y_bits, sizeof(y));
+            *a = x;
+            *b = y;
+        }
+
+        template<typename RandomIt, typename Compare>
+        void compare_exchange(RandomIt a, RandomIt b, Compare &comp, exchange_by_swap) {
+            if (comp(*b, *a)) {
+                Readable::iter_swap(a, b);
+            }
+        }
+
+        /**
+         * 比较器(I, J)
+         * 长度不是2的幂时按补齐到2的幂、多出的位置都是"无穷大"来构造网络：涉及这些位置的比较器永远不会交换，直接省略
+         */
+        template<std::size_t N, std::size_t I, std::size_t J, bool InRange = (J < N)>
+        struct comparator {
+            template<typename RandomIt, typename Compare, typename Method>
+            static void apply(RandomIt first, Compare &comp, Method method) {
+                compare_exchange(first + I, first + J, comp, method);
+            }
+        };
+
+        template<std::size_t N, std::size_t I, std::size_t J>
+        struct comparator<N, I, J, false> {
+            template<typename RandomIt, typename Compare, typename Method>
+            static void apply(RandomIt, Compare &, Method) {
+            }
+        };
+
+        /**
+         * for (i = First; i + R < End; i += Step) 比较器(i, i + R)
+         */
+        template<std::size_t N, std::size_t I, std::size_t R, std::size_t Step, std::size_t End,
+                bool Continue = (I + R < End && I < N)>
+        struct comparator_sequence {
+            template<typename RandomIt, typename Compare, typename Method>
+            static void apply(RandomIt first, Compare &comp, Method method) {
+                comparator<N, I, I + R>::apply(first, comp, method);
+                comparator_sequence<N, I + Step, R, Step, End>::apply(first, comp, method);
+            }
+        };
+
+        template<std::size_t N, std::size_t I, std::size_t R, std::size_t Step, std::size_t End>
+        struct comparator_sequence<N, I, R, Step, End, false> {
+            template<typename RandomIt, typename Compare, typename Method>
+            static void apply(RandomIt, Compare &, Method) {
+            }
+        };
+
+        /**
+         * Batcher奇偶归并：归并[Lo, Lo + Length)中两个有序的半段，只看间隔为R的元素
+         * 先分别归并偶数位和奇数位的子序列，再比较相邻的奇偶元素
+         */
+        template<std::size_t N, std::size_t Lo, std::size_t Length, std::size_t R,
+                bool Recurse = (R * 2 < Length), bool Empty = (Lo >= N)>
+        struct odd_even_merge {
+            template<typename RandomIt, typename Compare, typename Method>
+            static void apply(RandomIt first, Compare &comp, Method method) {
+                odd_even_merge<N, Lo, Length, R * 2>::apply(first, comp, method);
+                odd_even_merge<N, Lo + R, Length, R * 2>::apply(first, comp, method);
+                comparator_sequence<N, Lo + R, R, R * 2, Lo + Length>::apply(first, comp, method);
+            }
+        };
+
+        template<std::size_t N, std::size_t Lo, std::size_t Length, std::size_t R>
+        struct odd_even_merge<N, Lo, Length, R, false, false> {
+            template<typename RandomIt, typename Compare, typename Method>
+            static void apply(RandomIt first, Compare &comp, Method method) {
+                comparator<N, Lo, Lo + R>::apply(first, comp, method);
+            }
+        };
+
+        template<std::size_t N, std::size_t Lo, std::size_t Length, std::size_t R, bool Recurse>
+        struct odd_even_merge<N, Lo, Length, R, Recurse, true> {
+            template<typename RandomIt, typename Compare, typename Method>
+            static void apply(RandomIt, Compare &, Method) {
+            }
+        };
+
+        /**
+         * Batcher奇偶归并排序网络：分别排序两半，再奇偶归并
+         * 每一层的比较器互不相干，CPU可以并行执行；长度为2^k时共(k^2 - k + 4)2^(k - 2) - 1个比较器
+         */
+        template<std::size_t N, std::size_t Lo, std::size_t Length, bool Split = (Length > 1 && Lo < N)>
+        struct odd_even_merge_sort {
+            template<typename RandomIt, typename Compare, typename Method>
+            static void apply(RandomIt first, Compare &comp, Method method) {
+                odd_even_merge_sort<N, Lo, Length / 2>::apply(first, comp, method);
+                odd_even_merge_sort<N, Lo + Length / 2, Length / 2>::apply(first, comp, method);
+                odd_even_merge<N, Lo, Length, 1>::apply(first, comp, method);
+            }
+        };
+
+        template<std::size_t N, std::size_t Lo, std::size_t Length>
+        struct odd_even_merge_sort<N, Lo, Length, false> {
+            template<typename RandomIt, typename Compare, typename Method>
+            static void apply(RandomIt, Compare &, Method) {
+            }
+        };
+    }
+
+    /**
+     * 长度在编译期确定的排序网络，比较器的序列在编译期展开，没有循环和依赖数据的分支
+     * 用于长度固定的小数组，比如几何计算中的顶点、SIMD寄存器大小的块
+     * @tparam N 元素个数，不超过32
+     */
+    template<std::size_t N>
+    struct sorting_network {
+        static_assert(N <= sorting_network_detail::max_network_size, "sorting networks support at most 32 elements");
+
+        template<typename RandomIt, typename Compare>
+        static void sort(RandomIt first, Compare comp) {
+            typedef std::integral_constant<int, sorting_network_detail::exchange_method<RandomIt>::value> method;
+            sorting_network_detail::odd_even_merge_sort<
+                    N, 0, sorting_network_detail::ceil_power_of_two(N)>::apply(first, comp, method());
+        }
+
+        template<typename RandomIt>
+        static void sort(RandomIt first) {
+            sort(first, Readable::less<typename iterator_traits<RandomIt>::value_type>());
+        }
+    };
+
+    /**
+     * 用排序网络排序内置数组
+     */
+    template<typename T, std::size_t N, typename Compare>
+    void network_sort(T (&array)[N], Compare comp) {
+        sorting_network<N>::sort(array + 0, comp);
+    }
+
+    template<typename T, std::size_t N>
+    void network_sort(T (&array)[N]) {
+        sorting_network<N>::sort(array + 0, Readable::less<T>());
+    }
+
+    namespace sorting_network_detail {
+        template<typename RandomIt, typename Compare, std::size_t N>
+        void sort_fixed(RandomIt first, Compare &comp) {
+            sorting_network<N>::sort(first, comp);
+        }
+
+        /**
+         * 按长度索引的排序函数表，下标是元素个数
+         */
+        template<typename RandomIt, typename Compare>
+        struct dispatch_table {
+            typedef void (*function)(RandomIt, Compare &);
+
+            template<std::size_t... Sizes>
+            static const function *make(index_sequence<Sizes...>) {
+                static const function table[] = {&sort_fixed<RandomIt, Compare, Sizes>...};
+                return table;
+            }
+
+            static const function *get() {
+                return make(make_index_sequence<max_network_size + 1>());
+            }
+        };
+    }
+
+    /**
+     * 长度在运行时才知道的小区间：按长度选择对应的排序网络
+     * @return 是否已经排序；长度超过32时什么也不做，返回false
+     */
+    template<typename RandomIt, typename Compare>
+    bool small_sort(RandomIt first, RandomIt last, Compare comp) {
+        std::ptrdiff_t length = last - first;
+        if (length < 0 || length > static_cast<std::ptrdiff_t>(sorting_network_detail::max_network_size)) {
+            return false;
+        }
+        sorting_network_detail::dispatch_table<RandomIt, Compare>::get()[length](first, comp);
+        return true;
+    }
+
+    template<typename RandomIt>
+    bool small_sort(RandomIt first, RandomIt last) {
+        return Readable::small_sort(first, last, Readable::less<typename iterator_traits<RandomIt>::value_type>());
+    }
+}
+
+#endif //STL_FROM_SCRATCH_SORTING_NETWORK_H
@@ -0,0 +1,517 @@
+#ifndef STL_FROM_SCRATCH_STABLE_SORT_H
+#define STL_FROM_SCRATCH_STABLE_SORT_H
+
+#include <cstddef>
+#include <new>
+#include <utility>
+#include "./binary_search.h"
+#include "./modifying_sequence.h"
+#include "../iterator/iterator.h"
+#include "../functional/functional.h"
+#include "../memory/allocator.h"
+#include "../memory/uninitialized_memory_functions.h"
+
+namespace Readable {
+    namespace stable_sort_detail {
+        // 短于这个长度的输入整体用二分插入排序；自然段的最短长度minrun在[min_merge / 2, min_merge]中
+        const std::ptrdiff_t min_merge = 32;
+        // 归并时一边连续胜出这么多次就进入galloping模式
+        const std::ptrdiff_t initial_min_gallop = 7;
+        // 段长至少按斐波那契数增长，栈中的段数不会超过这个值
+        const std::size_t max_run_count = 85;
+
+        /**
+         * 自然段的最短长度：n / minrun恰好是或者略小于2的幂，最后的归并尽量平衡
+         */
+        inline std::ptrdiff_t min_run_length(std::ptrdiff_t n) {
+            std::ptrdiff_t low_bits = 0;
+            while (n >= min_merge) {
+                low_bits |= n & 1;
+                n >>= 1;
+            }
+            return n + low_bits;
+        }
+
+        /**
+         * @return 从first开始的自然段的长度；严格递减的段原地反转成递增的（严格递减才能保持稳定）
+         */
+        template<typename RandomIt, typename Compare>
+        std::ptrdiff_t count_run_and_make_ascending(RandomIt first, RandomIt last, Compare &comp) {
+            RandomIt run_end = first + 1;
+            if (run_end == last) {
+                return 1;
+            }
+            if (comp(*run_end, *first)) {
+                while (++run_end != last && comp(*run_end, *(run_end - 1))) {
+                }
+                Readable::reverse(first, run_end);
+            } else {
+                while (++run_end != last && !comp(*run_end, *(run_end - 1))) {
+                }
+            }
+            return run_end - first;
+        }
+
+        /**
+         * [first, sorted_end)已经有序，用二分查找把[sorted_end, last)中的元素逐个插入
+         * 比较次数是O(nlogn)，适合比较昂贵、段很短的情况
+         */
+        template<typename RandomIt, typename Compare>
+        void binary_insertion_sort(RandomIt first, RandomIt sorted_end, RandomIt last, Compare &comp) {
+            typedef typename iterator_traits<RandomIt>::value_type value_type;
+            for (RandomIt current = sorted_end; current != last; ++current) {
+                if (!comp(*current, *(current - 1))) {
+                    continue;
+                }
+                // 先找位置再移出元素，比较函数抛出异常时元素还在原位
+                RandomIt position = Readable::upper_bound(first, current, *current, comp);
+                value_type value = iter_move(current);
+                Readable::move_backward(position, current, current + 1);
+                *position = std::move(value);
+            }
+        }
+
+        /**
+         * galloping查找：从一端开始按1, 3, 7, 15, ...的步长跳，越过目标后在最后一步里二分
+         * 目标离起点k个位置时只需要O(logk)次比较，归并中一边连续胜出很多次时比逐个比较快得多
+         */
+        template<typename RandomIt, typename T, typename Compare>
+        RandomIt gallop_lower_bound(RandomIt first, RandomIt last, const T &value, Compare &comp) {
+            std::ptrdiff_t length = last - first;
+            std::ptrdiff_t skipped = 0;
+            std::ptrdiff_t offset = 1;
+            while (offset <= length && comp(*(first + (offset - 1)), value)) {
+                skipped = offset;
+                offset = offset * 2 + 1;
+            }
+            return Readable::lower_bound(first + skipped, first + (offset < length ? offset : length), value, comp);
+        }
+
+        template<typename RandomIt, typename T, typename Compare>
+        RandomIt gallop_upper_bound(RandomIt first, RandomIt last, const T &value, Compare &comp) {
+            std::ptrdiff_t length = last - first;
+            std::ptrdiff_t skipped = 0;
+            std::ptrdiff_t offset = 1;
+            while (offset <= length && !comp(value, *(first + (offset - 1)))) {
+                skipped = offset;
+                offset = offset * 2 + 1;
+            }
+            return Readable::upper_bound(first + skipped, first + (offset < length ? offset : length), value, comp);
+        }
+
+        /**
+         * 从末尾开始的galloping查找
+         */
+        template<typename RandomIt, typename T, typename Compare>
+        RandomIt gallop_lower_bound_from_back(RandomIt first, RandomIt last, const T &value, Compare &comp) {
+            std::ptrdiff_t length = last - first;
+            std::ptrdiff_t skipped = 0;
+            std::ptrdiff_t offset = 1;
+            while (offset <= length && !comp(*(last - offset), value)) {
+                skipped = offset;
+                offset = offset * 2 + 1;
+            }
+            return Readable::lower_bound(last - (offset < length ? offset : length), last - skipped, value, comp);
+        }
+
+        template<typename RandomIt, typename T, typename Compare>
+        RandomIt gallop_upper_bound_from_back(RandomIt first, RandomIt last, const T &value, Compare &comp) {
+            std::ptrdiff_t length = last - first;
+            std::ptrdiff_t skipped = 0;
+            std::ptrdiff_t offset = 1;
+            while (offset <= length && comp(value, *(last - offset))) {
+                skipped = offset;
+                offset = offset * 2 + 1;
+            }
+            return Readable::upper_bound(last - (offset < length ? offset : length), last - skipped, value, comp);
+        }
+
+        /**
+         * 自适应的稳定归并排序（timsort, Tim Peters 2002）
+         * 把输入切成自然段（已经有序或者严格递减的连续元素），太短的段用二分插入排序补到minrun，
+         * 段的长度保存在栈中，并始终满足 len[i - 2] > len[i - 1] + len[i]、len[i - 1] > len[i]，保证归并大致平衡
+         * 归并时先用galloping跳过两段首尾已经就位的元素，再把较短的一段移到辅助空间中归并，
+         * 一边连续胜出时切换到galloping模式成批移动
+         * 有序的输入只有一个段，O(n)；有序的数据后面追加少量元素时，只需要对追加的部分排序再做一次很不平衡的归并
+         * 辅助空间按需要增长，最多n / 2个元素；申请不到时在已有的辅助空间不够用的归并上改用旋转实现的原地归并
+         */
+        template<typename RandomIt, typename Compare, typename Allocator>
+        class timsort {
+        private:
+            typedef typename iterator_traits<RandomIt>::value_type value_type;
+
+            struct run {
+                RandomIt first;
+                std::ptrdiff_t length;
+            };
+
+            Compare &comp;
+            Allocator allocator;
+            // 辅助空间是未初始化的内存，只在一次归并的过程中构造元素
+            value_type *buffer;
+            std::size_t buffer_capacity;
+            std::size_t max_buffer_capacity;
+            std::ptrdiff_t min_gallop;
+            run runs[max_run_count];
+            std::size_t run_count;
+
+        public:
+            timsort(std::ptrdiff_t length, Compare &comp_, const Allocator &allocator_) :
+                    comp(comp_), allocator(allocator_), buffer(nullptr), buffer_capacity(0),
+                    max_buffer_capacity(static_cast<std::size_t>(length / 2)), min_gallop(initial_min_gallop),
+                    run_count(0) {}
+
+            timsort(const timsort &) = delete;
+
+            timsort &operator=(const timsort &) = delete;
+
+            ~timsort() {
+                if (buffer) {
+                    allocator.deallocate(buffer, buffer_capacity);
+                }
+            }
+
+            void sort(RandomIt first, RandomIt last) {
+                std::ptrdiff_t remaining = last - first;
+                if (remaining < min_merge) {
+                    std::ptrdiff_t run_length = count_run_and_make_ascending(first, last, comp);
+                    binary_insertion_sort(first, first + run_length, last, comp);
+                    return;
+                }
+                const std::ptrdiff_t min_run = min_run_length(remaining);
+                do {
+                    std::ptrdiff_t run_length = count_run_and_make_ascending(first, last, comp);
+                    if (run_length < min_run) {
+                        std::ptrdiff_t forced = remaining < min_run ? remaining : min_run;
+                        binary_insertion_sort(first, first + run_length, first + forced, comp);
+                        run_length = forced;
+                    }
+                    runs[run_count].first = first;
+                    runs[run_count].length = run_length;
+                    ++run_count;
+                    merge_collapse();
+                    first += run_length;
+                    remaining -= run_length;
+                } while (remaining != 0);
+                merge_force_collapse();
+            }
+
+        private:
+            /**
+             * 恢复栈顶几个段的长度约束
+             * 只检查栈顶三个段是不够的（de Gouw et al. 2015），还要检查第四个
+             */
+            void merge_collapse() {
+                while (run_count > 1) {
+                    std::size_t n = run_count - 2;
+                    if ((n > 0 && runs[n - 1].length <= runs[n].length + runs[n + 1].length) ||
+                        (n > 1 && runs[n - 2].length <= runs[n - 1].length + runs[n].length)) {
+                        if (runs[n - 1].length < runs[n + 1].length) {
+                            --n;
+                        }
+                    } else if (runs[n].length > runs[n + 1].length) {
+                        return;
+                    }
+                    merge_at(n);
+                }
+            }
+
+            void merge_force_collapse() {
+                while (run_count > 1) {
+                    std::size_t n = run_count - 2;
+                    if (n > 0 && runs[n - 1].length < runs[n + 1].length) {
+                        --n;
+                    }
+                    merge_at(n);
+                }
+            }
+
+            /**
+             * 归并栈中的第i和第i + 1个段
+             */
+            void merge_at(std::size_t i) {
+                RandomIt first = runs[i].first;
+                RandomIt middle = runs[i + 1].first;
+                RandomIt last = middle + runs[i + 1].length;
+                runs[i].length += runs[i + 1].length;
+                if (i + 3 == run_count) {
+                    runs[i + 1] = runs[i + 2];
+                }
+                --run_count;
+
+                // 第一段中不大于第二段首元素的前缀、第二段中不小于第一段尾元素的后缀已经在最终位置上
+                first = gallop_upper_bound(first, middle, *middle, comp);
+                if (first == middle) {
+                    return;
+                }
+                last = gallop_lower_bound_from_back(middle, last, *(middle - 1), comp);
+                if (middle == last) {
+                    return;
+                }
+                std::ptrdiff_t length1 = middle - first;
+                std::ptrdiff_t length2 = last - middle;
+                reserve_buffer(static_cast<std::size_t>(length1 < length2 ? length1 : length2));
+                merge_adaptive(first, middle, last, length1, length2);
+            }
+
+            /**
+             * 保证辅助空间至少能放下 @arg needed 个元素
+             * 按2的幂增长以减少重新申请的次数；申请失败时退而只申请needed个，仍然失败就保留原来的辅助空间
+             */
+            void reserve_buffer(std::size_t needed) {
+                if (needed <= buffer_capacity) {
+                    return;
+                }
+                std::size_t capacity = 1;
+                while (capacity < needed) {
+                    capacity <<= 1;
+                }
+                if (capacity > max_buffer_capacity) {
+                    capacity = max_buffer_capacity > needed ? max_buffer_capacity : needed;
+                }
+                value_type *new_buffer = nullptr;
+                try {
+                    new_buffer = allocator.allocate(capacity);
+                } catch (const std::bad_alloc &) {
+                    try {
+                        capacity = needed;
+                        new_buffer = allocator.allocate(capacity);
+                    } catch (const std::bad_alloc &) {
+                        return;
+                    }
+                }
+                if (buffer) {
+                    allocator.deallocate(buffer, buffer_capacity);
+                }
+                buffer = new_buffer;
+                buffer_capacity = capacity;
+            }
+
+            /**
+             * 较短的一段放得进辅助空间时直接归并；否则在较长的一段取中点、在另一段中二分出切分点，
+             * 旋转使两个切分点之间的元素互换位置，得到两个互不相干的更小的归并
+             * 没有辅助空间时每次归并O(nlogn)，整个排序O(nlog²n)
+             */
+            void merge_adaptive(RandomIt first, RandomIt middle, RandomIt last,
+                                std::ptrdiff_t length1, std::ptrdiff_t length2) {
+                while (length1 != 0 && length2 != 0) {
+                    const std::ptrdiff_t capacity = static_cast<std::ptrdiff_t>(buffer_capacity);
+                    if (length1 <= length2 && length1 <= capacity) {
+                        merge_low(first, middle, last);
+                        return;
+                    }
+                    if (length2 <= capacity) {
+                        merge_high(first, middle, last);
+                        return;
+                    }
+                    if (length1 + length2 == 2) {
+                        if (comp(*middle, *first)) {
+                            Readable::iter_swap(first, middle);
+                        }
+                        return;
+                    }
+                    RandomIt cut1, cut2;
+                    if (length1 > length2) {
+                        cut1 = first + length1 / 2;
+                        cut2 = Readable::lower_bound(middle, last, *cut1, comp);
+                    } else {
+                        cut2 = middle + length2 / 2;
+                        cut1 = Readable::upper_bound(first, middle, *cut2, comp);
+                    }
+                    RandomIt new_middle = Readable::rotate(cut1, middle, cut2);
+                    merge_adaptive(first, cut1, new_middle, cut1 - first, new_middle - cut1);
+                    first = new_middle;
+                    middle = cut2;
+                    length1 = cut2 - new_middle;
+                    length2 = last - cut2;
+                }
+            }
+
+            /**
+             * 把 @arg first 开始的 @arg length 个元素移动构造到辅助空间中
+             * 异常时把已经移出的元素移回原位
+             */
+            value_type *move_to_buffer(RandomIt first, std::ptrdiff_t length) {
+                value_type *buffer_end = buffer;
+                try {
+                    for (; buffer_end != buffer + length; ++buffer_end, ++first) {
+                        ::new(static_cast<void *>(buffer_end)) value_type(iter_move(first));
+                    }
+                } catch (...) {
+                    Readable::move_backward(buffer, buffer_end, first);
+                    Readable::destroy(buffer, buffer_end);
+                    throw;
+                }
+                return buffer_end;
+            }
+
+            /**
+             * 第一段较短：把它移到辅助空间，从前向后归并
+             * 输出位置和第二段当前位置之间的空位数总等于辅助空间中剩下的元素数，第一段用完时第二段剩下的元素已经就位
+             * 比较函数抛出异常时把辅助空间中剩下的元素移回这些空位，所有元素仍然都在序列中
+             */
+            void merge_low(RandomIt first, RandomIt middle, RandomIt last) {
+                value_type *buffer_end = move_to_buffer(first, middle - first);
+                value_type *cursor1 = buffer;
+                RandomIt cursor2 = middle;
+                RandomIt out = first;
+                try {
+                    while (cursor1 != buffer_end && cursor2 != last) {
+                        // 逐个比较，直到一边连续胜出min_gallop次
+                        std::ptrdiff_t count1 = 0;
+                        std::ptrdiff_t count2 = 0;
+                        while (cursor1 != buffer_end && cursor2 != last) {
+                            if (comp(*cursor2, *cursor1)) {
+                                *out = iter_move(cursor2);
+                                ++out;
+                                ++cursor2;
+                                count1 = 0;
+                                if (++count2 >= min_gallop) {
+                                    break;
+                                }
+                            } else {
+                                *out = std::move(*cursor1);
+                                ++out;
+                                ++cursor1;
+                                count2 = 0;
+                                if (++count1 >= min_gallop) {
+                                    break;
+                                }
+                            }
+                        }
+                        if (cursor1 == buffer_end || cursor2 == last) {
+                            break;
+                        }
+                        // galloping：成批移动一边中连续胜出的元素，直到两边都不再连续胜出很多次
+                        while (true) {
+                            value_type *run_end1 = gallop_upper_bound(cursor1, buffer_end, *cursor2, comp);
+                            count1 = run_end1 - cursor1;
+                            out = Readable::move(cursor1, run_end1, out);
+                            cursor1 = run_end1;
+                            if (cursor1 == buffer_end) {
+                                break;
+                            }
+                            RandomIt run_end2 = gallop_lower_bound(cursor2, last, *cursor1, comp);
+                            count2 = run_end2 - cursor2;
+                            out = Readable::move(cursor2, run_end2, out);
+                            cursor2 = run_end2;
+                            if (cursor2 == last) {
+                                break;
+                            }
+                            if (count1 < initial_min_gallop && count2 < initial_min_gallop) {
+                                min_gallop += 2;
+                                break;
+                            }
+                            if (min_gallop > 1) {
+                                --min_gallop;
+                            }
+                        }
+                    }
+                } catch (...) {
+                    Readable::move(cursor1, buffer_end, out);
+                    Readable::destroy(buffer, buffer_end);
+                    throw;
+                }
+                Readable::move(cursor1, buffer_end, out);
+                Readable::destroy(buffer, buffer_end);
+            }
+
+            /**
+             * 第二段较短：把它移到辅助空间，从后向前归并
+             */
+            void merge_high(RandomIt first, RandomIt middle, RandomIt last) {
+                value_type *buffer_end = move_to_buffer(middle, last - middle);
+                RandomIt cursor1 = middle;
+                value_type *cursor2 = buffer_end;
+                RandomIt out = last;
+                try {
+                    while (cursor1 != first && cursor2 != buffer) {
+                        std::ptrdiff_t count1 = 0;
+                        std::ptrdiff_t count2 = 0;
+                        while (cursor1 != first && cursor2 != buffer) {
+                            // 相等时第二段的元素在后面
+                            if (comp(*(cursor2 - 1), *(cursor1 - 1))) {
+                                --out;
+                                --cursor1;
+                                *out = iter_move(cursor1);
+                                count2 = 0;
+                                if (++count1 >= min_gallop) {
+                                    break;
+                                }
+                            } else {
+                                --out;
+                                --cursor2;
+                                *out = std::move(*cursor2);
+                                count1 = 0;
+                                if (++count2 >= min_gallop) {
+                                    break;
+                                }
+                            }
+                        }
+                        if (cursor1 == first || cursor2 == buffer) {
+                            break;
+                        }
+                        while (true) {
+                            RandomIt run_begin1 = gallop_upper_bound_from_back(first, cursor1, *(cursor2 - 1), comp);
+                            count1 = cursor1 - run_begin1;
+                            out = Readable::move_backward(run_begin1, cursor1, out);
+                            cursor1 = run_begin1;
+                            if (cursor1 == first) {
+                                break;
+                            }
+                            value_type *run_begin2 = gallop_lower_bound_from_back(buffer, cursor2, *(cursor1 - 1), comp);
+                            count2 = cursor2 - run_begin2;
+                            out = Readable::move_backward(run_begin2, cursor2, out);
+                            cursor2 = run_begin2;
+                            if (cursor2 == buffer) {
+                                break;
+                            }
+                            if (count1 < initial_min_gallop && count2 < initial_min_gallop) {
+                                min_gallop += 2;
+                                break;
+                            }
+                            if (min_gallop > 1) {
+                                --min_gallop;
+                            }
+                        }
+                    }
+                } catch (...) {
+                    Readable::move_backward(buffer, cursor2, out);
+                    Readable::destroy(buffer, buffer_end);
+                    throw;
+                }
+                Readable::move_backward(buffer, cursor2, out);
+                Readable::destroy(buffer, buffer_end);
+            }
+        };
+    }
+
+    /**
+     * 稳定排序，最坏O(nlogn)；有序、逆序、由少数几个有序段组成的输入接近O(n)
+     * 辅助空间由 @arg allocator 申请，按需要增长，最多n / 2个元素；申请失败时退化为原地归并，最坏O(nlog²n)
+     * 比较函数抛出异常时所有元素仍在序列中，顺序不确定
+     * @param comp 比较函数
+     * @param allocator 分配value_type的空间配置器，通常是容器的get_allocator()
+     */
+    template<typename RandomIt, typename Compare, typename Allocator>
+    void stable_sort(RandomIt first, RandomIt last, Compare comp, const Allocator &allocator) {
+        std::ptrdiff_t length = last - first;
+        if (length < 2) {
+            return;
+        }
+        stable_sort_detail::timsort<RandomIt, Compare, Allocator> sorter(length, comp, allocator);
+        sorter.sort(first, last);
+    }
+
+    template<typename RandomIt, typename Compare>
+    void stable_sort(RandomIt first, RandomIt last, Compare comp) {
+        Readable::stable_sort(first, last, comp, Readable::allocator<typename iterator_traits<RandomIt>::value_type>());
+    }
+
+    template<typename RandomIt>
+    void stable_sort(RandomIt first, RandomIt last) {
+        Readable::stable_sort(first, last, Readable::less<typename iterator_traits<RandomIt>::value_type>());
+    }
+}
+
+#endif //STL_FROM_SCRATCH_STABLE_SORT_H
@@ -0,0 +1,26 @@
+#ifndef STL_FROM_SCRATCH_ATOMIC_FORWARD_LIST_NODE_H
+#define STL_FROM_SCRATCH_ATOMIC_FORWARD_LIST_NODE_H
+
+#include <atomic>
+
+namespace Readable {
+    /**
+     * 无锁容器使用的单向链表节点基类
+     * 和forward_list_node_base一样只有一个next，但next是原子的：
+     * 一个线程改写next的同时，另一个线程可能正在沿着旧的链读它
+     */
+    struct atomic_forward_list_node_base {
+        std::atomic<atomic_forward_list_node_base *> next;
+
+        atomic_forward_list_node_base() noexcept : next(nullptr) {}
+
+        // 复制对象时不复制链接状态
+        atomic_forward_list_node_base(const atomic_forward_list_node_base &) noexcept : next(nullptr) {}
+
+        atomic_forward_list_node_base &operator=(const atomic_forward_list_node_base &) noexcept {
+            return *this;
+        }
+    };
+}
+
+#endif //STL_FROM_SCRATCH_ATOMIC_FORWARD_LIST_NODE_H
@@ -0,0 +1,15 @@
+#ifndef STL_FROM_SCRATCH_CACHE_LINE_H
+#define STL_FROM_SCRATCH_CACHE_LINE_H
+
+#include <cstddef>
+
+namespace Readable {
+    /**
+     * 缓存行的大小
+     * 多线程下被不同线程频繁写入的变量应该放在不同的缓存行中，否则会产生伪共享(false sharing)：
+     * 两个线程写的虽然是不同的变量，但由于它们在同一缓存行，缓存行会在两个核心之间来回传递
+     */
+    constexpr std::size_t cache_line_size = 64;
+}
+
+#endif //STL_FROM_SCRATCH_CACHE_LINE_H
@@ -0,0 +1,230 @@
+#ifndef STL_FROM_SCRATCH_MPMC_QUEUE_H
+#define STL_FROM_SCRATCH_MPMC_QUEUE_H
+
+#include <atomic>
+#include <cstddef>
+#include <thread>
+#include "./cache_line.h"
+#include "../containers/vector.h"
+
+namespace Readable {
+    /**
+     * 有界的多生产者多消费者无锁队列（Dmitry Vyukov的算法）
+     *
+     * 每个槽位带一个序号sequence，用来表示这个槽位现在"轮到谁"：
+     * - sequence == pos 时，槽位空闲，逻辑下标为pos的生产者可以写入
+     * - sequence == pos + 1 时，槽位已写入，逻辑下标为pos的消费者可以读出
+     * - 读出后sequence被设为pos + capacity，即下一圈的生产者可以写入
+     * 生产者（消费者）之间只在enqueue_pos（dequeue_pos）上用CAS竞争一次，
+     * 抢到下标后对槽位的读写不会和其他线程冲突，因此在高竞争下也不会退化成自旋锁
+     * @tparam T 队列中的元素类型
+     */
+    template<typename T>
+    class mpmc_queue final {
+    public:
+        typedef T value_type;
+        typedef std::size_t size_type;
+    private:
+        struct cell {
+            std::atomic<size_type> sequence;
+            // 生产者抢到槽位后构造元素失败时，槽位中没有元素，消费者需要跳过它
+            bool occupied;
+            alignas(T) unsigned char storage[sizeof(T)];
+
+            cell() : sequence(0), occupied(false) {}
+
+            // vector要求元素可以复制，复制时只复制序号，storage中没有对象
+            cell(const cell &other) : sequence(other.sequence.load(std::memory_order_relaxed)), occupied(false) {}
+
+            T *value() {
+                return reinterpret_cast<T *>(storage);
+            }
+        };
+
+        // 两个线程都只读的部分
+        Readable::vector<cell> cells;
+        size_type mask;
+
+        // 生产者写enqueue_pos，消费者写dequeue_pos，用填充把它们隔开到不同的缓存行中
+        // 不用alignas的原因见work_stealing_deque
+        char padding_before_enqueue[cache_line_size];
+        std::atomic<size_type> enqueue_pos;
+        char padding_after_enqueue[cache_line_size - sizeof(std::atomic<size_type>)];
+        std::atomic<size_type> dequeue_pos;
+        char padding_after_dequeue[cache_line_size - sizeof(std::atomic<size_type>)];
+
+        static size_type round_up_to_power_of_two(size_type n) {
+            size_type result = 1;
+            while (result < n) {
+                result <<= 1;
+            }
+            return result;
+        }
+
+        /**
+         * 自旋等待时的退让：先空转几次，再让出时间片
+         */
+        static void backoff(unsigned &spin_count) {
+            if (++spin_count < 64) {
+                return;
+            }
+            std::this_thread::yield();
+        }
+
+    public:
+        /**
+         * 构造容量至少为 @arg capacity_want 的队列
+         * @param capacity_want 期望的容量，实际容量会向上取整到2的幂（至少为2）
+         */
+        explicit mpmc_queue(size_type capacity_want) :
+                cells(round_up_to_power_of_two(capacity_want < 2 ? 2 : capacity_want), cell()),
+                mask(cells.size() - 1), enqueue_pos(0), dequeue_pos(0) {
+            for (size_type i = 0; i < cells.size(); ++i) {
+                cells[i].sequence.store(i, std::memory_order_relaxed);
+            }
+        }
+
+        mpmc_queue(const mpmc_queue &) = delete;
+
+        mpmc_queue &operator=(const mpmc_queue &) = delete;
+
+        ~mpmc_queue() {
+            size_type tail = enqueue_pos.load(std::memory_order_relaxed);
+            for (size_type pos = dequeue_pos.load(std::memory_order_relaxed); pos != tail; ++pos) {
+                cell &target = cells[pos & mask];
+                if (target.occupied) {
+                    Readable::destroy(target.value());
+                }
+            }
+        }
+
+        size_type capacity() const noexcept {
+            return mask + 1;
+        }
+
+        /**
+         * 队列中元素的个数
+         * @note 其他线程同时在操作时，这只是一个近似值
+         */
+        size_type size_approx() const noexcept {
+            size_type tail = enqueue_pos.load(std::memory_order_relaxed);
+            size_type head = dequeue_pos.load(std::memory_order_relaxed);
+            return tail > head ? tail - head : 0;
+        }
+
+        /**
+         * 尝试在队尾构造一个元素，队列满时立即返回false
+         */
+        template<typename... Args>
+        bool try_emplace(Args &&... args) {
+            size_type pos = enqueue_pos.load(std::memory_order_relaxed);
+            cell *target;
+            for (;;) {
+                target = &cells[pos & mask];
+                size_type sequence = target->sequence.load(std::memory_order_acquire);
+                auto diff = static_cast<std::ptrdiff_t>(sequence - pos);
+                if (diff == 0) {
+                    // 槽位空闲，抢占这个下标
+                    if (enqueue_pos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                        break;
+                    }
+                    // CAS失败时pos已被更新为最新值，重试即可
+                } else if (diff < 0) {
+                    // 槽位中还是上一圈没被读走的元素：队列已满
+                    return false;
+                } else {
+                    // 被别的生产者抢先了
+                    pos = enqueue_pos.load(std::memory_order_relaxed);
+                }
+            }
+            try {
+                ::new(static_cast<void *>(target->value())) T(std::forward<Args>(args)...);
+            } catch (...) {
+                // 下标已经抢到，无法退回，只能把槽位标记为空洞交给消费者跳过
+                target->occupied = false;
+                target->sequence.store(pos + 1, std::memory_order_release);
+                throw;
+            }
+            target->occupied = true;
+            target->sequence.store(pos + 1, std::memory_order_release);
+            return true;
+        }
+
+        bool try_push(const T &value) {
+            return try_emplace(value);
+        }
+
+        bool try_push(T &&value) {
+            return try_emplace(std::move(value));
+        }
+
+        /**
+         * 尝试从队头取出一个元素，队列空时立即返回false
+         */
+        bool try_pop(T &out) {
+            size_type pos = dequeue_pos.load(std::memory_order_relaxed);
+            cell *target;
+            for (;;) {
+                target = &cells[pos & mask];
+                size_type sequence = target->sequence.load(std::memory_order_acquire);
+                auto diff = static_cast<std::ptrdiff_t>(sequence - (pos + 1));
+                if (diff == 0) {
+                    if (dequeue_pos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                        if (target->occupied) {
+                            break;
+                        }
+                        // 空洞：直接交给下一圈的生产者，然后继续找下一个元素
+                        target->sequence.store(pos + mask + 1, std::memory_order_release);
+                        pos = dequeue_pos.load(std::memory_order_relaxed);
+                    }
+                } else if (diff < 0) {
+                    // 槽位还没有被写入：队列为空
+                    return false;
+                } else {
+                    pos = dequeue_pos.load(std::memory_order_relaxed);
+                }
+            }
+            T *value = target->value();
+            try {
+                out = std::move(*value);
+            } catch (...) {
+                Readable::destroy(value);
+                target->sequence.store(pos + mask + 1, std::memory_order_release);
+                throw;
+            }
+            Readable::destroy(value);
+            // 交给下一圈的生产者
+            target->sequence.store(pos + mask + 1, std::memory_order_release);
+            return true;
+        }
+
+        /**
+         * 阻塞地写入：队列满时等待直到写入成功
+         */
+        void push(const T &value) {
+            unsigned spin_count = 0;
+            while (!try_push(value)) {
+                backoff(spin_count);
+            }
+        }
+
+        void push(T &&value) {
+            unsigned spin_count = 0;
+            while (!try_emplace(std::move(value))) {
+                backoff(spin_count);
+            }
+        }
+
+        /**
+         * 阻塞地读出：队列空时等待直到读出成功
+         */
+        void pop(T &out) {
+            unsigned spin_count = 0;
+            while (!try_pop(out)) {
+                backoff(spin_count);
+            }
+        }
+    };
+}
+
+#endif //STL_FROM_SCRATCH_MPMC_QUEUE_H
@@ -0,0 +1,153 @@
+#ifndef STL_FROM_SCRATCH_MPSC_QUEUE_H
+#define STL_FROM_SCRATCH_MPSC_QUEUE_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include "./cache_line.h"
+#include "./atomic_forward_list_node.h"
+#include "../memory/memory.h"
+
+namespace Readable {
+    /**
+     * 侵入式的多生产者单消费者无界队列（Dmitry Vyukov的算法），适合多个线程向一个事件循环投递事件
+     * 元素继承atomic_forward_list_node_base，队列本身不分配内存
+     *
+     * 实现要点：
+     * 1. 队列是一条从tail（最早的元素）指向head（最新的元素）的单向链表，链表中始终至少有一个节点，
+     *    空队列时这个节点是队列自带的stub
+     * 2. 生产者只做一次exchange：把head换成新节点，再把旧head的next指向新节点，没有循环，是wait-free的
+     * 3. 消费者只沿next前进，只有在队列里只剩一个节点时才需要读head
+     *
+     * 生产者在exchange和写next之间被挂起时，链表暂时是断开的：
+     * 此时消费者看不到这个元素以及之后投递的元素，try_pop返回nullptr，稍后重试即可
+     *
+     * 元素被弹出后队列不再访问它，可以立即释放或者重新投递
+     * @tparam T 元素类型，必须继承atomic_forward_list_node_base
+     */
+    template<typename T>
+    class intrusive_mpsc_queue final {
+    public:
+        typedef T value_type;
+        typedef std::size_t size_type;
+    private:
+        typedef atomic_forward_list_node_base node_base;
+
+        // 生产者争抢head，消费者独占tail，分在不同的缓存行中
+        // 不用alignas的原因见work_stealing_deque
+        char padding_before_head[cache_line_size];
+        std::atomic<node_base *> head;
+        char padding_after_head[cache_line_size - sizeof(std::atomic<node_base *>)];
+        node_base *tail;
+        node_base stub;
+        char padding_after_tail[cache_line_size - sizeof(node_base *) - sizeof(node_base)];
+
+        static node_base *to_node(T &value) {
+            return static_cast<node_base *>(Readable::addressof(value));
+        }
+
+        /**
+         * 把已经用next链好的[first, last]接到队尾
+         */
+        void link_chain(node_base *first, node_base *last) noexcept {
+            last->next.store(nullptr, std::memory_order_relaxed);
+            node_base *previous = head.exchange(last, std::memory_order_acq_rel);
+            // 从这里到下一行之间，链表在previous处是断开的
+            previous->next.store(first, std::memory_order_release);
+        }
+
+    public:
+        intrusive_mpsc_queue() noexcept : head(&stub), tail(&stub), stub() {}
+
+        intrusive_mpsc_queue(const intrusive_mpsc_queue &) = delete;
+
+        intrusive_mpsc_queue &operator=(const intrusive_mpsc_queue &) = delete;
+
+        /**
+         * 投递一个元素，任意线程都可以调用
+         */
+        void push(T &value) noexcept {
+            node_base *the_node = to_node(value);
+            link_chain(the_node, the_node);
+        }
+
+        /**
+         * 一次投递一串已经用next链好的元素（从 @arg first 到 @arg last），只需要一次exchange
+         * 这一串元素在队列中保持原来的顺序，且不会和其他线程投递的元素交错
+         */
+        void push_chain(T &first, T &last) noexcept {
+            link_chain(to_node(first), to_node(last));
+        }
+
+        /**
+         * 把 @arg value 的next设为 @arg next_value，用于在push_chain之前把元素链起来
+         */
+        static void link(T &value, T &next_value) noexcept {
+            to_node(value)->next.store(to_node(next_value), std::memory_order_relaxed);
+        }
+
+        /**
+         * 取出最早投递的元素，只能由消费者线程调用
+         * @return 取出的元素；队列为空，或者下一个元素的生产者还没有写完链接时返回nullptr
+         */
+        T *try_pop() noexcept {
+            node_base *first = tail;
+            node_base *next = first->next.load(std::memory_order_acquire);
+            if (first == &stub) {
+                if (!next) {
+                    return nullptr;
+                }
+                // 跳过stub
+                tail = next;
+                first = next;
+                next = next->next.load(std::memory_order_acquire);
+            }
+            if (next) {
+                tail = next;
+                return static_cast<T *>(first);
+            }
+            // first是链表中最后一个可见的节点，它后面可能还有生产者没写完的链接
+            if (first != head.load(std::memory_order_acquire)) {
+                return nullptr;
+            }
+            // first确实是最后一个节点：把stub放到它后面，这样first就可以取出了
+            link_chain(&stub, &stub);
+            next = first->next.load(std::memory_order_acquire);
+            if (next) {
+                tail = next;
+                return static_cast<T *>(first);
+            }
+            // stub之前又插进来一个还没写完链接的元素
+            return nullptr;
+        }
+
+        /**
+         * 依次取出至多 @arg max_count 个元素，对每个元素调用 @arg f ，只能由消费者线程调用
+         * f可以释放或者重新投递传给它的元素
+         * @return 取出的元素个数
+         */
+        template<typename UnaryFunction>
+        size_type drain(UnaryFunction f, size_type max_count = SIZE_MAX) {
+            size_type count = 0;
+            while (count < max_count) {
+                T *value = try_pop();
+                if (!value) {
+                    break;
+                }
+                ++count;
+                f(*value);
+            }
+            return count;
+        }
+
+        /**
+         * 队列是否为空，只应由消费者线程调用
+         * @note 还没有写完链接的元素看不到
+         */
+        bool empty() const noexcept {
+            return tail == &stub && stub.next.load(std::memory_order_acquire) == nullptr;
+        }
+    };
+}
+
+#endif //STL_FROM_SCRATCH_MPSC_QUEUE_H
@@ -0,0 +1,210 @@
+#ifndef STL_FROM_SCRATCH_SPSC_QUEUE_H
+#define STL_FROM_SCRATCH_SPSC_QUEUE_H
+
+#include <atomic>
+#include <cstddef>
+#include "./cache_line.h"
+#include "../memory/memory.h"
+#include "../type_traits/type_traits.h"
+
+namespace Readable {
+    /**
+     * 有界的单生产者单消费者无锁队列
+     * 只允许一个线程调用try_push*，一个线程调用try_pop*
+     *
+     * 实现要点：
+     * 1. 底层是容量为2的幂的环形数组，head和tail是一直递增的逻辑下标，用mask映射到数组中
+     * 2. tail只由生产者写，head只由消费者写，二者放在不同的缓存行中以避免伪共享
+     * 3. 生产者缓存一份head（cached_head），只有在看上去已满时才重新读取真正的head；
+     *    消费者同理缓存tail。这样大部分操作都不需要读取对方正在写的缓存行
+     * @tparam T 队列中的元素类型
+     * @tparam Allocator 空间分配器
+     */
+    template<typename T, typename Allocator = Readable::allocator<T> >
+    class spsc_queue final {
+    public:
+        typedef T value_type;
+        typedef Allocator allocator_type;
+
+        static_assert((Readable::is_same<typename allocator_type::value_type, value_type>::value),
+                      "Allocator::value_type must be same type as value_type");
+
+        typedef std::size_t size_type;
+        typedef value_type &reference;
+        typedef const value_type &const_reference;
+        typedef typename Allocator::pointer pointer;
+    private:
+        // 两个线程都只读的部分
+        pointer buffer;
+        size_type mask;
+
+        // 生产者和消费者各自的两个变量用填充隔开到不同的缓存行中，不用alignas的原因见work_stealing_deque
+        // 对象不一定从缓存行的开头开始，每组前后都留出整整一个缓存行，才能保证不和别的变量共享缓存行
+        char padding_before_tail[cache_line_size];
+
+        // 生产者独占
+        std::atomic<size_type> tail;
+        size_type cached_head;
+        char padding_after_tail[cache_line_size];
+
+        // 消费者独占
+        std::atomic<size_type> head;
+        size_type cached_tail;
+
+        // 防止紧跟在队列后面的对象和消费者的缓存行共享
+        char padding_after_head[cache_line_size];
+
+        static size_type round_up_to_power_of_two(size_type n) {
+            size_type result = 1;
+            while (result < n) {
+                result <<= 1;
+            }
+            return result;
+        }
+
+        /**
+         * 生产者：获得可以写入的空位数量，最多返回 @arg want
+         */
+        size_type free_slots(size_type now_tail, size_type want) {
+            size_type free_count = capacity() - (now_tail - cached_head);
+            if (free_count < want) {
+                // 看上去空间不够，重新读取真正的head
+                cached_head = head.load(std::memory_order_acquire);
+                free_count = capacity() - (now_tail - cached_head);
+            }
+            return free_count < want ? free_count : want;
+        }
+
+        /**
+         * 消费者：获得可以读出的元素数量，最多返回 @arg want
+         */
+        size_type ready_slots(size_type now_head, size_type want) {
+            size_type ready_count = cached_tail - now_head;
+            if (ready_count < want) {
+                cached_tail = tail.load(std::memory_order_acquire);
+                ready_count = cached_tail - now_head;
+            }
+            return ready_count < want ? ready_count : want;
+        }
+
+    public:
+        /**
+         * 构造容量至少为 @arg capacity_want 的队列
+         * @param capacity_want 期望的容量，实际容量会向上取整到2的幂
+         */
+        explicit spsc_queue(size_type capacity_want) :
+                buffer(nullptr), mask(round_up_to_power_of_two(capacity_want) - 1),
+                tail(0), cached_head(0), head(0), cached_tail(0) {
+            buffer = allocator_type::allocate(mask + 1);
+        }
+
+        spsc_queue(const spsc_queue &) = delete;
+
+        spsc_queue &operator=(const spsc_queue &) = delete;
+
+        ~spsc_queue() {
+            size_type now_tail = tail.load(std::memory_order_relaxed);
+            for (size_type i = head.load(std::memory_order_relaxed); i != now_tail; ++i) {
+                Readable::destroy(buffer + (i & mask));
+            }
+            allocator_type::deallocate(buffer, capacity());
+        }
+
+        size_type capacity() const noexcept {
+            return mask + 1;
+        }
+
+        /**
+         * 队列中元素的个数
+         * @note 其他线程同时在操作时，这只是一个近似值
+         */
+        size_type size_approx() const noexcept {
+            return tail.load(std::memory_order_acquire) - head.load(std::memory_order_acquire);
+        }
+
+        bool empty_approx() const noexcept {
+            return size_approx() == 0;
+        }
+
+        // 生产者接口
+        template<typename... Args>
+        bool try_emplace(Args &&... args) {
+            size_type now_tail = tail.load(std::memory_order_relaxed);
+            if (free_slots(now_tail, 1) == 0) {
+                return false;
+            }
+            allocator_type::construct(buffer + (now_tail & mask), std::forward<Args>(args)...);
+            tail.store(now_tail + 1, std::memory_order_release);
+            return true;
+        }
+
+        bool try_push(const T &value) {
+            return try_emplace(value);
+        }
+
+        bool try_push(T &&value) {
+            return try_emplace(std::move(value));
+        }
+
+        /**
+         * 批量写入：从 @arg first 开始最多写入 @arg n 个元素
+         * 整批元素只需要一次release写，消费者看到的也是整批
+         * @return 实际写入的元素个数
+         */
+        template<typename InputIt>
+        size_type try_push_n(InputIt first, size_type n) {
+            size_type now_tail = tail.load(std::memory_order_relaxed);
+            size_type count = free_slots(now_tail, n);
+            size_type i = 0;
+            try {
+                for (; i < count; ++i, ++first) {
+                    allocator_type::construct(buffer + ((now_tail + i) & mask), *first);
+                }
+            } catch (...) {
+                // 已经构造好的部分照常提交
+                tail.store(now_tail + i, std::memory_order_release);
+                throw;
+            }
+            tail.store(now_tail + count, std::memory_order_release);
+            return count;
+        }
+
+        // 消费者接口
+        bool try_pop(T &out) {
+            size_type now_head = head.load(std::memory_order_relaxed);
+            if (ready_slots(now_head, 1) == 0) {
+                return false;
+            }
+            pointer slot = buffer + (now_head & mask);
+            out = std::move(*slot);
+            Readable::destroy(slot);
+            head.store(now_head + 1, std::memory_order_release);
+            return true;
+        }
+
+        /**
+         * 批量读出：最多读出 @arg n 个元素写入 @arg d_first
+         * @return 实际读出的元素个数
+         */
+        template<typename OutputIt>
+        size_type try_pop_n(OutputIt d_first, size_type n) {
+            size_type now_head = head.load(std::memory_order_relaxed);
+            size_type count = ready_slots(now_head, n);
+            size_type i = 0;
+            try {
+                for (; i < count; ++i, ++d_first) {
+                    pointer slot = buffer + ((now_head + i) & mask);
+                    *d_first = std::move(*slot);
+                    Readable::destroy(slot);
+                }
+            } catch (...) {
+                head.store(now_head + i, std::memory_order_release);
+                throw;
+            }
+            head.store(now_head + count, std::memory_order_release);
+            return count;
+        }
+    };
+}
+
+#endif //STL_FROM_SCRATCH_SPSC_QUEUE_H
@@ -0,0 +1,306 @@
+#ifndef STL_FROM_SCRATCH_THREAD_POOL_H
+#define STL_FROM_SCRATCH_THREAD_POOL_H
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include "./work_stealing_deque.h"
+#include "./mpmc_queue.h"
+#include "../containers/vector.h"
+
+namespace Readable {
+    class work_stealing_pool;
+
+    /**
+     * 一组可以一起等待的任务（fork/join中的join点）
+     * 通过work_stealing_pool::spawn加入任务，通过work_stealing_pool::sync等待它们全部完成
+     */
+    class task_group final {
+    public:
+        task_group() : pending(0), first_exception(), exception_flag(false) {}
+
+        task_group(const task_group &) = delete;
+
+        task_group &operator=(const task_group &) = delete;
+
+    private:
+        friend class work_stealing_pool;
+
+        std::atomic<std::size_t> pending;
+        // 任务中抛出的第一个异常，在sync时重新抛出
+        std::exception_ptr first_exception;
+        std::atomic<bool> exception_flag;
+
+        void record_exception(std::exception_ptr e) {
+            bool expected = false;
+            if (exception_flag.compare_exchange_strong(expected, true)) {
+                first_exception = e;
+            }
+        }
+    };
+
+    /**
+     * 工作窃取线程池
+     *
+     * 每个工作线程有一个自己的work_stealing_deque：
+     * - 在工作线程里spawn的任务放进自己的队列底部，自己也从底部取（后进先出，刚产生的数据还在缓存里）
+     * - 自己的队列空了就随机挑一个其他线程，从它的队列顶部偷（偷到的往往是递归中更靠上、更大的任务）
+     * - 非工作线程spawn的任务放进一个公共的mpmc_queue
+     * 找不到任务的线程会在条件变量上休眠，有新任务时再被唤醒
+     *
+     * sync等待时不会阻塞，而是一边等一边执行其他任务，因此递归地spawn/sync不会把线程池卡死
+     */
+    class work_stealing_pool final {
+    private:
+        struct task_base {
+            task_group *group;
+
+            explicit task_base(task_group *g) : group(g) {}
+
+            virtual ~task_base() = default;
+
+            virtual void run() = 0;
+        };
+
+        template<typename Function>
+        struct task : task_base {
+            Function function;
+
+            task(task_group *g, Function &&f) : task_base(g), function(std::move(f)) {}
+
+            task(task_group *g, const Function &f) : task_base(g), function(f) {}
+
+            void run() override {
+                function();
+            }
+        };
+
+        struct worker {
+            work_stealing_deque<task_base *> deque;
+            // 挑选窃取对象时用的随机数状态（xorshift）
+            std::uint64_t random_state;
+
+            explicit worker(std::uint64_t seed) : deque(), random_state(seed) {}
+        };
+
+        // 当前线程是哪个线程池的第几个工作线程
+        struct worker_identity {
+            const work_stealing_pool *pool;
+            std::size_t index;
+        };
+
+        static worker_identity &current_identity() {
+            static thread_local worker_identity identity = {nullptr, 0};
+            return identity;
+        }
+
+        Readable::vector<worker *> workers;
+        Readable::vector<std::thread> threads;
+        mpmc_queue<task_base *> injection_queue;
+
+        std::atomic<bool> stopping;
+        // 每放入一个任务就加一，休眠前后比较它来避免丢失唤醒
+        std::atomic<std::uint64_t> epoch;
+        std::atomic<std::size_t> sleeping;
+        std::mutex sleep_mutex;
+        std::condition_variable sleep_condition;
+
+        static std::uint64_t next_random(std::uint64_t &state) {
+            state ^= state << 13;
+            state ^= state >> 7;
+            state ^= state << 17;
+            return state;
+        }
+
+        /**
+         * 当前线程在本线程池中的下标，不是本线程池的工作线程时返回workers.size()
+         */
+        std::size_t current_index() const {
+            const worker_identity &identity = current_identity();
+            return identity.pool == this ? identity.index : workers.size();
+        }
+
+        /**
+         * 依次尝试：自己的队列、随机窃取其他线程、公共队列
+         */
+        task_base *find_task(std::size_t self) {
+            task_base *found = nullptr;
+            if (self < workers.size() && workers[self]->deque.pop(found)) {
+                return found;
+            }
+            std::size_t worker_count = workers.size();
+            if (worker_count > 0) {
+                std::uint64_t seed_storage = reinterpret_cast<std::uintptr_t>(&found) ^
+                                             epoch.load(std::memory_order_relaxed);
+                std::uint64_t &state = self < worker_count ? workers[self]->random_state : seed_storage;
+                if (state == 0) {
+                    state = 0x9e3779b97f4a7c15ULL;
+                }
+                std::size_t start = static_cast<std::size_t>(next_random(state) % worker_count);
+                for (std::size_t i = 0; i < worker_count; ++i) {
+                    std::size_t victim = (start + i) % worker_count;
+                    if (victim != self && workers[victim]->deque.steal(found)) {
+                        return found;
+                    }
+                }
+            }
+            if (injection_queue.try_pop(found)) {
+                return found;
+            }
+            return nullptr;
+        }
+
+        static void execute(task_base *the_task) {
+            task_group *group = the_task->group;
+            try {
+                the_task->run();
+            } catch (...) {
+                group->record_exception(std::current_exception());
+            }
+            delete the_task;
+            group->pending.fetch_sub(1, std::memory_order_acq_rel);
+        }
+
+        void wake_one() {
+            epoch.fetch_add(1, std::memory_order_seq_cst);
+            if (sleeping.load(std::memory_order_seq_cst) > 0) {
+                std::lock_guard<std::mutex> lock(sleep_mutex);
+                sleep_condition.notify_one();
+            }
+        }
+
+        void worker_loop(std::size_t index) {
+            current_identity().pool = this;
+            current_identity().index = index;
+            unsigned idle_rounds = 0;
+            for (;;) {
+                std::uint64_t seen_epoch = epoch.load(std::memory_order_seq_cst);
+                task_base *the_task = find_task(index);
+                if (the_task) {
+                    execute(the_task);
+                    idle_rounds = 0;
+                    continue;
+                }
+                if (stopping.load(std::memory_order_acquire)) {
+                    return;
+                }
+                if (++idle_rounds < 64) {
+                    std::this_thread::yield();
+                    continue;
+                }
+                // 一段时间都没有找到任务，休眠到有新任务为止
+                std::unique_lock<std::mutex> lock(sleep_mutex);
+                sleeping.fetch_add(1, std::memory_order_seq_cst);
+                while (epoch.load(std::memory_order_seq_cst) == seen_epoch &&
+                       !stopping.load(std::memory_order_acquire)) {
+                    sleep_condition.wait(lock);
+                }
+                sleeping.fetch_sub(1, std::memory_order_seq_cst);
+                idle_rounds = 0;
+            }
+        }
+
+        void push_task(task_base *the_task) {
+            std::size_t self = current_index();
+            if (self < workers.size()) {
+                workers[self]->deque.push(the_task);
+            } else {
+                injection_queue.push(the_task);
+            }
+            wake_one();
+        }
+
+    public:
+        /**
+         * 创建有 @arg thread_count 个工作线程的线程池
+         * @param thread_count 工作线程数，为0时使用硬件线程数
+         */
+        explicit work_stealing_pool(std::size_t thread_count = 0) :
+                workers(), threads(), injection_queue(1024), stopping(false), epoch(0), sleeping(0) {
+            if (thread_count == 0) {
+                thread_count = std::thread::hardware_concurrency();
+                if (thread_count == 0) {
+                    thread_count = 1;
+                }
+            }
+            for (std::size_t i = 0; i < thread_count; ++i) {
+                workers.push_back(new worker(0x9e3779b97f4a7c15ULL * (i + 1)));
+            }
+            for (std::size_t i = 0; i < thread_count; ++i) {
+                threads.push_back(std::thread(&work_stealing_pool::worker_loop, this, i));
+            }
+        }
+
+        work_stealing_pool(const work_stealing_pool &) = delete;
+
+        work_stealing_pool &operator=(const work_stealing_pool &) = delete;
+
+        /**
+         * 等待所有已经放入的任务执行完毕后停止所有工作线程
+         */
+        ~work_stealing_pool() {
+            {
+                std::lock_guard<std::mutex> lock(sleep_mutex);
+                stopping.store(true, std::memory_order_release);
+            }
+            sleep_condition.notify_all();
+            for (auto &thread: threads) {
+                thread.join();
+            }
+            for (auto the_worker: workers) {
+                delete the_worker;
+            }
+        }
+
+        std::size_t thread_count() const noexcept {
+            return workers.size();
+        }
+
+        /**
+         * 异步执行 @arg f，它属于任务组 @arg group
+         * @note 在sync(group)返回前，f及它引用的数据都必须保持有效
+         */
+        template<typename Function>
+        void spawn(task_group &group, Function &&f) {
+            typedef typename std::decay<Function>::type function_type;
+            group.pending.fetch_add(1, std::memory_order_relaxed);
+            task_base *the_task;
+            try {
+                the_task = new task<function_type>(&group, std::forward<Function>(f));
+            } catch (...) {
+                group.pending.fetch_sub(1, std::memory_order_relaxed);
+                throw;
+            }
+            push_task(the_task);
+        }
+
+        /**
+         * 等待 @arg group 中的所有任务完成，等待期间当前线程会帮忙执行其他任务
+         * 如果有任务抛出了异常，重新抛出其中第一个
+         */
+        void sync(task_group &group) {
+            std::size_t self = current_index();
+            while (group.pending.load(std::memory_order_acquire) != 0) {
+                task_base *the_task = find_task(self);
+                if (the_task) {
+                    execute(the_task);
+                } else {
+                    std::this_thread::yield();
+                }
+            }
+            if (group.exception_flag.load(std::memory_order_acquire)) {
+                std::exception_ptr e = group.first_exception;
+                group.first_exception = nullptr;
+                group.exception_flag.store(false, std::memory_order_relaxed);
+                std::rethrow_exception(e);
+            }
+        }
+    };
+}
+
+#endif //STL_FROM_SCRATCH_THREAD_POOL_H
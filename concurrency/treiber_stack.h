@@ -0,0 +1,392 @@
+#ifndef STL_FROM_SCRATCH_TREIBER_STACK_H
+#define STL_FROM_SCRATCH_TREIBER_STACK_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include "./cache_line.h"
+#include "./atomic_forward_list_node.h"
+#include "../memory/memory.h"
+#include "../type_traits/type_traits.h"
+
+namespace Readable {
+    namespace treiber_stack_detail {
+        /**
+         * 带版本号的指针，打包在一个64位整数里，用普通的64位CAS就能原子地修改
+         * 64位平台上用户态地址只用到低48位，高16位放版本号；32位平台上指针和版本号各占32位
+         *
+         * 栈顶每被修改一次版本号就加一，用来解决ABA问题：
+         * 线程1读到栈顶A、A->next为B，正准备CAS时被挂起；其他线程弹出A、B，再压回A。
+         * 只比较指针时线程1的CAS会成功，把已经不在栈中的B设为栈顶；带上版本号后CAS会失败
+         * 版本号只有16位，线程1挂起期间栈顶恰好被修改了65536的整数倍次、且回到同一个节点时才会出错
+         */
+        struct tagged_pointer {
+            static const unsigned pointer_bits = sizeof(void *) == 8 ? 48 : 32;
+            static const std::uint64_t pointer_mask = (static_cast<std::uint64_t>(1) << pointer_bits) - 1;
+
+            static std::uint64_t pack(atomic_forward_list_node_base *node, std::uint64_t tag) {
+                return (static_cast<std::uint64_t>(reinterpret_cast<std::uintptr_t>(node)) & pointer_mask) |
+                       (tag << pointer_bits);
+            }
+
+            static atomic_forward_list_node_base *pointer(std::uint64_t value) {
+                return reinterpret_cast<atomic_forward_list_node_base *>(static_cast<std::uintptr_t>(value & pointer_mask));
+            }
+
+            static std::uint64_t tag(std::uint64_t value) {
+                return value >> pointer_bits;
+            }
+        };
+    }
+
+    /**
+     * 侵入式的无锁栈（Treiber栈），适合在线程之间共享空闲对象链
+     * 元素继承atomic_forward_list_node_base，栈本身不分配内存，压入、弹出都只是一次对栈顶的CAS
+     *
+     * 弹出时要先读出栈顶元素的next再CAS，读的时候这个元素可能已经被别的线程弹出了，
+     * 因此只要还有线程可能在操作这个栈，弹出的元素就不能被释放（放回对象池、留着复用都可以）：
+     * 这样读到的next最多是过期的，对应的CAS会因为版本号不同而失败
+     * @tparam T 元素类型，必须继承atomic_forward_list_node_base
+     */
+    template<typename T>
+    class intrusive_treiber_stack final {
+    public:
+        typedef T value_type;
+        typedef std::size_t size_type;
+    private:
+        typedef treiber_stack_detail::tagged_pointer tagged_pointer;
+
+        // 栈顶是所有线程争抢的对象，单独占一个缓存行
+        // 不用alignas的原因见work_stealing_deque
+        char padding_before_head[cache_line_size];
+        std::atomic<std::uint64_t> head;
+        char padding_after_head[cache_line_size - sizeof(std::atomic<std::uint64_t>)];
+
+        static atomic_forward_list_node_base *to_node(T &value) {
+            return static_cast<atomic_forward_list_node_base *>(Readable::addressof(value));
+        }
+
+        static T *to_value(atomic_forward_list_node_base *node) {
+            return static_cast<T *>(node);
+        }
+
+    public:
+        intrusive_treiber_stack() noexcept : head(tagged_pointer::pack(nullptr, 0)) {}
+
+        intrusive_treiber_stack(const intrusive_treiber_stack &) = delete;
+
+        intrusive_treiber_stack &operator=(const intrusive_treiber_stack &) = delete;
+
+        /**
+         * @note 其他线程同时在操作时，这只是一个瞬间的状态
+         */
+        bool empty() const noexcept {
+            return tagged_pointer::pointer(head.load(std::memory_order_relaxed)) == nullptr;
+        }
+
+        void push(T &value) noexcept {
+            push_chain(value, value);
+        }
+
+        /**
+         * 一次压入一串已经用next链好的元素：@arg first 成为新的栈顶，@arg last 的next指向原来的栈顶
+         * 整串元素只需要一次CAS
+         */
+        void push_chain(T &first, T &last) noexcept {
+            atomic_forward_list_node_base *first_node = to_node(first);
+            atomic_forward_list_node_base *last_node = to_node(last);
+            std::uint64_t old_head = head.load(std::memory_order_relaxed);
+            do {
+                last_node->next.store(tagged_pointer::pointer(old_head), std::memory_order_relaxed);
+            } while (!head.compare_exchange_weak(old_head,
+                                                 tagged_pointer::pack(first_node, tagged_pointer::tag(old_head) + 1),
+                                                 std::memory_order_release, std::memory_order_relaxed));
+        }
+
+        /**
+         * 弹出栈顶元素
+         * @return 弹出的元素，栈为空时返回nullptr
+         */
+        T *pop() noexcept {
+            size_type count;
+            return pop_n(1, count);
+        }
+
+        /**
+         * 一次弹出至多 @arg max_count 个元素，只需要一次CAS
+         * @param count 实际弹出的个数
+         * @return 弹出的第一个元素（原来的栈顶），后面的元素用next链着，最后一个的next为nullptr；栈为空时返回nullptr
+         */
+        T *pop_n(size_type max_count, size_type &count) noexcept {
+            count = 0;
+            if (max_count == 0) {
+                return nullptr;
+            }
+            std::uint64_t old_head = head.load(std::memory_order_acquire);
+            for (;;) {
+                atomic_forward_list_node_base *first = tagged_pointer::pointer(old_head);
+                if (!first) {
+                    return nullptr;
+                }
+                // 这些节点可能正在被别的线程弹出，读到的next可能已经过期，那样的话下面的CAS会失败
+                atomic_forward_list_node_base *last = first;
+                size_type taken = 1;
+                atomic_forward_list_node_base *after = last->next.load(std::memory_order_relaxed);
+                while (taken < max_count && after) {
+                    last = after;
+                    ++taken;
+                    after = last->next.load(std::memory_order_relaxed);
+                }
+                if (head.compare_exchange_weak(old_head,
+                                               tagged_pointer::pack(after, tagged_pointer::tag(old_head) + 1),
+                                               std::memory_order_acquire, std::memory_order_acquire)) {
+                    last->next.store(nullptr, std::memory_order_relaxed);
+                    count = taken;
+                    return to_value(first);
+                }
+            }
+        }
+
+        /**
+         * 弹出所有元素
+         * @return 原来的栈顶，元素用next链着，最后一个的next为nullptr；栈为空时返回nullptr
+         */
+        T *pop_all() noexcept {
+            std::uint64_t old_head = head.load(std::memory_order_relaxed);
+            while (!head.compare_exchange_weak(old_head, tagged_pointer::pack(nullptr, tagged_pointer::tag(old_head) + 1),
+                                               std::memory_order_acquire, std::memory_order_relaxed)) {
+            }
+            return to_value(tagged_pointer::pointer(old_head));
+        }
+
+        /**
+         * 链中 @arg value 的下一个元素，用于遍历push_chain之前链好的、或者pop_n/pop_all弹出的元素
+         */
+        static T *next(T &value) noexcept {
+            return to_value(to_node(value)->next.load(std::memory_order_relaxed));
+        }
+
+        /**
+         * 把 @arg value 的next设为 @arg next_value，用于在push_chain之前把元素链起来
+         */
+        static void link(T &value, T *next_value) noexcept {
+            to_node(value)->next.store(next_value, std::memory_order_relaxed);
+        }
+    };
+
+    /**
+     * 多生产者多消费者的无锁栈
+     * 元素放在自己分配的节点中，节点挂在一个intrusive_treiber_stack上
+     *
+     * 节点的回收：弹出后的节点放进另一个intrusive_treiber_stack作为空闲链，之后的压入优先复用，
+     * 只有栈析构时才真正释放。节点的内存因此在栈的整个生命周期内都是有效的（type-stable），
+     * 并发弹出时读取已被别的线程弹出的节点是安全的，不需要危险指针或者引用计数
+     * 代价是栈占用的内存等于历史上同时存在的元素个数的最大值
+     * @tparam T 元素类型
+     * @tparam Allocator 空间分配器
+     */
+    template<typename T, typename Allocator = allocator<T> >
+    class treiber_stack final {
+    public:
+        typedef T value_type;
+        typedef Allocator allocator_type;
+
+        static_assert((Readable::is_same<typename allocator_type::value_type, value_type>::value),
+                      "Allocator::value_type must be same type as value_type");
+
+        typedef std::size_t size_type;
+        typedef value_type &reference;
+        typedef const value_type &const_reference;
+    private:
+        struct node : atomic_forward_list_node_base {
+            alignas(T) unsigned char storage[sizeof(T)];
+
+            T *value() {
+                return reinterpret_cast<T *>(storage);
+            }
+        };
+
+        typedef typename allocator_type::template rebind<node>::other node_allocator;
+        typedef intrusive_treiber_stack<node> node_stack;
+
+        node_stack items;
+        node_stack free_nodes;
+
+        node *acquire_node() {
+            node *the_node = free_nodes.pop();
+            if (!the_node) {
+                the_node = node_allocator::allocate(1);
+                ::new(static_cast<void *>(the_node)) node();
+            }
+            return the_node;
+        }
+
+        /**
+         * 把 @arg first 开始的一串节点放回空闲链，节点中的元素应当已经析构
+         */
+        void release_chain(node *first) noexcept {
+            if (!first) {
+                return;
+            }
+            node *last = first;
+            while (node *after = node_stack::next(*last)) {
+                last = after;
+            }
+            free_nodes.push_chain(*first, *last);
+        }
+
+        static void deallocate_chain(node *first, bool destroy_values) noexcept {
+            while (first) {
+                node *after = node_stack::next(*first);
+                if (destroy_values) {
+                    Readable::destroy(first->value());
+                }
+                first->~node();
+                node_allocator::deallocate(first, 1);
+                first = after;
+            }
+        }
+
+    public:
+        treiber_stack() = default;
+
+        treiber_stack(const treiber_stack &) = delete;
+
+        treiber_stack &operator=(const treiber_stack &) = delete;
+
+        /**
+         * 析构时不能再有其他线程在操作这个栈
+         */
+        ~treiber_stack() {
+            deallocate_chain(items.pop_all(), true);
+            deallocate_chain(free_nodes.pop_all(), false);
+        }
+
+        /**
+         * 预先分配 @arg count 个空闲节点，之后的压入不再需要调用分配器
+         */
+        void reserve(size_type count) {
+            for (size_type i = 0; i < count; ++i) {
+                node *the_node = node_allocator::allocate(1);
+                ::new(static_cast<void *>(the_node)) node();
+                free_nodes.push(*the_node);
+            }
+        }
+
+        /**
+         * @note 其他线程同时在操作时，这只是一个瞬间的状态
+         */
+        bool empty() const noexcept {
+            return items.empty();
+        }
+
+        template<typename... Args>
+        void emplace(Args &&... args) {
+            node *the_node = acquire_node();
+            try {
+                allocator_type::construct(the_node->value(), std::forward<Args>(args)...);
+            } catch (...) {
+                free_nodes.push(*the_node);
+                throw;
+            }
+            items.push(*the_node);
+        }
+
+        void push(const T &value) {
+            emplace(value);
+        }
+
+        void push(T &&value) {
+            emplace(std::move(value));
+        }
+
+        /**
+         * 把[first, last)依次压入，效果和逐个push相同（最后一个元素在栈顶），但对栈顶只做一次CAS
+         */
+        template<typename InputIterator>
+        void push_range(InputIterator first, InputIterator last) {
+            node *top = nullptr;
+            node *bottom = nullptr;
+            try {
+                for (; first != last; ++first) {
+                    node *the_node = acquire_node();
+                    try {
+                        allocator_type::construct(the_node->value(), *first);
+                    } catch (...) {
+                        free_nodes.push(*the_node);
+                        throw;
+                    }
+                    node_stack::link(*the_node, top);
+                    top = the_node;
+                    if (!bottom) {
+                        bottom = the_node;
+                    }
+                }
+            } catch (...) {
+                for (node *cursor = top; cursor; cursor = node_stack::next(*cursor)) {
+                    Readable::destroy(cursor->value());
+                }
+                release_chain(top);
+                throw;
+            }
+            if (top) {
+                items.push_chain(*top, *bottom);
+            }
+        }
+
+        /**
+         * 尝试弹出栈顶元素，栈为空时立即返回false
+         */
+        bool try_pop(T &out) {
+            node *the_node = items.pop();
+            if (!the_node) {
+                return false;
+            }
+            try {
+                out = std::move(*the_node->value());
+            } catch (...) {
+                // 元素还在节点里，放回栈中
+                items.push(*the_node);
+                throw;
+            }
+            Readable::destroy(the_node->value());
+            free_nodes.push(*the_node);
+            return true;
+        }
+
+        /**
+         * 一次弹出至多 @arg max_count 个元素写入 @arg out，按从栈顶往下的顺序，对栈顶只做一次CAS
+         * @return 实际弹出的个数，栈为空时为0
+         */
+        template<typename OutputIterator>
+        size_type try_pop_n(OutputIterator out, size_type max_count) {
+            size_type count;
+            node *first = items.pop_n(max_count, count);
+            node *cursor = first;
+            node *before = nullptr;
+            try {
+                for (; cursor; before = cursor, cursor = node_stack::next(*cursor)) {
+                    *out = std::move(*cursor->value());
+                    ++out;
+                    Readable::destroy(cursor->value());
+                }
+            } catch (...) {
+                // 还没取出的元素放回栈中，已经取出的节点放回空闲链
+                node *last = cursor;
+                while (node *after = node_stack::next(*last)) {
+                    last = after;
+                }
+                items.push_chain(*cursor, *last);
+                if (before) {
+                    node_stack::link(*before, nullptr);
+                    release_chain(first);
+                }
+                throw;
+            }
+            release_chain(first);
+            return count;
+        }
+    };
+}
+
+#endif //STL_FROM_SCRATCH_TREIBER_STACK_H
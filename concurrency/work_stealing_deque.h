@@ -0,0 +1,177 @@
+#ifndef STL_FROM_SCRATCH_WORK_STEALING_DEQUE_H
+#define STL_FROM_SCRATCH_WORK_STEALING_DEQUE_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include "./cache_line.h"
+
+namespace Readable {
+    /**
+     * Chase-Lev工作窃取双端队列
+     * 内存序参考 Lê, Pop, Cohen, Zappa Nardelli: Correct and Efficient Work-Stealing for Weak Memory Models
+     *
+     * 只有拥有者线程可以在底部push/pop（像栈一样，后进先出，缓存更友好），
+     * 其他线程只能从顶部steal（先进先出，偷走的往往是更大的任务）
+     * 拥有者和窃取者只在队列中只剩一个元素时才需要用CAS竞争
+     *
+     * 容量不够时会换成两倍大的环形数组；旧数组可能还在被窃取者读取，因此保留到队列析构时才释放
+     * @tparam T 元素类型，应当是指针之类可以原子读写的简单类型
+     */
+    template<typename T>
+    class work_stealing_deque final {
+    public:
+        typedef T value_type;
+        typedef std::size_t size_type;
+    private:
+        struct circular_array {
+            std::int64_t mask;
+            std::atomic<T> *items;
+            // 被换下的旧数组，析构时一并释放
+            circular_array *previous;
+
+            explicit circular_array(std::int64_t capacity) :
+                    mask(capacity - 1), items(new std::atomic<T>[capacity]), previous(nullptr) {}
+
+            ~circular_array() {
+                delete[] items;
+            }
+
+            std::int64_t capacity() const {
+                return mask + 1;
+            }
+
+            T get(std::int64_t index) const {
+                return items[index & mask].load(std::memory_order_relaxed);
+            }
+
+            void put(std::int64_t index, T value) {
+                items[index & mask].store(value, std::memory_order_relaxed);
+            }
+
+            /**
+             * 复制出一个两倍大的数组，[top, bottom)之间的元素保持在原来的逻辑下标上
+             */
+            circular_array *grow(std::int64_t top, std::int64_t bottom) const {
+                auto bigger = new circular_array(capacity() * 2);
+                for (auto i = top; i < bottom; ++i) {
+                    bigger->put(i, get(i));
+                }
+                return bigger;
+            }
+        };
+
+        // 窃取者写top，拥有者写bottom，用填充把它们隔开到不同的缓存行中
+        // 这里不用alignas，因为C++17之前用new分配的对象不保证满足超过16字节的对齐要求
+        char padding_before_top[cache_line_size];
+        std::atomic<std::int64_t> top;
+        char padding_after_top[cache_line_size - sizeof(std::atomic<std::int64_t>)];
+        std::atomic<std::int64_t> bottom;
+        std::atomic<circular_array *> array;
+        char padding_after_bottom[cache_line_size - sizeof(std::atomic<std::int64_t>) -
+                                  sizeof(std::atomic<circular_array *>)];
+
+    public:
+        explicit work_stealing_deque(size_type initial_capacity = 64) : top(0), bottom(0), array(nullptr) {
+            std::int64_t capacity = 1;
+            while (capacity < static_cast<std::int64_t>(initial_capacity)) {
+                capacity <<= 1;
+            }
+            array.store(new circular_array(capacity), std::memory_order_relaxed);
+        }
+
+        work_stealing_deque(const work_stealing_deque &) = delete;
+
+        work_stealing_deque &operator=(const work_stealing_deque &) = delete;
+
+        ~work_stealing_deque() {
+            auto now = array.load(std::memory_order_relaxed);
+            while (now) {
+                auto previous = now->previous;
+                delete now;
+                now = previous;
+            }
+        }
+
+        /**
+         * 队列中元素的个数
+         * @note 其他线程同时在操作时，这只是一个近似值
+         */
+        size_type size_approx() const noexcept {
+            auto b = bottom.load(std::memory_order_relaxed);
+            auto t = top.load(std::memory_order_relaxed);
+            return b > t ? static_cast<size_type>(b - t) : 0;
+        }
+
+        bool empty_approx() const noexcept {
+            return size_approx() == 0;
+        }
+
+        /**
+         * 拥有者：在底部放入一个元素
+         */
+        void push(T value) {
+            auto b = bottom.load(std::memory_order_relaxed);
+            auto t = top.load(std::memory_order_acquire);
+            auto a = array.load(std::memory_order_relaxed);
+            if (b - t > a->capacity() - 1) {
+                auto bigger = a->grow(t, b);
+                bigger->previous = a;
+                array.store(bigger, std::memory_order_release);
+                a = bigger;
+            }
+            a->put(b, value);
+            // 使元素的写入对看到新bottom的窃取者可见
+            bottom.store(b + 1, std::memory_order_release);
+        }
+
+        /**
+         * 拥有者：从底部取出一个元素
+         * @return 是否取到了元素
+         */
+        bool pop(T &out) {
+            auto b = bottom.load(std::memory_order_relaxed) - 1;
+            auto a = array.load(std::memory_order_relaxed);
+            // 先"预订"底部的元素，再看窃取者有没有和我们抢同一个
+            bottom.store(b, std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            auto t = top.load(std::memory_order_relaxed);
+            if (t > b) {
+                // 队列本来就是空的
+                bottom.store(b + 1, std::memory_order_relaxed);
+                return false;
+            }
+            out = a->get(b);
+            if (t == b) {
+                // 只剩最后一个元素，和窃取者竞争top
+                bool won = top.compare_exchange_strong(t, t + 1,
+                                                       std::memory_order_seq_cst, std::memory_order_relaxed);
+                bottom.store(b + 1, std::memory_order_relaxed);
+                return won;
+            }
+            return true;
+        }
+
+        /**
+         * 窃取者：从顶部偷一个元素
+         * @return 是否偷到了元素；和其他线程竞争失败时也返回false
+         */
+        bool steal(T &out) {
+            auto t = top.load(std::memory_order_acquire);
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            auto b = bottom.load(std::memory_order_acquire);
+            if (t >= b) {
+                return false;
+            }
+            auto a = array.load(std::memory_order_acquire);
+            T value = a->get(t);
+            if (!top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed)) {
+                return false;
+            }
+            out = value;
+            return true;
+        }
+    };
+}
+
+#endif //STL_FROM_SCRATCH_WORK_STEALING_DEQUE_H
@@ -2,11 +2,13 @@
 #define STL_FROM_SCRATCH_FORWARD_LIST_H
 
 #include "../memory/memory.h"
+#include "../memory/node_slab.h"
 #include "../iterator/iterator_traits.h"
 #include "../utility/utility.h"
 #include "../type_traits/type_traits.h"
 #include "../iterator/iterator.h"
 #include "../functional/functional.h"
+#include "./linked_list_sort.h"
 
 namespace Readable {
     /**
@@ -99,6 +101,9 @@ namespace Readable {
 
     /**
      * forward_list容器类
+     * defragment()把较多的节点放在一个节点块中（见node_slab.h），块中最后一个节点被删除时整块内存就归还，
+     * 不管这时节点在哪个forward_list中；splice和merge不需要额外的工作
+     * 不同的forward_list可以在不同的线程上使用，即使它们之间移动过节点
      * @tparam T 容器中的内容
      * @tparam Allocator 空间分配器
      */
@@ -123,10 +128,19 @@ namespace Readable {
         typedef forward_list<T, Allocator> self_type;
         typedef forward_list_node<T> node_type;
         typedef typename allocator_type::template rebind<node_type>::other node_allocator;
+        typedef node_slab_allocator<node_type, allocator_type> slab_allocator;
         forward_list_node_base node_before_begin;
+        // 元素个数，使size()为O(1)
+        size_type node_count;
+
+        // 使用不同空间配置器的forward_list之间需要访问彼此的节点
+        template<typename, typename>
+        friend
+        class forward_list;
+
     public:
         // 使用Allocator类型参数构造forward_list时，实际上并不使用这个参数
-        explicit forward_list(const Allocator &) {
+        explicit forward_list(const Allocator &) : node_count(0) {
             node_before_begin.next = nullptr;
         }
 
@@ -165,7 +179,11 @@ namespace Readable {
         // 对于move_constructor，只在other和自己类型完全相同(即不仅T相同，allocator也相同)时才能使用move加速
         // 对于other和自己类型不完全相同的情况，other将不被看作将亡值，而由上面一个函数进行逐元素处理
         forward_list(self_type &&other, const Allocator &alloc = Allocator()) : node_before_begin(
-                std::move(other.node_before_begin)) {}
+                std::move(other.node_before_begin)), node_count(other.node_count) {
+            // 节点已经归this所有，other不能再释放它们
+            other.node_before_begin.next = nullptr;
+            other.node_count = 0;
+        }
 
         forward_list(std::initializer_list<T> init,
                      const Allocator &alloc = Allocator()) : forward_list(init.begin(), init.end(), alloc) {}
@@ -202,16 +220,16 @@ namespace Readable {
         template<typename InputIt>
         void assign(InputIt first, InputIt last) {
             auto it = before_begin();
-            while (next(it) != end() && next(it) != first) {
+            while (Readable::next(it) != end() && Readable::next(it) != first) {
                 erase_after(it);
             }
-            if (next(it) == first) {
+            if (Readable::next(it) == first) {
                 // so [first, last) is in [begin(),end)
-                while (next(it) != last) {
+                while (Readable::next(it) != last) {
                     // go to last
                     ++it;
                 }
-                while (next(it) != end()) {
+                while (Readable::next(it) != end()) {
                     // erase them all!
                     erase_after(it);
                 }
@@ -244,11 +262,11 @@ namespace Readable {
         }
 
         const_iterator before_begin() const noexcept {
-            return const_iterator(&node_before_begin);
+            return const_iterator(const_cast<forward_list_node_base *>(&node_before_begin));
         }
 
         const_iterator cbefore_begin() const noexcept {
-            return const_iterator(&node_before_begin);
+            return const_iterator(const_cast<forward_list_node_base *>(&node_before_begin));
         }
 
         iterator begin() noexcept {
@@ -279,6 +297,10 @@ namespace Readable {
             return node_before_begin.next == nullptr;
         }
 
+        size_type size() const noexcept {
+            return node_count;
+        }
+
         size_type max_size() const noexcept {
             return SIZE_MAX;
         }
@@ -299,7 +321,7 @@ namespace Readable {
         static forward_list_node_base *create_node(T &&value) {
             node_type *new_node = node_allocator::allocate(1);
             try {
-                Readable::construct(&new_node->value, value);
+                allocator_type::construct(&new_node->value, std::move(value));
             } catch (...) {
                 // rollback
                 node_allocator::deallocate(new_node, 1);
@@ -308,15 +330,24 @@ namespace Readable {
             return (forward_list_node_base *) (new_node);
         }
 
-        static void destroy_node(node_type *node) {
-            Readable::destroy(&node->value);
-            node_allocator::deallocate(node, 1);
+        /**
+         * 节点块中的节点只析构元素，并减少块的存活节点数，内存随整个块释放
+         */
+        static void destroy_node(node_type *the_node) noexcept {
+            Readable::destroy(&the_node->value);
+            node_slab *slab = node_slab::find(the_node);
+            if (slab) {
+                slab->release_node();
+            } else {
+                node_allocator::deallocate(the_node, 1);
+            }
         }
 
         forward_list_node_base *
-        insert_after(forward_list_node_base *node_to_be_inserted_after, forward_list_node_base *node_to_insert) const {
+        insert_after(forward_list_node_base *node_to_be_inserted_after, forward_list_node_base *node_to_insert) {
             node_to_insert->next = node_to_be_inserted_after->next;
             node_to_be_inserted_after->next = node_to_insert;
+            ++node_count;
             return node_to_insert;
         }
 
@@ -330,7 +361,7 @@ namespace Readable {
 
         iterator insert_after(const_iterator pos, T &&value) {
             forward_list_node_base *node_to_be_inserted_after = pos.node;
-            forward_list_node_base *node_to_insert = create_node(value);
+            forward_list_node_base *node_to_insert = create_node(std::move(value));
             return iterator(insert_after(node_to_be_inserted_after, node_to_insert));
         }
 
@@ -393,6 +424,7 @@ namespace Readable {
                 auto next_of_next = the_node_to_erase_after->next->next;
                 destroy_node((node_type *) the_node_to_erase_after->next);
                 the_node_to_erase_after->next = next_of_next;
+                --node_count;
             }
             return iterator(the_node_to_erase_after->next);
         }
@@ -405,6 +437,7 @@ namespace Readable {
                     auto next_of_next = node_first->next->next;
                     destroy_node((node_type *) node_first->next);
                     node_first->next = next_of_next;
+                    --node_count;
                 }
             }
             return iterator(last);
@@ -419,7 +452,7 @@ namespace Readable {
         }
 
         void push_front(T &&value) {
-            insert_after(before_begin(), value);
+            insert_after(before_begin(), std::move(value));
         }
 
         template<typename... Args>
@@ -452,9 +485,9 @@ namespace Readable {
         template<typename alloc>
         void swap(forward_list<T, alloc> &other) {
             std::swap(node_before_begin.next, other.node_before_begin.next);
+            std::swap(node_count, other.node_count);
         }
 
-        // merge族函数还存在优化空间——考虑将insert_after改为splice_after的实现
         template<typename alloc>
         void merge(forward_list<T, alloc> &other) {
             merge(other, less<T>());
@@ -465,60 +498,90 @@ namespace Readable {
             merge(other, less<T>());
         }
 
-
+        /**
+         * 把有序的 @arg other 归并进有序的本链表，归并后 @arg other 为空
+         * 只重新链接节点，不分配内存也不复制元素；相等的元素中本链表的在前
+         */
         template<typename alloc, typename Compare>
         void merge(forward_list<T, alloc> &other, Compare comp) {
-            auto this_now = before_begin();
-            auto this_next = begin();
-            auto other_now = other.before_begin();
-            auto other_next = other.begin();
-            while (this_next != end() && other_next != end()) {
-                if (comp(*this_next, *other_next)) {
-                    ++this_next;
-                    ++this_now;
-                } else {
-                    insert_after(this_now, *other_next);
-                    this_next = this_now;
-                    ++this_next;
-                    ++other_now;
-                    ++other_next;
-                }
-            }
-            while (other_next != end()) {
-                insert_after(this_now, *other_next);
-                ++this_now;
-                ++other_now;
-                ++other_next;
+            if (static_cast<void *>(&other) == static_cast<void *>(this)) {
+                return;
             }
-            other.clear();
-        };
+            auto node_less = [&comp](forward_list_node_base *a, forward_list_node_base *b) {
+                return comp(((node_type *) a)->value, ((node_type *) b)->value);
+            };
+            node_before_begin.next = Readable::merge_linked_chains(node_before_begin.next,
+                                                                   other.node_before_begin.next, node_less);
+            transfer_count(other, other.node_count);
+            other.node_before_begin.next = nullptr;
+        }
 
         template<typename alloc, typename Compare>
         void merge(forward_list<T, alloc> &&other, Compare comp) {
-            auto this_now = before_begin();
-            auto this_next = begin();
-            auto other_now = other.before_begin();
-            auto other_next = other.begin();
-            while (this_next != end() && other_next != end()) {
-                if (comp(*this_next, *other_next)) {
-                    ++this_next;
-                    ++this_now;
-                } else {
-                    insert_after(this_now, *other_next);
-                    this_next = this_now;
-                    ++this_next;
-                    ++other_now;
-                    ++other_next;
+            merge(other, comp);
+        }
+
+        template<typename ForwardListIt>
+        void merge_all(ForwardListIt first, ForwardListIt last) {
+            merge_all(first, last, less<T>());
+        }
+
+        /**
+         * 把 [first, last) 中的所有有序链表归并进有序的本链表，归并后它们都为空
+         * 像二进制加法进位一样两两归并（同list::sort），共O(N log k)次比较，k为链表个数，不分配内存
+         * 相等的元素按本链表、first、first + 1...的顺序排列
+         * @tparam ForwardListIt 指向forward_list的迭代器
+         */
+        template<typename ForwardListIt, typename Compare>
+        void merge_all(ForwardListIt first, ForwardListIt last, Compare comp) {
+            auto node_less = [&comp](forward_list_node_base *a, forward_list_node_base *b) {
+                return comp(((node_type *) a)->value, ((node_type *) b)->value);
+            };
+            const std::size_t bin_count = 64;
+            // bins[i]中的链由2^i条链归并而来，越高的bin中的链越早
+            forward_list_node_base *bins[bin_count] = {};
+            std::size_t used_bins = 0;
+            auto add_chain = [&](forward_list_node_base *carry) {
+                std::size_t i = 0;
+                for (; i < bin_count - 1 && bins[i]; ++i) {
+                    carry = Readable::merge_linked_chains(bins[i], carry, node_less);
+                    bins[i] = nullptr;
+                }
+                bins[i] = Readable::merge_linked_chains(bins[i], carry, node_less);
+                if (i + 1 > used_bins) {
+                    used_bins = i + 1;
+                }
+            };
+            add_chain(node_before_begin.next);
+            for (; first != last; ++first) {
+                auto &other = *first;
+                if (static_cast<void *>(&other) == static_cast<void *>(this)) {
+                    continue;
                 }
+                add_chain(other.node_before_begin.next);
+                transfer_count(other, other.node_count);
+                other.node_before_begin.next = nullptr;
             }
-            while (other_next != end()) {
-                insert_after(this_now, *other_next);
-                ++this_now;
-                ++other_now;
-                ++other_next;
+            forward_list_node_base *result = nullptr;
+            for (std::size_t i = 0; i < used_bins; ++i) {
+                result = Readable::merge_linked_chains(bins[i], result, node_less);
             }
+            node_before_begin.next = result;
         }
 
+    private:
+        /**
+         * 元素在两个forward_list之间移动时更新双方的元素个数
+         */
+        template<typename alloc>
+        void transfer_count(forward_list<T, alloc> &from, size_type count) {
+            if (static_cast<void *>(&from) != static_cast<void *>(this)) {
+                from.node_count -= count;
+                node_count += count;
+            }
+        }
+
+    public:
         template<typename alloc>
         void splice_after(const_iterator pos, forward_list<T, alloc> &other) {
             splice_after(pos, other, other.before_begin(), other.end());
@@ -532,15 +595,15 @@ namespace Readable {
         template<typename alloc>
         void splice_after(const_iterator pos, forward_list<T, alloc> &other,
                           const_iterator it) {
-            if (pos != it && next(pos) != it)
-                splice_after(pos, other, it, next(it, 2));
+            if (pos != it && Readable::next(pos) != it)
+                splice_after(pos, other, it, Readable::next(it, 2));
         }
 
         template<typename alloc>
         void splice_after(const_iterator pos, forward_list<T, alloc> &&other,
                           const_iterator it) {
-            if (pos != it && next(pos) != it)
-                splice_after(pos, other, it, next(it, 2));
+            if (pos != it && Readable::next(pos) != it)
+                splice_after(pos, other, it, Readable::next(it, 2));
         }
 
         template<typename alloc>
@@ -548,11 +611,16 @@ namespace Readable {
                           const_iterator first, const_iterator last) {
             if (first != last && pos != first) {
                 // 找到last前的节点（对应的迭代器）
+                // 反正要走一遍，顺便数出移动的元素个数
                 const_iterator the_iterator_before_last = first;
-                while (the_iterator_before_last.node->next != last.node)
+                size_type moved_count = 0;
+                while (the_iterator_before_last.node->next != last.node) {
                     ++the_iterator_before_last;
+                    ++moved_count;
+                }
                 // 要进入this的一段是(first,the_iterator_before_last]
                 if (first != the_iterator_before_last) {
+                    transfer_count(other, moved_count);
                     // 先将the_iterator_before_last加入链中
                     the_iterator_before_last.node->next = pos.node->next;
                     // 将first之后的节点加入链中
@@ -568,9 +636,13 @@ namespace Readable {
                           const_iterator first, const_iterator last) {
             if (first != last && pos != first) {
                 const_iterator it = first;
-                while (it.node->next != last.node)
+                size_type moved_count = 0;
+                while (it.node->next != last.node) {
                     ++it;
+                    ++moved_count;
+                }
                 if (first != it) {
+                    transfer_count(other, moved_count);
                     it.node->next = pos.node->next;
                     pos.node->next = first.node->next;
                     first.node->next = last.node;
@@ -579,8 +651,8 @@ namespace Readable {
         }
 
         void remove(const T &value) {
-            for (auto it = before_begin(); next(it) != end();) {
-                if (*next(it) == value) {
+            for (auto it = before_begin(); Readable::next(it) != end();) {
+                if (*Readable::next(it) == value) {
                     erase_after(it);
                 } else {
                     ++it;
@@ -590,8 +662,8 @@ namespace Readable {
 
         template<typename UnaryPredicate>
         void remove_if(UnaryPredicate p) {
-            for (auto it = before_begin(); next(it) != end();) {
-                if (p(*next(it))) {
+            for (auto it = before_begin(); Readable::next(it) != end();) {
+                if (p(*Readable::next(it))) {
                     erase_after(it);
                 } else {
                     ++it;
@@ -604,9 +676,9 @@ namespace Readable {
             // hard to explain, may be bad code
             // but it just works
             // todo: 尝试解释这个
-            if (begin() != end() && next(begin()) != end()) {
+            if (begin() != end() && Readable::next(begin()) != end()) {
                 auto last_node_in_reversed_list = begin().node;
-                for (auto it = begin(); next(it) != end(); ++it) {
+                for (auto it = begin(); Readable::next(it) != end(); ++it) {
                     auto the_node_we_are_dealing_with = it.node.next;
                     auto old_begin_node = node_before_begin.next;
                     last_node_in_reversed_list->next = the_node_we_are_dealing_with->next;
@@ -617,8 +689,8 @@ namespace Readable {
         }
 
         void unique() {
-            for (auto it = begin(); next(it) != end();) {
-                if (*next(it) == *it) {
+            for (auto it = begin(); Readable::next(it) != end();) {
+                if (*Readable::next(it) == *it) {
                     erase_after(it);
                 } else {
                     ++it;
@@ -628,94 +700,79 @@ namespace Readable {
 
         template<typename BinaryPredicate>
         void unique(BinaryPredicate p) {
-            for (auto it = begin(); next(it) != end(); ++it) {
-                if (p(*next(it), *it)) {
+            for (auto it = begin(); Readable::next(it) != end(); ++it) {
+                if (p(*Readable::next(it), *it)) {
                     erase_after(it);
                 }
             }
         }
 
         void sort() {
-            sort([](const T &a, const T &b) { return a < b; });
+            sort(less<T>());
         }
 
-    private:
-        // 将链表均分为两段
-        static Readable::pair<forward_list_node_base *, forward_list_node_base *>
-        divide(forward_list_node_base *first) {
-            forward_list_node_base *tail1 = first;
-            forward_list_node_base *tail2 = first;
-            // 龟兔算法
-            while (tail2->next && tail2->next->next) {
-                tail1 = tail1->next;
-                tail2 = tail2->next->next;
+        /**
+         * 稳定排序
+         * 自底向上的自然归并排序（见linked_list_sort.h），不递归，额外空间只有固定的64个bins，
+         * 已经有序或逆序的输入只需要一遍遍历
+         * 只修改指针，不移动元素，所有迭代器仍然有效
+         */
+        template<typename Compare>
+        void sort(Compare comp) {
+            if (node_count < 2) {
+                return;
             }
-            auto head2 = tail1->next;
-            // 断开链表
-            tail1->next = nullptr;
-            return {first, head2};
+            auto sorted = Readable::natural_merge_sort(node_before_begin.next,
+                                                       [&comp](forward_list_node_base *a, forward_list_node_base *b) {
+                                                           return comp(((node_type *) a)->value,
+                                                                       ((node_type *) b)->value);
+                                                       });
+            node_before_begin.next = sorted.head;
         }
 
-        // 基于node的归并
-        template<typename Compare>
-        static forward_list_node_base *merge(forward_list_node_base *l1, forward_list_node_base *l2, Compare comp) {
-            if (!l1) {
-                return l2;
-            } else if (!l2) {
-                return l1;
+        /**
+         * 整理节点的内存布局
+         * 按遍历顺序把元素放进新节点并重新链接，再释放旧节点；节点足够多时新节点在一整块连续的内存中
+         * 整理后沿next遍历就是顺序访问内存
+         * 元素的移动构造不抛出异常时移动元素，否则复制元素；复制失败时链表保持原样
+         * @note 所有迭代器、指针和引用都会失效
+         */
+        void defragment() {
+            if (node_count == 0) {
+                return;
             }
-            auto first_now_at = l1;
-            auto second_now_at = l2;
-            decltype(first_now_at) ret = nullptr;
-            // 取出两个要归并的链表头中在先的一个，放入ret中
-            if (comp(((node_type *) first_now_at)->value, ((node_type *) second_now_at)->value)) {
-                ret = first_now_at;
-                first_now_at = first_now_at->next;
-                ret->next = nullptr;
+            // 新节点先放在一个临时的链表中，全部构造成功后再交换，旧节点随临时链表析构
+            self_type fresh;
+            node_slab *slab = slab_allocator::create(node_count);
+            if (slab) {
+                size_type built = 0;
+                try {
+                    for (auto cursor = node_before_begin.next; cursor; cursor = cursor->next, ++built) {
+                        allocator_type::construct(&slab_allocator::node_at(slab, built)->value,
+                                                  std::move_if_noexcept(((node_type *) cursor)->value));
+                    }
+                } catch (...) {
+                    for (size_type i = 0; i < built; ++i) {
+                        Readable::destroy(&slab_allocator::node_at(slab, i)->value);
+                    }
+                    slab_allocator::destroy(slab);
+                    throw;
+                }
+                forward_list_node_base *prev = &fresh.node_before_begin;
+                for (size_type i = 0; i < built; ++i) {
+                    forward_list_node_base *new_node = slab_allocator::node_at(slab, i);
+                    prev->next = new_node;
+                    prev = new_node;
+                }
+                prev->next = nullptr;
+                fresh.node_count = built;
             } else {
-                ret = second_now_at;
-                second_now_at = second_now_at->next;
-                ret->next = nullptr;
-            }
-            // 下面与基于迭代器的merge相似
-            auto ret_head = ret;
-            while (first_now_at && second_now_at) {
-                if (comp(((node_type *) first_now_at)->value,
-                         ((node_type *) second_now_at)->value)) {
-                    ret->next = first_now_at;
-                    first_now_at = first_now_at->next;
-                    ret = ret->next;
-                    ret->next = nullptr;
-                } else {
-                    ret->next = second_now_at;
-                    second_now_at = second_now_at->next;
-                    ret = ret->next;
-                    ret->next = nullptr;
+                auto tail = fresh.before_begin();
+                for (auto cursor = node_before_begin.next; cursor; cursor = cursor->next) {
+                    tail = fresh.insert_after(tail, std::move_if_noexcept(((node_type *) cursor)->value));
                 }
             }
-            if (first_now_at) {
-                ret->next = first_now_at;
-            }
-            if (second_now_at) {
-                ret->next = second_now_at;
-            }
-            return ret_head;
-        }
-
-        // 基于node的排序
-        template<typename Compare>
-        static forward_list_node_base *sort_by_node(forward_list_node_base *list, Compare comp) {
-            if (!list || !(list->next)) {
-                return list;
-            }
-            Readable::pair<forward_list_node_base *, forward_list_node_base *> divided = divide(list);
-            return merge(sort_by_node(divided.first, comp), sort_by_node(divided.second, comp), comp);
-        }
-
-    public:
-        template<typename Compare>
-        void sort(Compare comp) {
-            node_before_begin.next = sort_by_node(forward_list<T, allocator_type>::node_before_begin.next, comp);
+            swap(fresh);
         }
     };
 };
@@ -0,0 +1,832 @@
+#ifndef STL_FROM_SCRATCH_INDEX_LIST_H
+#define STL_FROM_SCRATCH_INDEX_LIST_H
+
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+#include <stdexcept>
+#include "../memory/memory.h"
+#include "../iterator/iterator.h"
+#include "../functional/functional.h"
+#include "../utility/utility.h"
+#include "../type_traits/type_traits.h"
+#include "./vector.h"
+
+namespace Readable {
+    template<typename T, typename Allocator>
+    class index_list;
+
+    /**
+     * index_list的迭代器
+     * 记录所属的链表和节点的下标，而不是节点的地址：节点数组扩容搬家后迭代器仍然有效
+     * 但迭代器指向的是链表对象本身，元素随swap或移动到了另一个链表后，原来的迭代器不会跟过去
+     */
+    template<typename T, typename Allocator, typename ReferenceType, typename PointerType>
+    struct index_list_iterator : public Readable::iterator<
+            Readable::bidirectional_iterator_tag,
+            T,
+            std::ptrdiff_t,
+            PointerType,
+            ReferenceType
+    > {
+        typedef index_list_iterator<T, Allocator, ReferenceType, PointerType> self_type;
+        typedef index_list_iterator<T, Allocator, T &, T *> iterator_type;
+        typedef index_list_iterator<T, Allocator, const T &, const T *> const_iterator_type;
+        typedef index_list<T, Allocator> list_type;
+        typedef std::uint32_t index_type;
+
+        list_type *owner;
+        index_type index;
+
+        index_list_iterator() = default;
+
+        index_list_iterator(list_type *l, index_type i) : owner(l), index(i) {}
+
+        index_list_iterator(const iterator_type &other) : owner(other.owner), index(other.index) {}
+
+        index_list_iterator(const const_iterator_type &other) : owner(other.owner), index(other.index) {}
+
+        bool operator==(const self_type &other) const { return index == other.index && owner == other.owner; }
+
+        bool operator!=(const self_type &other) const { return !(*this == other); }
+
+        ReferenceType operator*() const {
+            return owner->value_at(index);
+        }
+
+        PointerType operator->() const {
+            return Readable::addressof(operator*());
+        }
+
+        self_type &operator++() {
+            index = owner->next_of(index);
+            return *this;
+        }
+
+        self_type operator++(int) {
+            self_type origin_this = *this;
+            ++*this;
+            return origin_this;
+        }
+
+        self_type &operator--() {
+            index = owner->prev_of(index);
+            return *this;
+        }
+
+        self_type operator--(int) {
+            self_type origin_this = *this;
+            --*this;
+            return origin_this;
+        }
+    };
+
+    /**
+     * 用32位下标链接的双向链表
+     * 所有节点放在一个vector中，节点之间用32位下标而不是指针链接，删除的节点进入空闲链表供之后复用
+     * 64位下list<int>的一个节点有两个8字节指针（再加上每次分配的额外开销），这里只有4 + 4 + sizeof(T)字节，
+     * 节点也都在一块连续的内存中
+     *
+     * 和list的区别：
+     * - 插入可能使节点数组扩容，元素的引用和指针会失效，但迭代器（记录的是下标）仍然有效
+     * - 节点不能离开自己的数组：只有同一个index_list内部的splice是重新链接节点；
+     *   从另一个index_list整个splice或merge时，元素被移动到本链表的新节点中，指向other的迭代器都会失效
+     * - 迭代器记录的是链表对象的地址：swap、移动构造和移动赋值之后，所有迭代器都失效
+     *   （list的迭代器在swap后仍然指向原来的元素，这里不是）
+     * - 最多保存2^32 - 2个元素
+     * @tparam T 元素类型
+     */
+    template<typename T, typename Allocator = allocator<T> >
+    class index_list final {
+    public:
+        typedef T value_type;
+        typedef Allocator allocator_type;
+        static_assert(Readable::is_same<typename allocator_type::value_type, value_type>::value,
+                      "Allocator::value_type must be same type as value_type");
+        typedef value_type &reference;
+        typedef const value_type &const_reference;
+        typedef index_list_iterator<T, Allocator, T &, T *> iterator;
+        typedef index_list_iterator<T, Allocator, const T &, const T *> const_iterator;
+        typedef std::size_t size_type;
+        typedef std::ptrdiff_t difference_type;
+        typedef Readable::reverse_iterator<iterator> reverse_iterator;
+        typedef Readable::reverse_iterator<const_iterator> const_reverse_iterator;
+        typedef std::uint32_t index_type;
+
+        // 哨兵（即end()）的下标
+        static const index_type npos = UINT32_MAX;
+    private:
+        template<typename, typename, typename, typename>
+        friend
+        struct index_list_iterator;
+
+        // 空闲节点的prev被设为这个值，用来区分节点中有没有元素
+        static const index_type free_mark = UINT32_MAX - 1;
+
+        struct slot {
+            index_type prev;
+            index_type next;
+            alignas(T) unsigned char storage[sizeof(T)];
+
+            slot() : prev(free_mark), next(npos) {}
+
+            // 节点数组扩容时搬移节点，有元素的节点连元素一起移动
+            slot(slot &&other) : prev(other.prev), next(other.next) {
+                if (other.in_use()) {
+                    allocator_type::construct(value(), std::move(*other.value()));
+                }
+            }
+
+            slot(const slot &other) : prev(other.prev), next(other.next) {
+                if (other.in_use()) {
+                    allocator_type::construct(value(), *other.value());
+                }
+            }
+
+            slot &operator=(const slot &) = delete;
+
+            ~slot() {
+                if (in_use()) {
+                    Readable::destroy(value());
+                }
+            }
+
+            bool in_use() const {
+                return prev != free_mark;
+            }
+
+            T *value() {
+                return reinterpret_cast<T *>(storage);
+            }
+
+            const T *value() const {
+                return reinterpret_cast<const T *>(storage);
+            }
+        };
+
+        typedef typename allocator_type::template rebind<slot>::other slot_allocator;
+
+        Readable::vector<slot, slot_allocator> slots;
+        // 哨兵的两个链接
+        index_type head;
+        index_type tail;
+        // 空闲链表，通过空闲节点的next串起来
+        index_type free_head;
+        size_type element_count;
+
+        T &value_at(index_type index) {
+            return *slots[index].value();
+        }
+
+        index_type next_of(index_type index) const {
+            return index == npos ? head : slots[index].next;
+        }
+
+        index_type prev_of(index_type index) const {
+            return index == npos ? tail : slots[index].prev;
+        }
+
+        index_type &next_link(index_type index) {
+            return index == npos ? head : slots[index].next;
+        }
+
+        index_type &prev_link(index_type index) {
+            return index == npos ? tail : slots[index].prev;
+        }
+
+        /**
+         * 取一个空闲节点，没有时在数组末尾加一个
+         */
+        index_type acquire_slot() {
+            if (free_head != npos) {
+                index_type index = free_head;
+                free_head = slots[index].next;
+                return index;
+            }
+            if (slots.size() >= free_mark) {
+                throw std::length_error("index_list is full");
+            }
+            slots.push_back(slot());
+            return static_cast<index_type>(slots.size() - 1);
+        }
+
+        /**
+         * 把节点放回空闲链表，节点中的元素应当已经析构
+         */
+        void release_slot(index_type index) {
+            slots[index].prev = free_mark;
+            slots[index].next = free_head;
+            free_head = index;
+        }
+
+        /**
+         * 把已经摘下的节点 @arg index 链接到 @arg position 之前
+         */
+        void link_before(index_type position, index_type index) {
+            index_type before = prev_of(position);
+            slots[index].prev = before;
+            slots[index].next = position;
+            next_link(before) = index;
+            prev_link(position) = index;
+        }
+
+        void unlink(index_type index) {
+            index_type before = slots[index].prev;
+            index_type after = slots[index].next;
+            next_link(before) = after;
+            prev_link(after) = before;
+        }
+
+        /**
+         * 按 @arg order 中的顺序重建整个链
+         */
+        void relink_all(const Readable::vector<index_type> &order) {
+            index_type before = npos;
+            for (auto index: order) {
+                slots[index].prev = before;
+                next_link(before) = index;
+                before = index;
+            }
+            next_link(before) = npos;
+            tail = before;
+        }
+
+        /**
+         * 取一个节点并在其中构造元素，链接到 @arg position 之前
+         * 由调用者保证取节点时数组扩容不会使args引用的元素失效
+         */
+        template<typename... Args>
+        iterator emplace_in_new_slot(const_iterator position, Args &&... args) {
+            index_type index = acquire_slot();
+            try {
+                allocator_type::construct(slots[index].value(), std::forward<Args>(args)...);
+            } catch (...) {
+                release_slot(index);
+                throw;
+            }
+            link_before(position.index, index);
+            ++element_count;
+            return iterator(this, index);
+        }
+
+        /**
+         * 插入失败时删除已经插入的元素，和list的区间插入一样
+         */
+        iterator insert_imp(const_iterator position, size_type n, const T &value, Readable::true_type) {
+            if (n == 0) {
+                return iterator(this, position.index);
+            }
+            T copy(value);
+            iterator first_inserted(this, position.index);
+            try {
+                for (size_type i = 0; i < n; ++i) {
+                    auto inserted = emplace_in_new_slot(position, copy);
+                    if (i == 0) {
+                        first_inserted = inserted;
+                    }
+                }
+            } catch (...) {
+                erase(first_inserted, position);
+                throw;
+            }
+            return first_inserted;
+        }
+
+        /**
+         * 迭代器可能指向本链表，解引用得到的元素会因扩容而失效，所以逐个交给emplace处理
+         */
+        template<typename InputIt>
+        iterator insert_imp(const_iterator position, InputIt first, InputIt last, Readable::false_type) {
+            iterator first_inserted(this, position.index);
+            bool inserted_any = false;
+            try {
+                for (; first != last; ++first) {
+                    auto inserted = emplace(position, *first);
+                    if (!inserted_any) {
+                        first_inserted = inserted;
+                        inserted_any = true;
+                    }
+                }
+            } catch (...) {
+                erase(first_inserted, position);
+                throw;
+            }
+            return first_inserted;
+        }
+
+        template<typename InputIt>
+        void initialize(InputIt first, InputIt last, Readable::false_type) {
+            for (; first != last; ++first) {
+                push_back(*first);
+            }
+        }
+
+        void initialize(size_type n, const T &value, Readable::true_type) {
+            reserve(n);
+            for (size_type i = 0; i < n; ++i) {
+                push_back(value);
+            }
+        }
+
+    public:
+        index_list() : slots(), head(npos), tail(npos), free_head(npos), element_count(0) {}
+
+        index_list(size_type n, const T &value) : index_list() {
+            initialize(n, value, Readable::true_type());
+        }
+
+        template<typename InputItOrIntegral>
+        index_list(InputItOrIntegral first, InputItOrIntegral last) : index_list() {
+            initialize(first, last, Readable::is_integral<InputItOrIntegral>());
+        }
+
+        index_list(std::initializer_list<T> init_list) : index_list(init_list.begin(), init_list.end()) {}
+
+        index_list(const index_list &other) : index_list() {
+            reserve(other.size());
+            for (auto &value: other) {
+                push_back(value);
+            }
+        }
+
+        index_list(index_list &&other) noexcept : index_list() {
+            swap(other);
+        }
+
+        index_list &operator=(const index_list &other) {
+            if (&other != this) {
+                index_list copy(other);
+                swap(copy);
+            }
+            return *this;
+        }
+
+        index_list &operator=(index_list &&other) noexcept {
+            if (&other != this) {
+                clear();
+                swap(other);
+            }
+            return *this;
+        }
+
+        index_list &operator=(std::initializer_list<T> init_list) {
+            assign(init_list);
+            return *this;
+        }
+
+        /**
+         * [first, last)可能就在本链表中，所以先在新链表中构造好再交换
+         */
+        template<typename InputItOrIntegral>
+        void assign(InputItOrIntegral first, InputItOrIntegral last) {
+            index_list copy(first, last);
+            swap(copy);
+        }
+
+        void assign(size_type n, const T &value) {
+            index_list copy(n, value);
+            swap(copy);
+        }
+
+        void assign(std::initializer_list<T> init_list) {
+            assign(init_list.begin(), init_list.end());
+        }
+
+        // iterators:
+        iterator begin() noexcept {
+            return iterator(this, head);
+        }
+
+        const_iterator begin() const noexcept {
+            return const_iterator(const_cast<index_list *>(this), head);
+        }
+
+        iterator end() noexcept {
+            return iterator(this, npos);
+        }
+
+        const_iterator end() const noexcept {
+            return const_iterator(const_cast<index_list *>(this), npos);
+        }
+
+        const_iterator cbegin() const noexcept {
+            return begin();
+        }
+
+        const_iterator cend() const noexcept {
+            return end();
+        }
+
+        reverse_iterator rbegin() noexcept {
+            return reverse_iterator(end());
+        }
+
+        const_reverse_iterator rbegin() const noexcept {
+            return const_reverse_iterator(end());
+        }
+
+        reverse_iterator rend() noexcept {
+            return reverse_iterator(begin());
+        }
+
+        const_reverse_iterator rend() const noexcept {
+            return const_reverse_iterator(begin());
+        }
+
+        // capacity:
+        size_type size() const noexcept {
+            return element_count;
+        }
+
+        bool empty() const noexcept {
+            return element_count == 0;
+        }
+
+        size_type max_size() const noexcept {
+            return free_mark;
+        }
+
+        void resize(size_type count) {
+            resize(count, T());
+        }
+
+        void resize(size_type count, const T &value) {
+            auto it = begin();
+            size_type i = 0;
+            for (; i < count && it != end(); ++i, ++it) {
+            }
+            if (i == count) {
+                // 多退
+                erase(it, end());
+            } else {
+                // 少补
+                insert(end(), count - i, value);
+            }
+        }
+
+        /**
+         * 预先为 @arg n 个节点分配空间
+         */
+        void reserve(size_type n) {
+            slots.reserve(n);
+        }
+
+        // element access:
+        reference front() {
+            return value_at(head);
+        }
+
+        const_reference front() const {
+            return *slots[head].value();
+        }
+
+        reference back() {
+            return value_at(tail);
+        }
+
+        const_reference back() const {
+            return *slots[tail].value();
+        }
+
+        // modifiers:
+        /**
+         * 在 @arg position 前构造一个元素
+         * 没有空闲节点且节点数组已满时，新增节点会使数组扩容搬家，而args可能引用链表中的元素
+         * （比如l.push_back(l.front())），这时先在扩容前构造出元素，再移动到节点中
+         */
+        template<typename... Args>
+        iterator emplace(const_iterator position, Args &&... args) {
+            if (free_head == npos && slots.size() == slots.capacity()) {
+                T value(std::forward<Args>(args)...);
+                return emplace_in_new_slot(position, std::move(value));
+            }
+            return emplace_in_new_slot(position, std::forward<Args>(args)...);
+        }
+
+        iterator insert(const_iterator position, const T &value) {
+            return emplace(position, value);
+        }
+
+        iterator insert(const_iterator position, T &&value) {
+            return emplace(position, std::move(value));
+        }
+
+        /**
+         * 在 @arg position 前插入 @arg n 个 @arg value
+         * value可能引用链表中的元素，先复制一份，扩容搬家时就不会读到被移走的值
+         */
+        iterator insert(const_iterator position, size_type n, const T &value) {
+            return insert_imp(position, n, value, Readable::true_type());
+        }
+
+        template<typename InputItOrIntegral>
+        iterator insert(const_iterator position, InputItOrIntegral first, InputItOrIntegral last) {
+            return insert_imp(position, first, last, Readable::is_integral<InputItOrIntegral>());
+        }
+
+        iterator insert(const_iterator position, std::initializer_list<T> init_list) {
+            return insert(position, init_list.begin(), init_list.end());
+        }
+
+        template<typename... Args>
+        void emplace_back(Args &&... args) {
+            emplace(end(), std::forward<Args>(args)...);
+        }
+
+        template<typename... Args>
+        void emplace_front(Args &&... args) {
+            emplace(begin(), std::forward<Args>(args)...);
+        }
+
+        void push_back(const T &value) {
+            emplace(end(), value);
+        }
+
+        void push_back(T &&value) {
+            emplace(end(), std::move(value));
+        }
+
+        void push_front(const T &value) {
+            emplace(begin(), value);
+        }
+
+        void push_front(T &&value) {
+            emplace(begin(), std::move(value));
+        }
+
+        iterator erase(const_iterator position) {
+            index_type index = position.index;
+            index_type after = slots[index].next;
+            unlink(index);
+            Readable::destroy(slots[index].value());
+            release_slot(index);
+            --element_count;
+            return iterator(this, after);
+        }
+
+        iterator erase(const_iterator first, const_iterator last) {
+            while (first != last) {
+                first = erase(first);
+            }
+            return iterator(this, last.index);
+        }
+
+        void pop_back() {
+            erase(const_iterator(this, tail));
+        }
+
+        void pop_front() {
+            erase(const_iterator(this, head));
+        }
+
+        /**
+         * 删除所有元素并释放节点数组
+         */
+        void clear() noexcept {
+            Readable::vector<slot, slot_allocator> empty_slots;
+            slots.swap(empty_slots);
+            head = npos;
+            tail = npos;
+            free_head = npos;
+            element_count = 0;
+        }
+
+        /**
+         * 交换两个链表的节点数组
+         * @note 两个链表的迭代器都会失效：迭代器记录的是链表本身，不会随元素换到另一个链表
+         */
+        void swap(index_list &other) noexcept {
+            slots.swap(other.slots);
+            std::swap(head, other.head);
+            std::swap(tail, other.tail);
+            std::swap(free_head, other.free_head);
+            std::swap(element_count, other.element_count);
+        }
+
+        // list operations:
+        /**
+         * 把 @arg it 处的元素移到 @arg position 之前
+         */
+        void splice(const_iterator position, const_iterator it) {
+            if (position.index == it.index || position.index == slots[it.index].next) {
+                return;
+            }
+            unlink(it.index);
+            link_before(position.index, it.index);
+        }
+
+        /**
+         * 把[first, last)移到 @arg position 之前，position不能在[first, last)中
+         */
+        void splice(const_iterator position, const_iterator first, const_iterator last) {
+            if (first == last || position == last) {
+                return;
+            }
+            index_type first_index = first.index;
+            index_type last_index = prev_of(last.index);
+            // 摘下[first_index, last_index]
+            index_type before = slots[first_index].prev;
+            next_link(before) = last.index;
+            prev_link(last.index) = before;
+            // 接到position之前
+            index_type position_before = prev_of(position.index);
+            slots[first_index].prev = position_before;
+            next_link(position_before) = first_index;
+            slots[last_index].next = position.index;
+            prev_link(position.index) = last_index;
+        }
+
+        /**
+         * 把 @arg other 的所有元素移到 @arg position 之前，之后other为空
+         * 节点不能离开other的数组，所以元素被逐个移动到本链表的新节点中，再清空other
+         */
+        void splice(const_iterator position, index_list &other) {
+            if (&other == this || other.empty()) {
+                return;
+            }
+            iterator first_inserted(this, position.index);
+            bool inserted_any = false;
+            try {
+                for (auto it = other.begin(); it != other.end(); ++it) {
+                    auto inserted = emplace_in_new_slot(position, std::move(*it));
+                    if (!inserted_any) {
+                        first_inserted = inserted;
+                        inserted_any = true;
+                    }
+                }
+            } catch (...) {
+                erase(first_inserted, position);
+                throw;
+            }
+            other.clear();
+        }
+
+        void splice(const_iterator position, index_list &&other) {
+            splice(position, other);
+        }
+
+        template<typename UnaryPredicate>
+        void remove_if(UnaryPredicate pred) {
+            for (auto it = begin(); it != end();) {
+                if (pred(*it)) {
+                    it = erase(it);
+                } else {
+                    ++it;
+                }
+            }
+        }
+
+        void remove(const T &value) {
+            remove_if([&value](const T &element) { return element == value; });
+        }
+
+        void unique() {
+            unique([](const T &a, const T &b) { return a == b; });
+        }
+
+        /**
+         * 删除连续的相等元素中除第一个以外的元素
+         */
+        template<typename BinaryPredicate>
+        void unique(BinaryPredicate binary_pred) {
+            if (element_count < 2) {
+                return;
+            }
+            auto kept = begin();
+            for (auto it = Readable::next(kept); it != end();) {
+                if (binary_pred(*kept, *it)) {
+                    it = erase(it);
+                } else {
+                    kept = it;
+                    ++it;
+                }
+            }
+        }
+
+        void merge(index_list &other) {
+            merge(other, less<T>());
+        }
+
+        void merge(index_list &&other) {
+            merge(other, less<T>());
+        }
+
+        /**
+         * 把有序的 @arg other 归并进有序的本链表，归并后 @arg other 为空；相等的元素中本链表的在前
+         * 和splice(position, other)一样，other的元素被移动到本链表的新节点中
+         */
+        template<typename Compare>
+        void merge(index_list &other, Compare comp) {
+            if (&other == this) {
+                return;
+            }
+            auto this_it = begin();
+            auto other_it = other.begin();
+            while (this_it != end() && other_it != other.end()) {
+                if (comp(*other_it, *this_it)) {
+                    emplace_in_new_slot(this_it, std::move(*other_it));
+                    ++other_it;
+                } else {
+                    ++this_it;
+                }
+            }
+            for (; other_it != other.end(); ++other_it) {
+                emplace_in_new_slot(end(), std::move(*other_it));
+            }
+            other.clear();
+        }
+
+        template<typename Compare>
+        void merge(index_list &&other, Compare comp) {
+            merge(other, comp);
+        }
+
+        void reverse() noexcept {
+            index_type cursor = head;
+            while (cursor != npos) {
+                index_type after = slots[cursor].next;
+                slots[cursor].next = slots[cursor].prev;
+                slots[cursor].prev = after;
+                cursor = after;
+            }
+            std::swap(head, tail);
+        }
+
+        void sort() {
+            sort(less<T>());
+        }
+
+        /**
+         * 稳定排序
+         * 把节点下标收集到数组中做自底向上的归并排序，再一遍重建链接，元素不移动，迭代器仍然有效
+         * 需要两个size()大小的32位下标数组
+         */
+        template<typename Compare>
+        void sort(Compare comp) {
+            if (element_count < 2) {
+                return;
+            }
+            Readable::vector<index_type> order;
+            order.reserve(element_count);
+            for (auto cursor = head; cursor != npos; cursor = slots[cursor].next) {
+                order.push_back(cursor);
+            }
+            Readable::vector<index_type> buffer(order.size());
+            auto index_less = [this, &comp](index_type a, index_type b) {
+                return comp(*slots[a].value(), *slots[b].value());
+            };
+            size_type n = order.size();
+            index_type *from = order.begin();
+            index_type *to = buffer.begin();
+            for (size_type width = 1; width < n; width *= 2) {
+                for (size_type left = 0; left < n; left += 2 * width) {
+                    size_type middle = left + width < n ? left + width : n;
+                    size_type right = left + 2 * width < n ? left + 2 * width : n;
+                    size_type i = left, j = middle, k = left;
+                    while (i < middle && j < right) {
+                        // 相等时取左边的，保证稳定
+                        to[k++] = index_less(from[j], from[i]) ? from[j++] : from[i++];
+                    }
+                    while (i < middle) {
+                        to[k++] = from[i++];
+                    }
+                    while (j < right) {
+                        to[k++] = from[j++];
+                    }
+                }
+                std::swap(from, to);
+            }
+            if (from != order.begin()) {
+                order.swap(buffer);
+            }
+            relink_all(order);
+        }
+
+        /**
+         * 整理节点数组：按遍历顺序重新排列节点并去掉空闲节点，之后遍历就是顺序访问数组
+         * @note 所有迭代器、指针和引用都会失效
+         */
+        void defragment() {
+            Readable::vector<slot, slot_allocator> compacted;
+            compacted.reserve(element_count);
+            index_type position = 0;
+            for (auto cursor = head; cursor != npos; cursor = slots[cursor].next, ++position) {
+                compacted.push_back(std::move(slots[cursor]));
+                compacted[position].prev = position == 0 ? npos : position - 1;
+                compacted[position].next = position + 1 == element_count ? npos : position + 1;
+            }
+            slots.swap(compacted);
+            head = element_count ? 0 : npos;
+            tail = element_count ? static_cast<index_type>(element_count - 1) : npos;
+            free_head = npos;
+        }
+    };
+
+    template<typename T, typename Allocator>
+    const typename index_list<T, Allocator>::index_type index_list<T, Allocator>::npos;
+
+    template<typename T, typename Allocator>
+    const typename index_list<T, Allocator>::index_type index_list<T, Allocator>::free_mark;
+}
+
+#endif //STL_FROM_SCRATCH_INDEX_LIST_H
@@ -0,0 +1,295 @@
+#ifndef STL_FROM_SCRATCH_INTRUSIVE_FORWARD_LIST_H
+#define STL_FROM_SCRATCH_INTRUSIVE_FORWARD_LIST_H
+
+#include <cstddef>
+#include "../iterator/iterator.h"
+#include "../functional/functional.h"
+#include "./forward_list.h"
+#include "./linked_list_sort.h"
+#include "./intrusive_list.h"
+
+namespace Readable {
+    /**
+     * 侵入式单向链表的钩子
+     * 和intrusive_list_hook一样，元素继承它，用Tag区分同一个类型上的多个钩子
+     * 单向链表找不到前一个节点，无法在O(1)内从任意位置摘下，因此没有AutoUnlink
+     * @tparam Tag 区分同一个类型上的多个钩子
+     */
+    template<typename Tag = default_hook_tag>
+    struct intrusive_forward_list_hook : public forward_list_node_base {
+        typedef Tag tag_type;
+
+        intrusive_forward_list_hook() noexcept : forward_list_node_base() {
+            next = nullptr;
+        }
+
+        intrusive_forward_list_hook(const intrusive_forward_list_hook &) noexcept : intrusive_forward_list_hook() {}
+
+        intrusive_forward_list_hook &operator=(const intrusive_forward_list_hook &) noexcept {
+            return *this;
+        }
+    };
+
+    template<typename T, typename Hook, typename ReferenceType, typename PointerType>
+    struct intrusive_forward_list_iterator : public Readable::iterator<
+            Readable::forward_iterator_tag,
+            T,
+            std::ptrdiff_t,
+            PointerType,
+            ReferenceType
+    > {
+        typedef intrusive_forward_list_iterator<T, Hook, ReferenceType, PointerType> self_type;
+        typedef intrusive_forward_list_iterator<T, Hook, T &, T *> iterator_type;
+        typedef intrusive_forward_list_iterator<T, Hook, const T &, const T *> const_iterator_type;
+
+        forward_list_node_base *node;
+
+        explicit intrusive_forward_list_iterator(forward_list_node_base *n = nullptr) : node(n) {}
+
+        intrusive_forward_list_iterator(const iterator_type &other) : node(other.node) {}
+
+        intrusive_forward_list_iterator(const const_iterator_type &other) : node(other.node) {}
+
+        bool operator==(const self_type &other) const { return node == other.node; }
+
+        bool operator!=(const self_type &other) const { return node != other.node; }
+
+        ReferenceType operator*() const {
+            return *static_cast<T *>(static_cast<Hook *>(node));
+        }
+
+        PointerType operator->() const {
+            return Readable::addressof(operator*());
+        }
+
+        self_type &operator++() {
+            node = node->next;
+            return *this;
+        }
+
+        self_type operator++(int) {
+            self_type origin_this = *this;
+            node = node->next;
+            return origin_this;
+        }
+    };
+
+    /**
+     * 侵入式单向链表
+     * 每个元素只多带一个指针，适合只在头部进出的场合（空闲对象链、任务栈等）
+     * 链表不分配也不释放内存，元素由调用者管理生命周期，元素在链表中时不能析构
+     * @tparam T 元素类型，必须继承Hook
+     * @tparam Hook 使用的钩子
+     */
+    template<typename T, typename Hook = intrusive_forward_list_hook<> >
+    class intrusive_forward_list final {
+    public:
+        typedef T value_type;
+        typedef Hook hook_type;
+        typedef value_type &reference;
+        typedef const value_type &const_reference;
+        typedef intrusive_forward_list_iterator<T, Hook, T &, T *> iterator;
+        typedef intrusive_forward_list_iterator<T, Hook, const T &, const T *> const_iterator;
+        typedef std::size_t size_type;
+        typedef std::ptrdiff_t difference_type;
+    private:
+        forward_list_node_base node_before_begin;
+        size_type node_count;
+
+        static forward_list_node_base *to_node(T &value) {
+            return static_cast<Hook *>(Readable::addressof(value));
+        }
+
+        static T &to_value(forward_list_node_base *the_node) {
+            return *static_cast<T *>(static_cast<Hook *>(the_node));
+        }
+
+    public:
+        intrusive_forward_list() noexcept : node_before_begin(), node_count(0) {
+            node_before_begin.next = nullptr;
+        }
+
+        intrusive_forward_list(const intrusive_forward_list &) = delete;
+
+        intrusive_forward_list &operator=(const intrusive_forward_list &) = delete;
+
+        intrusive_forward_list(intrusive_forward_list &&other) noexcept : intrusive_forward_list() {
+            swap(other);
+        }
+
+        intrusive_forward_list &operator=(intrusive_forward_list &&other) noexcept {
+            if (&other != this) {
+                clear();
+                swap(other);
+            }
+            return *this;
+        }
+
+        ~intrusive_forward_list() {
+            clear();
+        }
+
+        // iterators:
+        iterator before_begin() noexcept {
+            return iterator(&node_before_begin);
+        }
+
+        const_iterator before_begin() const noexcept {
+            return const_iterator(const_cast<forward_list_node_base *>(&node_before_begin));
+        }
+
+        iterator begin() noexcept {
+            return iterator(node_before_begin.next);
+        }
+
+        const_iterator begin() const noexcept {
+            return const_iterator(node_before_begin.next);
+        }
+
+        iterator end() noexcept {
+            return iterator(nullptr);
+        }
+
+        const_iterator end() const noexcept {
+            return const_iterator(nullptr);
+        }
+
+        /**
+         * 由链表中的元素得到指向它的迭代器，O(1)
+         */
+        iterator iterator_to(T &value) noexcept {
+            return iterator(to_node(value));
+        }
+
+        // capacity:
+        bool empty() const noexcept {
+            return node_before_begin.next == nullptr;
+        }
+
+        size_type size() const noexcept {
+            return node_count;
+        }
+
+        // element access:
+        reference front() {
+            return to_value(node_before_begin.next);
+        }
+
+        const_reference front() const {
+            return to_value(node_before_begin.next);
+        }
+
+        // modifiers:
+        iterator insert_after(const_iterator position, T &value) noexcept {
+            forward_list_node_base *the_node = to_node(value);
+            the_node->next = position.node->next;
+            position.node->next = the_node;
+            ++node_count;
+            return iterator(the_node);
+        }
+
+        void push_front(T &value) noexcept {
+            insert_after(before_begin(), value);
+        }
+
+        /**
+         * 摘下 @arg position 之后的元素，不析构它
+         * @return 指向被摘下元素之后的迭代器
+         */
+        iterator erase_after(const_iterator position) noexcept {
+            forward_list_node_base *the_node = position.node->next;
+            position.node->next = the_node->next;
+            the_node->next = nullptr;
+            --node_count;
+            return iterator(position.node->next);
+        }
+
+        void pop_front() noexcept {
+            erase_after(before_begin());
+        }
+
+        void clear() noexcept {
+            auto cursor = node_before_begin.next;
+            while (cursor) {
+                auto next = cursor->next;
+                cursor->next = nullptr;
+                cursor = next;
+            }
+            node_before_begin.next = nullptr;
+            node_count = 0;
+        }
+
+        void swap(intrusive_forward_list &other) noexcept {
+            auto next = node_before_begin.next;
+            node_before_begin.next = other.node_before_begin.next;
+            other.node_before_begin.next = next;
+            auto count = node_count;
+            node_count = other.node_count;
+            other.node_count = count;
+        }
+
+        // list operations:
+        /**
+         * 把 @arg other 中的所有元素移到 @arg position 之后，需要找到other的最后一个元素
+         */
+        void splice_after(const_iterator position, intrusive_forward_list &other) noexcept {
+            if (&other == this || other.empty()) {
+                return;
+            }
+            forward_list_node_base *first = other.node_before_begin.next;
+            forward_list_node_base *last = first;
+            while (last->next) {
+                last = last->next;
+            }
+            last->next = position.node->next;
+            position.node->next = first;
+            node_count += other.node_count;
+            other.node_before_begin.next = nullptr;
+            other.node_count = 0;
+        }
+
+        void splice_after(const_iterator position, intrusive_forward_list &&other) noexcept {
+            splice_after(position, other);
+        }
+
+        /**
+         * 把 @arg other 中 @arg it 之后的那个元素移到 @arg position 之后
+         */
+        void splice_after(const_iterator position, intrusive_forward_list &other, const_iterator it) noexcept {
+            forward_list_node_base *the_node = it.node->next;
+            if (position.node == it.node || position.node == the_node) {
+                return;
+            }
+            it.node->next = the_node->next;
+            the_node->next = position.node->next;
+            position.node->next = the_node;
+            --other.node_count;
+            ++node_count;
+        }
+
+        void splice_after(const_iterator position, intrusive_forward_list &&other, const_iterator it) noexcept {
+            splice_after(position, other, it);
+        }
+
+        void sort() {
+            sort(less<T>());
+        }
+
+        /**
+         * 稳定排序，和forward_list::sort一样使用自底向上的自然归并排序，只修改指针
+         */
+        template<typename Compare>
+        void sort(Compare comp) {
+            if (!node_before_begin.next || !node_before_begin.next->next) {
+                return;
+            }
+            auto sorted = Readable::natural_merge_sort(node_before_begin.next,
+                                                       [&comp](forward_list_node_base *a, forward_list_node_base *b) {
+                                                           return comp(to_value(a), to_value(b));
+                                                       });
+            node_before_begin.next = sorted.head;
+        }
+    };
+}
+
+#endif //STL_FROM_SCRATCH_INTRUSIVE_FORWARD_LIST_H
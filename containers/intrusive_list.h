@@ -0,0 +1,467 @@
+#ifndef STL_FROM_SCRATCH_INTRUSIVE_LIST_H
+#define STL_FROM_SCRATCH_INTRUSIVE_LIST_H
+
+#include <cstddef>
+#include "../iterator/iterator.h"
+#include "../functional/functional.h"
+#include "./list.h"
+#include "./linked_list_sort.h"
+
+namespace Readable {
+    /**
+     * 默认的钩子标签，一个类型只需要放进一种链表时使用
+     */
+    struct default_hook_tag {
+    };
+
+    /**
+     * 侵入式链表的钩子
+     * 元素类型继承这个钩子（也就是在自己身上带一个list_node_base），intrusive_list直接把元素本身链起来，
+     * 不分配任何节点，也没有"节点 -> 元素"的额外一跳
+     *
+     * 一个对象要同时待在多个链表里时，继承多个用不同Tag区分的钩子即可
+     * 钩子不在任何链表中时prev、next都为nullptr
+     * 复制对象时不复制钩子的链接状态：副本总是不在任何链表中
+     * @tparam Tag 区分同一个类型上的多个钩子
+     * @tparam AutoUnlink 为true时，对象析构时自动从所在的链表中摘下；
+     *                    这种链表不能维护元素个数，size()需要O(n)
+     */
+    template<typename Tag = default_hook_tag, bool AutoUnlink = false>
+    struct intrusive_list_hook : public list_node_base {
+        typedef Tag tag_type;
+        static const bool auto_unlink = AutoUnlink;
+
+        intrusive_list_hook() noexcept : list_node_base() {
+            prev = nullptr;
+            next = nullptr;
+        }
+
+        intrusive_list_hook(const intrusive_list_hook &) noexcept : intrusive_list_hook() {}
+
+        intrusive_list_hook &operator=(const intrusive_list_hook &) noexcept {
+            return *this;
+        }
+
+        ~intrusive_list_hook() {
+            if (AutoUnlink) {
+                unlink();
+            }
+        }
+
+        bool is_linked() const noexcept {
+            return next != nullptr;
+        }
+
+        /**
+         * 从所在的链表中摘下，不在链表中时什么也不做
+         * 链表的元素个数不会更新，因此只应对AutoUnlink的钩子直接调用，否则请用intrusive_list::erase
+         */
+        void unlink() noexcept {
+            if (next) {
+                prev->next = next;
+                next->prev = prev;
+                prev = nullptr;
+                next = nullptr;
+            }
+        }
+    };
+
+    template<typename T, typename Hook, typename ReferenceType, typename PointerType>
+    struct intrusive_list_iterator : public Readable::iterator<
+            Readable::bidirectional_iterator_tag,
+            T,
+            std::ptrdiff_t,
+            PointerType,
+            ReferenceType
+    > {
+        typedef intrusive_list_iterator<T, Hook, ReferenceType, PointerType> self_type;
+        typedef intrusive_list_iterator<T, Hook, T &, T *> iterator_type;
+        typedef intrusive_list_iterator<T, Hook, const T &, const T *> const_iterator_type;
+
+        list_node_base *node;
+
+        intrusive_list_iterator() = default;
+
+        explicit intrusive_list_iterator(list_node_base *n) : node(n) {}
+
+        intrusive_list_iterator(const iterator_type &other) : node(other.node) {}
+
+        intrusive_list_iterator(const const_iterator_type &other) : node(other.node) {}
+
+        bool operator==(const self_type &other) const { return node == other.node; }
+
+        bool operator!=(const self_type &other) const { return node != other.node; }
+
+        ReferenceType operator*() const {
+            return *static_cast<T *>(static_cast<Hook *>(node));
+        }
+
+        PointerType operator->() const {
+            return Readable::addressof(operator*());
+        }
+
+        self_type &operator++() {
+            node = node->next;
+            return *this;
+        }
+
+        self_type operator++(int) {
+            self_type origin_this = *this;
+            node = node->next;
+            return origin_this;
+        }
+
+        self_type &operator--() {
+            node = node->prev;
+            return *this;
+        }
+
+        self_type operator--(int) {
+            self_type origin_this = *this;
+            node = node->prev;
+            return origin_this;
+        }
+    };
+
+    /**
+     * 侵入式双向链表
+     * 元素由调用者管理生命周期（比如放在对象池里），链表只负责把它们链起来：
+     * 插入、删除都不分配也不释放内存，删除只是把元素摘下来
+     * 元素不能同时在两个使用同一个钩子的链表中；元素在链表中时不能析构（AutoUnlink的钩子除外）
+     * @tparam T 元素类型，必须继承Hook
+     * @tparam Hook 使用的钩子
+     */
+    template<typename T, typename Hook = intrusive_list_hook<> >
+    class intrusive_list final {
+    public:
+        typedef T value_type;
+        typedef Hook hook_type;
+        typedef value_type &reference;
+        typedef const value_type &const_reference;
+        typedef intrusive_list_iterator<T, Hook, T &, T *> iterator;
+        typedef intrusive_list_iterator<T, Hook, const T &, const T *> const_iterator;
+        typedef std::size_t size_type;
+        typedef std::ptrdiff_t difference_type;
+        typedef Readable::reverse_iterator<iterator> reverse_iterator;
+        typedef Readable::reverse_iterator<const_iterator> const_reverse_iterator;
+    private:
+        list_node_base node;
+        // 元素个数，AutoUnlink时元素可能在链表不知情时离开，这个值不使用
+        size_type node_count;
+
+        static list_node_base *to_node(T &value) {
+            return static_cast<Hook *>(Readable::addressof(value));
+        }
+
+        static T &to_value(list_node_base *the_node) {
+            return *static_cast<T *>(static_cast<Hook *>(the_node));
+        }
+
+        /**
+         * 把[first, last]这一段链接到 @arg position 之前，这一段应当已经从原来的链上摘下
+         */
+        static void link_range(list_node_base *position, list_node_base *first, list_node_base *last) {
+            first->prev = position->prev;
+            last->next = position;
+            position->prev->next = first;
+            position->prev = last;
+        }
+
+    public:
+        intrusive_list() noexcept : node(), node_count(0) {
+            node.prev = &node;
+            node.next = &node;
+        }
+
+        template<typename InputIterator>
+        intrusive_list(InputIterator first, InputIterator last) : intrusive_list() {
+            for (; first != last; ++first) {
+                push_back(*first);
+            }
+        }
+
+        intrusive_list(const intrusive_list &) = delete;
+
+        intrusive_list &operator=(const intrusive_list &) = delete;
+
+        intrusive_list(intrusive_list &&other) noexcept : intrusive_list() {
+            splice(end(), other);
+        }
+
+        intrusive_list &operator=(intrusive_list &&other) noexcept {
+            if (&other != this) {
+                clear();
+                splice(end(), other);
+            }
+            return *this;
+        }
+
+        /**
+         * 析构时摘下所有元素，元素本身不受影响
+         */
+        ~intrusive_list() {
+            clear();
+        }
+
+        // iterators:
+        iterator begin() noexcept {
+            return iterator(node.next);
+        }
+
+        const_iterator begin() const noexcept {
+            return const_iterator(node.next);
+        }
+
+        iterator end() noexcept {
+            return iterator(&node);
+        }
+
+        const_iterator end() const noexcept {
+            return const_iterator(const_cast<list_node_base *>(&node));
+        }
+
+        const_iterator cbegin() const noexcept {
+            return begin();
+        }
+
+        const_iterator cend() const noexcept {
+            return end();
+        }
+
+        reverse_iterator rbegin() noexcept {
+            return reverse_iterator(end());
+        }
+
+        const_reverse_iterator rbegin() const noexcept {
+            return const_reverse_iterator(end());
+        }
+
+        reverse_iterator rend() noexcept {
+            return reverse_iterator(begin());
+        }
+
+        const_reverse_iterator rend() const noexcept {
+            return const_reverse_iterator(begin());
+        }
+
+        /**
+         * 由链表中的元素得到指向它的迭代器，O(1)
+         */
+        iterator iterator_to(T &value) noexcept {
+            return iterator(to_node(value));
+        }
+
+        const_iterator iterator_to(const T &value) const noexcept {
+            return const_iterator(to_node(const_cast<T &>(value)));
+        }
+
+        // capacity:
+        bool empty() const noexcept {
+            return node.next == &node;
+        }
+
+        /**
+         * 元素个数，钩子是AutoUnlink时需要遍历整个链表
+         */
+        size_type size() const noexcept {
+            if (Hook::auto_unlink) {
+                size_type count = 0;
+                for (auto cursor = node.next; cursor != &node; cursor = cursor->next) {
+                    ++count;
+                }
+                return count;
+            }
+            return node_count;
+        }
+
+        // element access:
+        reference front() {
+            return to_value(node.next);
+        }
+
+        const_reference front() const {
+            return to_value(node.next);
+        }
+
+        reference back() {
+            return to_value(node.prev);
+        }
+
+        const_reference back() const {
+            return to_value(node.prev);
+        }
+
+        // modifiers:
+        /**
+         * 把 @arg value 链接到 @arg position 之前，value不能已经在使用同一个钩子的链表中
+         */
+        iterator insert(const_iterator position, T &value) noexcept {
+            list_node_base *the_node = to_node(value);
+            link_range(position.node, the_node, the_node);
+            ++node_count;
+            return iterator(the_node);
+        }
+
+        void push_back(T &value) noexcept {
+            insert(end(), value);
+        }
+
+        void push_front(T &value) noexcept {
+            insert(begin(), value);
+        }
+
+        /**
+         * 摘下 @arg position 处的元素，不析构它
+         * @return 指向下一个元素的迭代器
+         */
+        iterator erase(const_iterator position) noexcept {
+            list_node_base *the_node = position.node;
+            list_node_base *next = the_node->next;
+            the_node->prev->next = next;
+            next->prev = the_node->prev;
+            the_node->prev = nullptr;
+            the_node->next = nullptr;
+            --node_count;
+            return iterator(next);
+        }
+
+        iterator erase(const_iterator first, const_iterator last) noexcept {
+            while (first != last) {
+                first = erase(first);
+            }
+            return iterator(last.node);
+        }
+
+        /**
+         * 摘下 @arg value，它必须在本链表中
+         */
+        void remove(T &value) noexcept {
+            erase(iterator_to(value));
+        }
+
+        void pop_front() noexcept {
+            erase(begin());
+        }
+
+        void pop_back() noexcept {
+            erase(iterator(node.prev));
+        }
+
+        /**
+         * 摘下所有元素，使它们的钩子回到不在链表中的状态
+         */
+        void clear() noexcept {
+            auto cursor = node.next;
+            while (cursor != &node) {
+                auto next = cursor->next;
+                cursor->prev = nullptr;
+                cursor->next = nullptr;
+                cursor = next;
+            }
+            node.prev = &node;
+            node.next = &node;
+            node_count = 0;
+        }
+
+        void swap(intrusive_list &other) noexcept {
+            intrusive_list temp;
+            temp.splice(temp.end(), other);
+            other.splice(other.end(), *this);
+            splice(end(), temp);
+        }
+
+        // list operations:
+        /**
+         * 把 @arg other 中的所有元素移到 @arg position 之前，O(1)
+         */
+        void splice(const_iterator position, intrusive_list &other) noexcept {
+            if (&other == this || other.empty()) {
+                return;
+            }
+            list_node_base *first = other.node.next;
+            list_node_base *last = other.node.prev;
+            other.node.next = &other.node;
+            other.node.prev = &other.node;
+            link_range(position.node, first, last);
+            node_count += other.node_count;
+            other.node_count = 0;
+        }
+
+        void splice(const_iterator position, intrusive_list &&other) noexcept {
+            splice(position, other);
+        }
+
+        /**
+         * 把 @arg other 中 @arg it 处的元素移到 @arg position 之前
+         */
+        void splice(const_iterator position, intrusive_list &other, const_iterator it) noexcept {
+            list_node_base *the_node = it.node;
+            if (position.node == the_node || position.node == the_node->next) {
+                return;
+            }
+            the_node->prev->next = the_node->next;
+            the_node->next->prev = the_node->prev;
+            link_range(position.node, the_node, the_node);
+            --other.node_count;
+            ++node_count;
+        }
+
+        void splice(const_iterator position, intrusive_list &&other, const_iterator it) noexcept {
+            splice(position, other, it);
+        }
+
+        /**
+         * 把 @arg other 中的[first, last)移到 @arg position 之前
+         * 两个链表不同且钩子不是AutoUnlink时需要数出移动的元素个数
+         */
+        void splice(const_iterator position, intrusive_list &other,
+                    const_iterator first, const_iterator last) noexcept {
+            if (first == last || position == last) {
+                return;
+            }
+            if (&other != this && !Hook::auto_unlink) {
+                size_type moved_count = static_cast<size_type>(Readable::distance(first, last));
+                other.node_count -= moved_count;
+                node_count += moved_count;
+            }
+            list_node_base *first_node = first.node;
+            list_node_base *last_node = last.node->prev;
+            first_node->prev->next = last.node;
+            last.node->prev = first_node->prev;
+            link_range(position.node, first_node, last_node);
+        }
+
+        void splice(const_iterator position, intrusive_list &&other,
+                    const_iterator first, const_iterator last) noexcept {
+            splice(position, other, first, last);
+        }
+
+        void sort() {
+            sort(less<T>());
+        }
+
+        /**
+         * 稳定排序，和list::sort一样使用自底向上的自然归并排序，只修改指针
+         */
+        template<typename Compare>
+        void sort(Compare comp) {
+            if (node.next == &node || node.next->next == &node) {
+                return;
+            }
+            node.prev->next = nullptr;
+            auto sorted = Readable::natural_merge_sort(node.next, [&comp](list_node_base *a, list_node_base *b) {
+                return comp(to_value(a), to_value(b));
+            });
+            list_node_base *prev = &node;
+            for (auto cursor = sorted.head; cursor; cursor = cursor->next) {
+                cursor->prev = prev;
+                prev = cursor;
+            }
+            node.next = sorted.head;
+            prev->next = &node;
+            node.prev = prev;
+        }
+    };
+}
+
+#endif //STL_FROM_SCRATCH_INTRUSIVE_LIST_H
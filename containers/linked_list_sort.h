@@ -0,0 +1,157 @@
+#ifndef STL_FROM_SCRATCH_LINKED_LIST_SORT_H
+#define STL_FROM_SCRATCH_LINKED_LIST_SORT_H
+
+#include <cstddef>
+
+namespace Readable {
+    /**
+     * 链表排序的公共部分，list和forward_list都只需要把节点串成以nullptr结尾的单链再交给这里
+     *
+     * 采用自底向上的自然归并排序：
+     * 1. 从头开始切出一段段已经有序的"自然段"（严格降序的段就地反转成升序），已经有序的输入只会切出一段
+     * 2. 像二进制加法进位一样把段放进bins：bins[i]中的段由2^i个自然段归并而来，
+     *    放入时如果bins[i]已经有段，就和它归并后进位到bins[i+1]（SGI STL的list::sort也是这个思路）
+     * 3. 最后把所有bins归并起来
+     * 整个过程不递归、不需要为找中点而重新遍历，额外空间只有64个bins
+     * 归并时总是让较早的段在前，因此排序是稳定的
+     */
+    template<typename NodeBase>
+    struct linked_run {
+        NodeBase *head;
+        NodeBase *tail;
+    };
+
+    /**
+     * 归并两段有序的单链，@arg first 中的元素在原序列中位于 @arg second 之前
+     * @param less 比较两个节点的函数
+     * @return 归并后的段
+     */
+    template<typename NodeBase, typename NodeLess>
+    linked_run<NodeBase> merge_linked_runs(linked_run<NodeBase> first, linked_run<NodeBase> second, NodeLess &less) {
+        if (!first.head) {
+            return second;
+        } else if (!second.head) {
+            return first;
+        }
+        // 两段本来就首尾相接有序，直接连起来
+        if (!less(second.head, first.tail)) {
+            first.tail->next = second.head;
+            return {first.head, second.tail};
+        }
+        NodeBase before_head;
+        NodeBase *tail = &before_head;
+        NodeBase *a = first.head;
+        NodeBase *b = second.head;
+        while (a && b) {
+            // 相等时取first中的，保证稳定
+            if (less(b, a)) {
+                tail->next = b;
+                tail = b;
+                b = b->next;
+            } else {
+                tail->next = a;
+                tail = a;
+                a = a->next;
+            }
+        }
+        // 剩下的一整段直接接上
+        if (a) {
+            tail->next = a;
+            return {before_head.next, first.tail};
+        }
+        tail->next = b;
+        return {before_head.next, second.tail};
+    }
+
+    /**
+     * 归并两条以nullptr结尾的有序单链，不需要知道链尾
+     * 相等时先取 @arg first 中的节点，因此是稳定的
+     * @return 归并后的链的第一个节点
+     */
+    template<typename NodeBase, typename NodeLess>
+    NodeBase *merge_linked_chains(NodeBase *first, NodeBase *second, NodeLess &less) {
+        NodeBase before_head;
+        NodeBase *tail = &before_head;
+        while (first && second) {
+            if (less(second, first)) {
+                tail->next = second;
+                tail = second;
+                second = second->next;
+            } else {
+                tail->next = first;
+                tail = first;
+                first = first->next;
+            }
+        }
+        // 剩下的一整段直接接上
+        tail->next = first ? first : second;
+        return before_head.next;
+    }
+
+    /**
+     * 从 @arg head 开始切出一段自然段，并把 @arg head 移动到剩余部分的开头
+     */
+    template<typename NodeBase, typename NodeLess>
+    linked_run<NodeBase> cut_natural_run(NodeBase *&head, NodeLess &less) {
+        NodeBase *run_head = head;
+        NodeBase *run_tail = head;
+        if (run_tail->next && less(run_tail->next, run_tail)) {
+            // 严格降序的段：边走边反转
+            // 只反转严格降序的段，相等的元素不会被交换次序
+            NodeBase *rest = run_tail->next;
+            run_tail->next = nullptr;
+            while (rest && less(rest, run_head)) {
+                NodeBase *next_of_rest = rest->next;
+                rest->next = run_head;
+                run_head = rest;
+                rest = next_of_rest;
+            }
+            head = rest;
+            return {run_head, run_tail};
+        }
+        while (run_tail->next && !less(run_tail->next, run_tail)) {
+            run_tail = run_tail->next;
+        }
+        head = run_tail->next;
+        run_tail->next = nullptr;
+        return {run_head, run_tail};
+    }
+
+    /**
+     * 对以nullptr结尾的节点链进行稳定排序
+     * @tparam NodeBase 有next成员的节点类型
+     * @param head 链的第一个节点
+     * @param less 比较两个节点的函数
+     * @return 排序后的链
+     */
+    template<typename NodeBase, typename NodeLess>
+    linked_run<NodeBase> natural_merge_sort(NodeBase *head, NodeLess less) {
+        const std::size_t bin_count = 64;
+        linked_run<NodeBase> bins[bin_count];
+        for (std::size_t i = 0; i < bin_count; ++i) {
+            bins[i] = {nullptr, nullptr};
+        }
+        std::size_t used_bins = 0;
+        while (head) {
+            linked_run<NodeBase> carry = cut_natural_run(head, less);
+            std::size_t i = 0;
+            for (; i < bin_count - 1 && bins[i].head; ++i) {
+                // bins[i]中的段更早，放在前面
+                carry = merge_linked_runs(bins[i], carry, less);
+                bins[i] = {nullptr, nullptr};
+            }
+            bins[i] = merge_linked_runs(bins[i], carry, less);
+            if (i + 1 > used_bins) {
+                used_bins = i + 1;
+            }
+        }
+        linked_run<NodeBase> result = {nullptr, nullptr};
+        for (std::size_t i = 0; i < used_bins; ++i) {
+            // 越高的bin中的段越早
+            result = merge_linked_runs(bins[i], result, less);
+        }
+        return result;
+    }
+}
+
+#endif //STL_FROM_SCRATCH_LINKED_LIST_SORT_H
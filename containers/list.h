@@ -9,7 +9,10 @@
 #include "../type_traits/type_traits.h"
 #include "../functional/functional.h"
 #include "../utility/utility.h"
+#include "../memory/node_slab.h"
+#include "./linked_list_sort.h"
 #include <cstdint>
+#include <type_traits>
 
 namespace Readable {
     struct list_node_base {
@@ -84,6 +87,12 @@ namespace Readable {
     };
 
 
+    /**
+     * 双向链表
+     * 由已知长度的区间构造或插入较多元素时，所有节点放在一个节点块中（见node_slab.h），只分配一次内存
+     * 块中最后一个节点被删除时整块内存就归还，不管这时节点在哪个list中；splice不需要额外的工作
+     * 不同的list可以在不同的线程上使用，即使它们之间splice过节点
+     */
     template<class T, class Allocator = allocator <T> >
     class list final {
     public:
@@ -105,36 +114,33 @@ namespace Readable {
         typedef list<T, Allocator> self_type;
         typedef list_node<T> node_type;
         typedef typename allocator_type::template rebind<node_type>::other node_allocator;
+        typedef node_slab_allocator<node_type, allocator_type> slab_allocator;
         list_node_base node;
+        // 元素个数，使size()为O(1)
+        size_type node_count;
     public:
-        explicit list(const Allocator & = Allocator()) : node() {
+        explicit list(const Allocator & = Allocator()) : node(), node_count(0) {
             node.prev = &node;
             node.next = &node;
         }
 
         explicit list(size_type n, const Allocator & = Allocator()) : list() {
-            for (size_t _ = 0; _ < n; ++_) {
-                emplace_back();
-            }
+            insert_constructed(end(), n, [](T *where) {
+                allocator_type::construct(where);
+            });
         }
 
         list(size_type n, const T &value, const Allocator & = Allocator()) : list() {
-            for (size_t i = 0; i < n; ++i) {
-                push_back(value);
-            }
+            insert(end(), n, value);
         }
 
         template<class InputIterator>
         list(InputIterator first, InputIterator last, const Allocator & = Allocator()) : list() {
-            for (auto it = first; it != last; ++it) {
-                push_back(*it);
-            }
+            insert(end(), first, last);
         }
 
         list(const list<T, Allocator> &x) : list() {
-            for (auto &item: x) {
-                push_back(x);
-            }
+            insert(end(), x.begin(), x.end());
         }
 
         list(list &&other) noexcept : list() {
@@ -147,9 +153,7 @@ namespace Readable {
         list(list &&other, const Allocator &alloc) : list(other) {}
 
         list(std::initializer_list<T> init_list, const Allocator & = Allocator()) : list() {
-            for (auto &it:init_list) {
-                push_back(it);
-            }
+            insert(end(), init_list.begin(), init_list.end());
         }
 
         ~list() {
@@ -162,7 +166,10 @@ namespace Readable {
         }
 
         list<T, Allocator> &operator=(list<T, Allocator> &&x) noexcept {
-            node = std::move(x.node);
+            if (&x != this) {
+                clear();
+                splice(end(), x);
+            }
             return *this;
         }
 
@@ -195,9 +202,9 @@ namespace Readable {
             }
         }
 
-        void assign(size_type element_count, const T &value) {
+        void assign(size_type count, const T &value) {
             clear();
-            insert(begin(), element_count, value);
+            insert(begin(), count, value);
         }
 
         void assign(std::initializer_list<T> ilist) {
@@ -222,7 +229,7 @@ namespace Readable {
         }
 
         const_iterator end() const noexcept {
-            return const_iterator(&node);
+            return const_iterator(const_cast<list_node_base *>(&node));
         }
 
         reverse_iterator rbegin() noexcept {
@@ -246,7 +253,7 @@ namespace Readable {
         }
 
         const_iterator cend() const noexcept {
-            return const_iterator(&node);
+            return const_iterator(const_cast<list_node_base *>(&node));
         }
 
         const_reverse_iterator crbegin() const noexcept {
@@ -259,7 +266,7 @@ namespace Readable {
 
         // capacity:
         size_type size() const noexcept {
-            return distance(begin(), end());
+            return node_count;
         }
 
         size_type max_size() const noexcept {
@@ -331,7 +338,7 @@ namespace Readable {
         static list_node_base *create_node(T &&value) {
             node_type *new_node = node_allocator::allocate(1);
             try {
-                Readable::construct(&new_node->data, value);
+                allocator_type::construct(&new_node->data, std::move(value));
             } catch (...) {
                 // rollback
                 node_allocator::deallocate(new_node, 1);
@@ -340,9 +347,17 @@ namespace Readable {
             return (list_node_base *) (new_node);
         }
 
-        static void destroy_node(node_type *node) {
-            Readable::destroy(&node->data);
-            node_allocator::deallocate(node, 1);
+        /**
+         * 节点块中的节点只析构元素，并减少块的存活节点数，内存随整个块释放
+         */
+        static void destroy_node(node_type *the_node) noexcept {
+            Readable::destroy(&the_node->data);
+            node_slab *slab = node_slab::find(the_node);
+            if (slab) {
+                slab->release_node();
+            } else {
+                node_allocator::deallocate(the_node, 1);
+            }
         }
 
     public:
@@ -368,16 +383,17 @@ namespace Readable {
         }
 
         void pop_back() {
-            erase(end());
+            erase(--end());
         }
 
     private:
-        iterator insert_node(const_iterator &position, list_node_base *new_node) const {
+        iterator insert_node(const_iterator &position, list_node_base *new_node) {
             auto last_node = position.node->prev;
             last_node->next = new_node;
             new_node->prev = last_node;
             new_node->next = position.node;
             position.node->prev = new_node;
+            ++node_count;
             return iterator(new_node);
         }
 
@@ -394,33 +410,129 @@ namespace Readable {
         }
 
         iterator insert(const_iterator position, T &&x) {
-            auto new_node = create_node(x);
+            auto new_node = create_node(std::move(x));
             return insert_node(position, new_node);
         }
 
     private:
-        iterator
-        insert_imp(const_iterator position, size_type element_to_insert_count, const T &value, Readable::true_type) {
-            size_type i = 0;
+        /**
+         * 在 @arg position 之前插入 @arg n 个元素，依次调用 @arg construct_data 构造每个元素
+         * 节点足够多时放在一个节点块中，只分配一次内存，节点在内存中也是相邻的；否则逐个分配节点
+         * 某个元素构造失败时删除已经插入的元素后重新抛出异常
+         * @param construct_data 以元素的地址为参数，在那里构造一个元素
+         * @return 指向第一个新元素的迭代器，n为0时返回position
+         */
+        template<typename ConstructData>
+        iterator insert_constructed(const_iterator position, size_type n, ConstructData construct_data) {
+            if (n == 0) {
+                return iterator(position.node);
+            }
+            node_slab *slab = slab_allocator::create(n);
+            if (slab) {
+                size_type built = 0;
+                try {
+                    for (; built < n; ++built) {
+                        construct_data(&slab_allocator::node_at(slab, built)->data);
+                    }
+                } catch (...) {
+                    for (size_type i = 0; i < built; ++i) {
+                        Readable::destroy(&slab_allocator::node_at(slab, i)->data);
+                    }
+                    slab_allocator::destroy(slab);
+                    throw;
+                }
+                return link_slab(position, slab, n);
+            }
+            iterator first_inserted(position.node);
             try {
-                for (; i < element_to_insert_count; ++i) {
-                    insert(position, value);
+                for (size_type i = 0; i < n; ++i) {
+                    node_type *new_node = node_allocator::allocate(1);
+                    try {
+                        construct_data(&new_node->data);
+                    } catch (...) {
+                        node_allocator::deallocate(new_node, 1);
+                        throw;
+                    }
+                    auto inserted = insert_node(position, new_node);
+                    if (i == 0) {
+                        first_inserted = inserted;
+                    }
                 }
             } catch (...) {
-                erase(next(position, -ptrdiff_t(i)), position);
+                erase(first_inserted, position);
+                throw;
+            }
+            return first_inserted;
+        }
+
+        /**
+         * 把 @arg slab 中的 @arg n 个节点按顺序链接到 @arg position 之前
+         * @return 指向第一个新节点的迭代器
+         */
+        iterator link_slab(const_iterator position, node_slab *slab, size_type n) {
+            list_node_base *prev = position.node->prev;
+            for (size_type i = 0; i < n; ++i) {
+                list_node_base *new_node = slab_allocator::node_at(slab, i);
+                prev->next = new_node;
+                new_node->prev = prev;
+                prev = new_node;
             }
-            return iterator(next(position, -ptrdiff_t(i)));
+            prev->next = position.node;
+            position.node->prev = prev;
+            node_count += n;
+            return iterator(slab_allocator::node_at(slab, 0));
+        }
+
+        iterator
+        insert_imp(const_iterator position, size_type element_to_insert_count, const T &value, Readable::true_type) {
+            return insert_constructed(position, element_to_insert_count, [&value](T *where) {
+                Readable::construct(where, value);
+            });
         }
 
         template<typename InputIterator>
         iterator insert_imp(const_iterator position, InputIterator first,
                             InputIterator last, Readable::false_type) {
-            const_iterator now_should_insert_before(position.node);
-            while (first != last) {
-                now_should_insert_before = const_iterator(insert(now_should_insert_before, *first));
+            typedef typename Readable::iterator_traits<InputIterator>::iterator_category category;
+            return insert_range(position, first, last,
+                                Readable::integral_constant<bool, std::is_convertible<
+                                        category, Readable::forward_iterator_tag>::value>());
+        }
+
+        /**
+         * 前向迭代器：元素个数可以预先算出，节点足够多时放在一个节点块中
+         */
+        template<typename ForwardIterator>
+        iterator insert_range(const_iterator position, ForwardIterator first, ForwardIterator last,
+                              Readable::true_type) {
+            auto n = static_cast<size_type>(Readable::distance(first, last));
+            return insert_constructed(position, n, [&first](T *where) {
+                Readable::construct(where, *first);
                 ++first;
+            });
+        }
+
+        /**
+         * 输入迭代器只能遍历一次，只能逐个插入；插入失败时删除已经插入的元素
+         */
+        template<typename InputIterator>
+        iterator insert_range(const_iterator position, InputIterator first, InputIterator last,
+                              Readable::false_type) {
+            iterator first_inserted(position.node);
+            bool inserted_any = false;
+            try {
+                for (; first != last; ++first) {
+                    auto inserted = insert(position, *first);
+                    if (!inserted_any) {
+                        first_inserted = inserted;
+                        inserted_any = true;
+                    }
+                }
+            } catch (...) {
+                erase(first_inserted, position);
+                throw;
             }
-            return iterator(now_should_insert_before);
+            return first_inserted;
         }
 
     public:
@@ -444,6 +556,7 @@ namespace Readable {
             prev->next = next;
             next->prev = prev;
             destroy_node((node_type *) position.node);
+            --node_count;
             return iterator(next);
         }
 
@@ -453,10 +566,13 @@ namespace Readable {
             return last;
         }
 
-        void swap(list<T, Allocator> &other) {
-            auto temp = node;
-            node = other.node;
-            other.node = temp;
+        void swap(list<T, Allocator> &other) noexcept {
+            // 哨兵节点的地址不能交换，只能交换哨兵的链接，再让首尾节点指回新的哨兵
+            std::swap(node.prev, other.node.prev);
+            std::swap(node.next, other.node.next);
+            std::swap(node_count, other.node_count);
+            relink_sentinel();
+            other.relink_sentinel();
         }
 
         void clear() noexcept {
@@ -468,57 +584,103 @@ namespace Readable {
             }
             node.next = &node;
             node.prev = &node;
+            node_count = 0;
+        }
+
+    private:
+        /**
+         * 哨兵的链接被换成别的list的之后，让首尾节点指回本list的哨兵；空链表的链接指回自己
+         */
+        void relink_sentinel() noexcept {
+            if (node_count == 0) {
+                node.prev = &node;
+                node.next = &node;
+            } else {
+                node.next->prev = &node;
+                node.prev->next = &node;
+            }
         }
 
+        /**
+         * 元素在两个list之间移动时更新双方的元素个数
+         */
+        void transfer_count(list<T, Allocator> &from, size_type count) {
+            if (&from != this) {
+                from.node_count -= count;
+                node_count += count;
+            }
+        }
+
+    public:
         // list operations:
         void splice(const_iterator position, list<T, Allocator> &other) {
-            if (other == *this)
+            if (&other == this || other.empty())
                 return;
-            splice(position, other, other.begin(), other.end());
+            // 整个other都移过来，个数已知，无需再数
+            size_type count = other.node_count;
+            splice_range(position, other.begin(), other.end());
+            transfer_count(other, count);
         }
 
         void splice(const_iterator position, list<T, Allocator> &&other) {
-            auto other_first = other.node.next;
-            auto other_last = other.node.prev;
-
-            position.prev.next = other_first;
-            other_first->prev = position.node.prev;
-
-            other_last->next = position.node;
-            position.node->prev = other_last;
+            splice(position, other);
         }
 
-        void splice(const_iterator position, list<T, Allocator> &,
+        void splice(const_iterator position, list<T, Allocator> &other,
                     const_iterator item) {
+            if (position == item || position.node == item.node->next) {
+                // 已经在目标位置上了
+                return;
+            }
+            splice_node(position, other, item);
+        }
 
-            auto before_item = item.node->prev;
-            auto after_item = item.node->next;
-            auto before_position = position.node->prev;
+        void splice(const_iterator position, list<T, Allocator> &&other,
+                    const_iterator item) {
+            splice(position, other, item);
+        }
 
-            before_item->next = after_item;
-            after_item->prev = before_item;
+        void splice(const_iterator position, list<T, Allocator> &other,
+                    const_iterator first, const_iterator last) {
+            // 只有在两个list之间移动时才需要数一遍移动了多少个元素
+            if (&other != this) {
+                transfer_count(other, static_cast<size_type>(Readable::distance(first, last)));
+            }
+            splice_range(position, first, last);
+        }
 
-            before_position->next = item.node;
-            item.node->prev = before_position;
-            item.node->next = position.node;
-            position.node->prev = item.node;
+        void splice(const_iterator position, list<T, Allocator> &&other,
+                    const_iterator first, const_iterator last) {
+            splice(position, other, first, last);
         }
 
-        void splice(const_iterator position, list<T, Allocator> &&,
-                    const_iterator item) {
+    private:
+        /**
+         * 将 @arg item 从 @arg other 摘下并接到position之前
+         */
+        void splice_node(const_iterator position, list<T, Allocator> &other, const_iterator item) {
+            transfer_count(other, 1);
+
             auto before_item = item.node->prev;
             auto after_item = item.node->next;
             auto before_position = position.node->prev;
+
             before_item->next = after_item;
             after_item->prev = before_item;
+
             before_position->next = item.node;
             item.node->prev = before_position;
             item.node->next = position.node;
             position.node->prev = item.node;
         }
 
-        void splice(const_iterator position, list<T, Allocator> &,
-                    const_iterator first, const_iterator last) {
+        /**
+         * 将[first, last)摘下并接到position之前，不维护元素个数
+         */
+        static void splice_range(const_iterator position, const_iterator first, const_iterator last) {
+            if (first == last) {
+                return;
+            }
             auto before_first = first.node->prev;
             auto before_last = last.node->prev;
             auto before_position = position.node->prev;
@@ -531,18 +693,7 @@ namespace Readable {
             position.node->prev = before_last;
         }
 
-        void splice(const_iterator position, list<T, Allocator> &&,
-                    const_iterator first, const_iterator last) {
-            auto before_first = first.node->prev;
-            auto before_last = last.node->prev;
-            auto before_position = position.node->prev;
-            before_first->next = last.node;
-            last.node->prev = before_first;
-            before_position->next = first.node;
-            first.node->prev = before_position;
-            before_last->next = position.node;
-            position.node->prev = before_last;
-        }
+    public:
 
         void remove(const T &value) {
             for (auto it = begin(); it != end();) {
@@ -566,18 +717,18 @@ namespace Readable {
         }
 
         void unique() {
-            for (auto it = begin(); next(it) != end(); ++it) {
-                while (*it == *(next(it))) {
-                    erase(next(it));
+            for (auto it = begin(); it != end() && Readable::next(it) != end(); ++it) {
+                while (Readable::next(it) != end() && *it == *(Readable::next(it))) {
+                    erase(Readable::next(it));
                 }
             }
         }
 
         template<class BinaryPredicate>
         void unique(BinaryPredicate binary_pred) {
-            for (auto it = begin(); next(it) != end(); ++it) {
-                while (pred(*it, *(next(it)))) {
-                    erase(next(it));
+            for (auto it = begin(); it != end() && Readable::next(it) != end(); ++it) {
+                while (Readable::next(it) != end() && binary_pred(*it, *(Readable::next(it)))) {
+                    erase(Readable::next(it));
                 }
             }
         }
@@ -592,12 +743,15 @@ namespace Readable {
 
         template<class Compare>
         void merge(list<T, Allocator> &other, Compare comp) {
+            if (&other == this) {
+                return;
+            }
             auto this_it = begin();
             auto other_it = other.begin();
             while (this_it != end() && other_it != other.end()) {
                 if (comp(*other_it, *this_it)) {
-                    auto new_other_it = next(other_it);
-                    splice(this_it, other, other_it);
+                    auto new_other_it = Readable::next(other_it);
+                    splice_node(this_it, other, other_it);
                     other_it = new_other_it;
                 } else {
                     ++this_it;
@@ -608,96 +762,67 @@ namespace Readable {
 
         template<class Compare>
         void merge(list<T, Allocator> &&other, Compare comp) {
-            auto this_it = begin();
-            auto other_it = other.begin();
-            while (this_it != end() && other_it != other.end()) {
-                if (comp(*other_it, *this_it)) {
-                    auto new_other_it = next(other_it);
-                    splice(this_it, other, other_it);
-                    other_it = new_other_it;
-                } else {
-                    ++this_it;
-                }
-            }
-            splice(end(), other, other_it, other.end());
+            merge(other, comp);
         }
 
-    private:
-        /**
-         * 将链表分为两段
-         * @param from 要分的部分的头
-         * @param to 要分的部分的尾
-         * @return 设返回的迭代器为it，则被分割的链表的第一部分是[from,it),第二部分是[it,to)
-         */
-        static iterator
-        divide(iterator from, iterator to) {
-            iterator it1 = from,
-                    it2 = from;
-            while (next(it2) != to && next(it2, 2) != to) {
-                advance(it2, 2);
-                ++it1;
-            }
-            return it1;
+    public:
+        void sort() {
+            sort(less<T>());
         }
 
         /**
-         * 合并list内两个相邻的有序序列
-         * @param from 第一个序列的开始
-         * @param mid 第二个序列的开始，也是第一个序列的超尾
-         * @param to 第二个序列的超尾
-         * @param comp 比较函数
-         * @return 合并后序列的开始
+         * 稳定排序
+         * 先把环形链表在哨兵处断开成以nullptr结尾的单链，用自底向上的自然归并排序按next排好，
+         * 最后一遍遍历重建prev，再接回哨兵
+         * 只修改指针，不移动元素，所有迭代器仍然有效
          */
-        template<typename Compare>
-        iterator merge_inside(iterator from, iterator mid, iterator to, Compare comp) {
-            auto it1 = from, it2 = mid;
-            while (it2 != to && it1 != it2) {
-                if (!comp(*it1, *it2)) {
-                    auto new_it2 = next(it2);
-                    splice(it1, *this, it2);
-                    if (it1 == from) {
-                        from = it2;
-                    }
-                    it2 = new_it2;
-                } else {
-                    ++it1;
-                }
+        template<class Compare>
+        void sort(Compare comp) {
+            if (node_count < 2) {
+                return;
             }
-            return from;
+            node.prev->next = nullptr;
+            auto sorted = Readable::natural_merge_sort(node.next, [&comp](list_node_base *a, list_node_base *b) {
+                return comp(((node_type *) a)->data, ((node_type *) b)->data);
+            });
+            relink_prev(sorted.head);
         }
 
+    private:
         /**
-         * 将一个序列排序
-         * @param from 序列的开始
-         * @param to 序列的超尾
-         * @param comp 比较函数
-         * @return 排序后序列的开始
+         * 已知从 @arg first 开始、以nullptr结尾的next链，重建所有的prev并接回哨兵
          */
-        template<typename Compare>
-        iterator sort_range(iterator from, iterator to, Compare comp) {
-            if (from == to || next(from) == to) {
-                return from;
-            } else if (next(from, 2) == to) {
-                if (!comp(*from, *to)) {
-                    splice(from, *this, to);
-                    return to;
-                }
-                return from;
+        void relink_prev(list_node_base *first) {
+            list_node_base *prev = &node;
+            for (auto cursor = first; cursor; cursor = cursor->next) {
+                cursor->prev = prev;
+                prev = cursor;
             }
-            auto mid = divide(from, to);
-            auto new_from = sort_range(from, mid, comp);
-            mid = sort_range(mid, to, comp);
-            return merge_inside(new_from, mid, to, comp);
+            node.next = first;
+            prev->next = &node;
+            node.prev = prev;
         }
 
     public:
-        void sort() {
-            sort(less<T>());
-        }
-
-        template<class Compare>
-        void sort(Compare comp) {
-            sort_range(begin(), end(), comp);
+        /**
+         * 整理节点的内存布局
+         * 按遍历顺序把元素放进新节点并重新链接，再释放旧节点；节点足够多时新节点在一整块连续的内存中
+         * 长时间增删后节点散落在堆上，遍历的每一步都可能缓存不命中；整理后遍历就是顺序访问内存
+         * 元素的移动构造不抛出异常时移动元素，否则复制元素；复制失败时链表保持原样
+         * @note 所有迭代器、指针和引用都会失效
+         */
+        void defragment() {
+            if (node_count == 0) {
+                return;
+            }
+            auto cursor = node.next;
+            // 新节点先放在一个临时的list中，全部构造成功后再交换，旧节点随临时list析构
+            self_type fresh;
+            fresh.insert_constructed(fresh.end(), node_count, [&cursor](T *where) {
+                allocator_type::construct(where, std::move_if_noexcept(((node_type *) cursor)->data));
+                cursor = cursor->next;
+            });
+            swap(fresh);
         }
 
         void reverse() noexcept {
@@ -0,0 +1,493 @@
+#ifndef STL_FROM_SCRATCH_RING_BUFFER_H
+#define STL_FROM_SCRATCH_RING_BUFFER_H
+
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include "../memory/memory.h"
+#include "../iterator/iterator.h"
+#include "../utility/utility.h"
+#include "../type_traits/type_traits.h"
+
+namespace Readable {
+    /**
+     * ring_buffer写满后的处理方式
+     */
+    enum class ring_buffer_overflow {
+        // 覆盖最旧的元素
+        overwrite_oldest,
+        // 拒绝写入，push_back返回false
+        reject_when_full
+    };
+
+    /**
+     * ring_buffer中的一段连续空间
+     * 用于直接交给readv/writev之类需要(指针,长度)的接口
+     */
+    template<typename PointerType>
+    struct ring_buffer_span {
+        PointerType data;
+        std::size_t size;
+    };
+
+    /**
+     * ring_buffer的迭代器
+     * 和deque_iterator一样是随机访问迭代器
+     * 不同之处在于它记录的是"逻辑下标"（一直递增，不回绕），真正访问时才用mask映射到缓冲区中
+     * 这样迭代器之间的比较、相减都只是整数运算
+     */
+    template<typename T, typename ReferenceType, typename PointerType>
+    class ring_buffer_iterator : public Readable::iterator<
+            Readable::random_access_iterator_tag,
+            T,
+            std::ptrdiff_t,
+            PointerType,
+            ReferenceType
+    > {
+    public:
+        // 为方便起见定义的一些类型
+        // 本身的类型
+        typedef ring_buffer_iterator<T, ReferenceType, PointerType> self_type;
+        // 正常的迭代器类型
+        typedef ring_buffer_iterator<T, T &, T *> iterator_type;
+        // const的迭代器类型
+        typedef ring_buffer_iterator<T, const T &, const T *> const_iterator_type;
+
+        ring_buffer_iterator() : buffer(nullptr), mask(0), index(0) {}
+
+        ring_buffer_iterator(T *the_buffer, std::size_t the_mask, std::size_t the_index) :
+                buffer(the_buffer), mask(the_mask), index(the_index) {}
+
+        // 使iterator可以拷贝构造自无论是否const的iterator
+        ring_buffer_iterator(const iterator_type &other) :
+                buffer(other.buffer), mask(other.mask), index(other.index) {}
+
+        // 实现Iterator concept
+        ReferenceType operator*() const {
+            return buffer[index & mask];
+        }
+
+        PointerType operator->() const {
+            return buffer + (index & mask);
+        }
+
+        self_type &operator++() {
+            ++index;
+            return *this;
+        }
+
+        // 实现ForwardIterator concept
+        self_type operator++(int) {
+            self_type origin_this = *this;
+            ++index;
+            return origin_this;
+        }
+
+        // 实现BidirectionalIterator concept
+        self_type &operator--() {
+            --index;
+            return *this;
+        }
+
+        self_type operator--(int) {
+            self_type origin_this = *this;
+            --index;
+            return origin_this;
+        }
+
+        // 实现RandomAccessIterator concept
+        // 由于逻辑下标是无符号整数，负数的n会按模运算回绕，结果仍然正确
+        self_type &operator+=(std::ptrdiff_t n) {
+            index += n;
+            return *this;
+        }
+
+        self_type &operator-=(std::ptrdiff_t n) {
+            index -= n;
+            return *this;
+        }
+
+        friend std::ptrdiff_t operator-(const self_type &a, const self_type &b) {
+            return static_cast<std::ptrdiff_t>(a.index - b.index);
+        }
+
+        ReferenceType operator[](std::ptrdiff_t n) const {
+            return buffer[(index + n) & mask];
+        }
+
+        // 逻辑下标可能已经绕过了size_t的上限，因此比较时比较差值的符号
+        friend bool operator<(const self_type &lhs, const self_type &rhs) {
+            return lhs - rhs < 0;
+        }
+
+        friend bool operator>(const self_type &lhs, const self_type &rhs) {
+            return rhs < lhs;
+        }
+
+        friend bool operator<=(const self_type &lhs, const self_type &rhs) {
+            return !(rhs < lhs);
+        }
+
+        friend bool operator>=(const self_type &lhs, const self_type &rhs) {
+            return !(lhs < rhs);
+        }
+
+        bool operator==(const self_type &rhs) const {
+            return index == rhs.index && buffer == rhs.buffer;
+        }
+
+        bool operator!=(const self_type &rhs) const {
+            return !(rhs == *this);
+        }
+
+    private:
+        template<typename, typename, typename>
+        friend
+        class ring_buffer_iterator;
+
+        T *buffer;
+        std::size_t mask;
+        std::size_t index;
+    };
+
+    template<typename T, typename ReferenceType, typename PointerType>
+    ring_buffer_iterator<T, ReferenceType, PointerType>
+    operator+(ring_buffer_iterator<T, ReferenceType, PointerType> it, std::ptrdiff_t n) {
+        it += n;
+        return it;
+    }
+
+    template<typename T, typename ReferenceType, typename PointerType>
+    ring_buffer_iterator<T, ReferenceType, PointerType>
+    operator+(std::ptrdiff_t n, ring_buffer_iterator<T, ReferenceType, PointerType> it) {
+        it += n;
+        return it;
+    }
+
+    template<typename T, typename ReferenceType, typename PointerType>
+    ring_buffer_iterator<T, ReferenceType, PointerType>
+    operator-(ring_buffer_iterator<T, ReferenceType, PointerType> it, std::ptrdiff_t n) {
+        it -= n;
+        return it;
+    }
+
+    /**
+     * 固定容量的环形缓冲区
+     * 容量总是2的幂，这样下标回绕只需要和mask做按位与，而不需要取模
+     * 构造后不会再重新分配空间
+     * 被移走的ring_buffer容量为0，仍然可以正常析构、赋值，但写入总是失败
+     * @tparam T 容器中的内容
+     * @tparam Allocator 空间分配器
+     */
+    template<typename T, typename Allocator = Readable::allocator<T> >
+    class ring_buffer final {
+    public:
+        typedef T value_type;
+        typedef Allocator allocator_type;
+
+        static_assert((Readable::is_same<typename allocator_type::value_type, value_type>::value),
+                      "Allocator::value_type must be same type as value_type");
+
+        typedef std::size_t size_type;
+        typedef std::ptrdiff_t difference_type;
+        typedef value_type &reference;
+        typedef const value_type &const_reference;
+        typedef typename Allocator::pointer pointer;
+        typedef typename Allocator::const_pointer const_pointer;
+        typedef ring_buffer_iterator<T, T &, T *> iterator;
+        typedef ring_buffer_iterator<T, const T &, const T *> const_iterator;
+        typedef Readable::reverse_iterator<iterator> reverse_iterator;
+        typedef Readable::reverse_iterator<const_iterator> const_reverse_iterator;
+        typedef ring_buffer_span<pointer> span;
+        typedef ring_buffer_span<const_pointer> const_span;
+    private:
+        typedef ring_buffer<T, Allocator> self_type;
+
+        pointer buffer;
+        size_type mask;
+        // head和tail都是一直递增的逻辑下标
+        // [head, tail)之间的元素是已经构造过的
+        size_type head;
+        size_type tail;
+        ring_buffer_overflow overflow;
+
+        /**
+         * 将 @arg n 向上取整到2的幂
+         */
+        static size_type round_up_to_power_of_two(size_type n) {
+            size_type result = 1;
+            while (result < n) {
+                result <<= 1;
+            }
+            return result;
+        }
+
+    public:
+        /**
+         * 构造一个容量至少为 @arg capacity_want 的环形缓冲区
+         * @param capacity_want 期望的容量，实际容量会向上取整到2的幂
+         * @param overflow_policy 写满时的处理方式
+         */
+        explicit ring_buffer(size_type capacity_want,
+                             ring_buffer_overflow overflow_policy = ring_buffer_overflow::overwrite_oldest,
+                             const Allocator & = Allocator()) :
+                buffer(nullptr), mask(round_up_to_power_of_two(capacity_want) - 1),
+                head(0), tail(0), overflow(overflow_policy) {
+            buffer = allocator_type::allocate(mask + 1);
+        }
+
+        ring_buffer(const ring_buffer &other) : ring_buffer(other.capacity(), other.overflow) {
+            for (auto &item: other) {
+                push_back(item);
+            }
+        }
+
+        ring_buffer(ring_buffer &&other) noexcept :
+                buffer(other.buffer), mask(other.mask),
+                head(other.head), tail(other.tail), overflow(other.overflow) {
+            // mask + 1回绕为0，即容量为0：other为空而且总是满的，emplace_back不会再写入
+            other.buffer = nullptr;
+            other.mask = ~size_type(0);
+            other.head = other.tail = 0;
+        }
+
+        ~ring_buffer() {
+            clear();
+            if (buffer) {
+                allocator_type::deallocate(buffer, capacity());
+            }
+        }
+
+        ring_buffer &operator=(const ring_buffer &other) {
+            if (this != &other) {
+                ring_buffer temp(other);
+                swap(temp);
+            }
+            return *this;
+        }
+
+        ring_buffer &operator=(ring_buffer &&other) noexcept {
+            swap(other);
+            return *this;
+        }
+
+        allocator_type get_allocator() const noexcept {
+            return allocator_type();
+        }
+
+        ring_buffer_overflow overflow_policy() const noexcept {
+            return overflow;
+        }
+
+        // iterators:
+        iterator begin() noexcept {
+            return iterator(buffer, mask, head);
+        }
+
+        const_iterator begin() const noexcept {
+            return cbegin();
+        }
+
+        const_iterator cbegin() const noexcept {
+            return const_iterator(buffer, mask, head);
+        }
+
+        iterator end() noexcept {
+            return iterator(buffer, mask, tail);
+        }
+
+        const_iterator end() const noexcept {
+            return cend();
+        }
+
+        const_iterator cend() const noexcept {
+            return const_iterator(buffer, mask, tail);
+        }
+
+        reverse_iterator rbegin() noexcept {
+            return reverse_iterator(end());
+        }
+
+        const_reverse_iterator rbegin() const noexcept {
+            return const_reverse_iterator(end());
+        }
+
+        reverse_iterator rend() noexcept {
+            return reverse_iterator(begin());
+        }
+
+        const_reverse_iterator rend() const noexcept {
+            return const_reverse_iterator(begin());
+        }
+
+        // capacity:
+        size_type size() const noexcept {
+            return tail - head;
+        }
+
+        size_type capacity() const noexcept {
+            return mask + 1;
+        }
+
+        size_type max_size() const noexcept {
+            return capacity();
+        }
+
+        bool empty() const noexcept {
+            return head == tail;
+        }
+
+        bool full() const noexcept {
+            return size() == capacity();
+        }
+
+        // element access:
+        reference operator[](size_type pos) {
+            return buffer[(head + pos) & mask];
+        }
+
+        const_reference operator[](size_type pos) const {
+            return buffer[(head + pos) & mask];
+        }
+
+        reference at(size_type pos) {
+            if (pos >= size()) {
+                throw std::out_of_range("ring_buffer:pos >= size() in at");
+            }
+            return operator[](pos);
+        }
+
+        const_reference at(size_type pos) const {
+            if (pos >= size()) {
+                throw std::out_of_range("ring_buffer:pos >= size() in at");
+            }
+            return operator[](pos);
+        }
+
+        reference front() {
+            return buffer[head & mask];
+        }
+
+        const_reference front() const {
+            return buffer[head & mask];
+        }
+
+        reference back() {
+            return buffer[(tail - 1) & mask];
+        }
+
+        const_reference back() const {
+            return buffer[(tail - 1) & mask];
+        }
+
+        // modifiers:
+        /**
+         * 在尾部构造一个元素
+         * overwrite_oldest模式下写满时，先在临时对象中构造新元素，再移动赋值给最老的元素：
+         * 参数可能引用着最老的元素（如push_back(front())），构造失败时最老的元素也还在
+         * @return 是否写入成功，只有在reject_when_full模式下写满时，或者容量为0（已被移走）时才会失败
+         */
+        template<typename... Args>
+        bool emplace_back(Args &&... args) {
+            if (full()) {
+                if (overflow == ring_buffer_overflow::reject_when_full || capacity() == 0) {
+                    return false;
+                }
+                T value(std::forward<Args>(args)...);
+                // 写满时最老的元素所在的位置就是新元素的位置
+                buffer[head & mask] = std::move(value);
+                ++head;
+                ++tail;
+                return true;
+            }
+            allocator_type::construct(buffer + (tail & mask), std::forward<Args>(args)...);
+            ++tail;
+            return true;
+        }
+
+        bool push_back(const T &value) {
+            return emplace_back(value);
+        }
+
+        bool push_back(T &&value) {
+            return emplace_back(std::move(value));
+        }
+
+        void pop_front() {
+            Readable::destroy(buffer + (head & mask));
+            ++head;
+        }
+
+        void pop_back() {
+            --tail;
+            Readable::destroy(buffer + (tail & mask));
+        }
+
+        void clear() noexcept {
+            while (!empty()) {
+                pop_front();
+            }
+            head = tail = 0;
+        }
+
+        void swap(ring_buffer &other) noexcept {
+            std::swap(buffer, other.buffer);
+            std::swap(mask, other.mask);
+            std::swap(head, other.head);
+            std::swap(tail, other.tail);
+            std::swap(overflow, other.overflow);
+        }
+
+        // bulk access:
+        // 环形缓冲区中的已用空间和空闲空间都最多分为两段连续内存
+        // 下面的函数返回这两段（不足两段时第二段的size为0），便于直接交给readv/writev，避免额外的复制
+        /**
+         * 可读（即已写入）的数据所在的两段连续空间，按先后顺序排列
+         */
+        Readable::pair<const_span, const_span> readable_spans() const noexcept {
+            size_type begin_at = head & mask;
+            size_type count = size();
+            size_type first_size = capacity() - begin_at < count ? capacity() - begin_at : count;
+            const_span first = {buffer + begin_at, first_size};
+            const_span second = {buffer, count - first_size};
+            return Readable::make_pair(first, second);
+        }
+
+        /**
+         * 可写（即空闲）的两段连续空间，按先后顺序排列
+         * @note 这些空间中没有构造过的对象，因此只适合直接写入平凡类型的数据，写完后用commit提交
+         */
+        Readable::pair<span, span> writable_spans() noexcept {
+            size_type begin_at = tail & mask;
+            size_type count = capacity() - size();
+            size_type first_size = capacity() - begin_at < count ? capacity() - begin_at : count;
+            span first = {buffer + begin_at, first_size};
+            span second = {buffer, count - first_size};
+            return Readable::make_pair(first, second);
+        }
+
+        /**
+         * 提交通过writable_spans写入的 @arg n 个元素
+         * @note 仅适用于平凡类型，n不能超过空闲空间的大小
+         */
+        void commit(size_type n) noexcept {
+            tail += n;
+        }
+
+        /**
+         * 丢弃最旧的 @arg n 个元素，通常在通过readable_spans读出数据后调用
+         */
+        void consume(size_type n) {
+            for (size_type i = 0; i < n; ++i) {
+                pop_front();
+            }
+        }
+    };
+
+    template<typename T, typename Alloc>
+    void swap(ring_buffer<T, Alloc> &lhs, ring_buffer<T, Alloc> &rhs) {
+        lhs.swap(rhs);
+    }
+}
+
+#endif //STL_FROM_SCRATCH_RING_BUFFER_H
@@ -0,0 +1,595 @@
+#ifndef STL_FROM_SCRATCH_UNROLLED_LIST_H
+#define STL_FROM_SCRATCH_UNROLLED_LIST_H
+
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+#include <type_traits>
+#include "../memory/memory.h"
+#include "../iterator/iterator.h"
+#include "../utility/utility.h"
+#include "../type_traits/type_traits.h"
+#include "../concurrency/cache_line.h"
+
+namespace Readable {
+    /**
+     * unrolled_list默认每个节点能放下的元素个数：让一个节点大约占两个缓存行，至少为4
+     */
+    template<typename T>
+    struct unrolled_list_default_capacity {
+        static const std::size_t bytes = 2 * cache_line_size - 3 * sizeof(void *);
+        static const std::size_t value = bytes / sizeof(T) < 4 ? 4 : bytes / sizeof(T);
+    };
+
+    struct unrolled_list_node_base {
+        unrolled_list_node_base *prev;
+        unrolled_list_node_base *next;
+    };
+
+    /**
+     * unrolled_list的节点，最多保存K个元素，元素总是放在items()[0, count)中
+     */
+    template<typename T, std::size_t K>
+    struct unrolled_list_node : public unrolled_list_node_base {
+        std::size_t count;
+        alignas(T) unsigned char storage[K * sizeof(T)];
+
+        T *items() {
+            return reinterpret_cast<T *>(storage);
+        }
+    };
+
+    /**
+     * unrolled_list的迭代器
+     * 记录所在的节点和在节点中的下标，节点内的移动只是下标加减
+     * end()是(哨兵, 0)
+     */
+    template<typename T, std::size_t K, typename ReferenceType, typename PointerType>
+    struct unrolled_list_iterator : public Readable::iterator<
+            Readable::bidirectional_iterator_tag,
+            T,
+            std::ptrdiff_t,
+            PointerType,
+            ReferenceType
+    > {
+        typedef unrolled_list_iterator<T, K, ReferenceType, PointerType> self_type;
+        typedef unrolled_list_iterator<T, K, T &, T *> iterator_type;
+        typedef unrolled_list_iterator<T, K, const T &, const T *> const_iterator_type;
+        typedef unrolled_list_node<T, K> node_type;
+
+        unrolled_list_node_base *node;
+        std::size_t index;
+
+        unrolled_list_iterator() = default;
+
+        unrolled_list_iterator(unrolled_list_node_base *n, std::size_t i) : node(n), index(i) {}
+
+        unrolled_list_iterator(const iterator_type &other) : node(other.node), index(other.index) {}
+
+        unrolled_list_iterator(const const_iterator_type &other) : node(other.node), index(other.index) {}
+
+        bool operator==(const self_type &other) const { return node == other.node && index == other.index; }
+
+        bool operator!=(const self_type &other) const { return !(*this == other); }
+
+        ReferenceType operator*() const {
+            return ((node_type *) node)->items()[index];
+        }
+
+        PointerType operator->() const {
+            return Readable::addressof(operator*());
+        }
+
+        self_type &operator++() {
+            if (++index == ((node_type *) node)->count) {
+                node = node->next;
+                index = 0;
+            }
+            return *this;
+        }
+
+        self_type operator++(int) {
+            self_type origin_this = *this;
+            ++*this;
+            return origin_this;
+        }
+
+        self_type &operator--() {
+            if (index == 0) {
+                node = node->prev;
+                index = ((node_type *) node)->count;
+            }
+            --index;
+            return *this;
+        }
+
+        self_type operator--(int) {
+            self_type origin_this = *this;
+            --*this;
+            return origin_this;
+        }
+    };
+
+    /**
+     * 展开链表
+     * 每个节点保存最多K个元素，遍历时大部分步骤只是在节点的数组中移动下标，缓存友好程度接近vector；
+     * 插入、删除只移动一个节点中的元素，节点满了就一分为二，节点不到半满时和下一个节点合并；
+     * 在节点边界处拼接（splice）和list一样只需要重新链接节点，否则先把一个节点一分为二
+     *
+     * 和list不同，插入、删除会使同一个节点（分裂、合并时还有相邻节点）中元素的迭代器和引用失效
+     * 要求T的移动构造不抛出异常：分裂、合并节点和在节点中插入时逐个移动元素，中途抛出异常会使节点的count与实际的元素不符
+     * @tparam K 每个节点最多保存的元素个数，默认让一个节点大约占两个缓存行
+     */
+    template<typename T, std::size_t K = unrolled_list_default_capacity<T>::value,
+            typename Allocator = allocator<T> >
+    class unrolled_list final {
+        static_assert(K >= 2, "unrolled_list needs at least 2 elements per node");
+        static_assert(std::is_nothrow_move_constructible<T>::value,
+                      "unrolled_list needs T to be nothrow move constructible");
+    public:
+        typedef T value_type;
+        typedef Allocator allocator_type;
+        static_assert(Readable::is_same<typename allocator_type::value_type, value_type>::value,
+                      "Allocator::value_type must be same type as value_type");
+        typedef value_type &reference;
+        typedef const value_type &const_reference;
+        typedef unrolled_list_iterator<T, K, T &, T *> iterator;
+        typedef unrolled_list_iterator<T, K, const T &, const T *> const_iterator;
+        typedef std::size_t size_type;
+        typedef std::ptrdiff_t difference_type;
+        typedef Readable::reverse_iterator<iterator> reverse_iterator;
+        typedef Readable::reverse_iterator<const_iterator> const_reverse_iterator;
+    private:
+        typedef unrolled_list_node<T, K> node_type;
+        typedef typename allocator_type::template rebind<node_type>::other node_allocator;
+        unrolled_list_node_base sentinel;
+        size_type element_count;
+
+        static node_type *as_node(unrolled_list_node_base *base) {
+            return (node_type *) base;
+        }
+
+        static node_type *create_node() {
+            node_type *new_node = node_allocator::allocate(1);
+            new_node->count = 0;
+            return new_node;
+        }
+
+        static void destroy_node(node_type *the_node) {
+            Readable::destroy(the_node->items(), the_node->items() + the_node->count);
+            node_allocator::deallocate(the_node, 1);
+        }
+
+        /**
+         * 把 @arg new_node 链接到 @arg position 之前
+         */
+        static void link_before(unrolled_list_node_base *position, unrolled_list_node_base *new_node) {
+            new_node->prev = position->prev;
+            new_node->next = position;
+            position->prev->next = new_node;
+            position->prev = new_node;
+        }
+
+        static void unlink(unrolled_list_node_base *the_node) {
+            the_node->prev->next = the_node->next;
+            the_node->next->prev = the_node->prev;
+        }
+
+        /**
+         * 把 @arg the_node 中[at, count)的元素移到一个新节点中，新节点链接在它后面
+         * @return 新节点
+         */
+        static node_type *split(node_type *the_node, size_type at) {
+            node_type *right = create_node();
+            T *from = the_node->items();
+            T *to = right->items();
+            for (size_type i = at; i < the_node->count; ++i) {
+                allocator_type::construct(to + (i - at), std::move(from[i]));
+                Readable::destroy(from + i);
+            }
+            right->count = the_node->count - at;
+            the_node->count = at;
+            link_before(the_node->next, right);
+            return right;
+        }
+
+        /**
+         * 把 @arg right 中的元素全部移到 @arg left 的末尾，然后释放 @arg right
+         */
+        static void absorb(node_type *left, node_type *right) {
+            T *from = right->items();
+            T *to = left->items() + left->count;
+            for (size_type i = 0; i < right->count; ++i) {
+                allocator_type::construct(to + i, std::move(from[i]));
+                Readable::destroy(from + i);
+            }
+            left->count += right->count;
+            right->count = 0;
+            unlink(right);
+            destroy_node(right);
+        }
+
+        /**
+         * 在节点的 @arg index 处放入 @arg value，节点必须还有空位
+         */
+        static void put_into(node_type *the_node, size_type index, T &&value) {
+            T *items = the_node->items();
+            size_type count = the_node->count;
+            if (index == count) {
+                allocator_type::construct(items + count, std::move(value));
+            } else {
+                allocator_type::construct(items + count, std::move(items[count - 1]));
+                for (size_type i = count - 1; i > index; --i) {
+                    items[i] = std::move(items[i - 1]);
+                }
+                items[index] = std::move(value);
+            }
+            ++the_node->count;
+        }
+
+        /**
+         * 保证 @arg position 处于一个节点的开头，必要时把节点一分为二
+         * @return 以position开头的节点，position为end()时返回哨兵
+         */
+        unrolled_list_node_base *split_before(const_iterator position) {
+            if (position.index == 0) {
+                return position.node;
+            }
+            return split(as_node(position.node), position.index);
+        }
+
+        /**
+         * 在 @arg at 处分裂出 @arg right 之后，修正原来指向at所在节点中[at, count)的迭代器 @arg it
+         */
+        static void follow_split(const_iterator &it, const_iterator at, unrolled_list_node_base *right) {
+            if (at.index != 0 && it.node == at.node && it.index >= at.index) {
+                it.node = right;
+                it.index -= at.index;
+            }
+        }
+
+        /**
+         * 哨兵的链接被换成另一个链表（哨兵为 @arg old_sentinel）的之后，让首尾节点指回本链表的哨兵；
+         * 那个链表没有节点时哨兵的链接指向old_sentinel，这时让哨兵指向自己
+         */
+        void relink_sentinel(const unrolled_list_node_base *old_sentinel) noexcept {
+            if (sentinel.next == old_sentinel) {
+                sentinel.prev = &sentinel;
+                sentinel.next = &sentinel;
+            } else {
+                sentinel.next->prev = &sentinel;
+                sentinel.prev->next = &sentinel;
+            }
+        }
+
+        template<typename InputIt>
+        void initialize(InputIt first, InputIt last, Readable::false_type) {
+            for (; first != last; ++first) {
+                push_back(*first);
+            }
+        }
+
+        void initialize(size_type n, const T &value, Readable::true_type) {
+            for (size_type i = 0; i < n; ++i) {
+                push_back(value);
+            }
+        }
+
+    public:
+        unrolled_list() : sentinel(), element_count(0) {
+            sentinel.prev = &sentinel;
+            sentinel.next = &sentinel;
+        }
+
+        explicit unrolled_list(size_type n, const T &value = T()) : unrolled_list() {
+            initialize(n, value, Readable::true_type());
+        }
+
+        template<typename InputItOrIntegral>
+        unrolled_list(InputItOrIntegral first, InputItOrIntegral last) : unrolled_list() {
+            initialize(first, last, Readable::is_integral<InputItOrIntegral>());
+        }
+
+        unrolled_list(std::initializer_list<T> init_list) : unrolled_list(init_list.begin(), init_list.end()) {}
+
+        unrolled_list(const unrolled_list &other) : unrolled_list(other.begin(), other.end()) {}
+
+        unrolled_list(unrolled_list &&other) noexcept : unrolled_list() {
+            swap(other);
+        }
+
+        ~unrolled_list() {
+            clear();
+        }
+
+        unrolled_list &operator=(const unrolled_list &other) {
+            if (&other != this) {
+                unrolled_list copy(other);
+                swap(copy);
+            }
+            return *this;
+        }
+
+        unrolled_list &operator=(unrolled_list &&other) noexcept {
+            if (&other != this) {
+                clear();
+                swap(other);
+            }
+            return *this;
+        }
+
+        // iterators:
+        iterator begin() noexcept {
+            return iterator(sentinel.next, 0);
+        }
+
+        const_iterator begin() const noexcept {
+            return const_iterator(sentinel.next, 0);
+        }
+
+        iterator end() noexcept {
+            return iterator(&sentinel, 0);
+        }
+
+        const_iterator end() const noexcept {
+            return const_iterator(const_cast<unrolled_list_node_base *>(&sentinel), 0);
+        }
+
+        const_iterator cbegin() const noexcept {
+            return begin();
+        }
+
+        const_iterator cend() const noexcept {
+            return end();
+        }
+
+        reverse_iterator rbegin() noexcept {
+            return reverse_iterator(end());
+        }
+
+        const_reverse_iterator rbegin() const noexcept {
+            return const_reverse_iterator(end());
+        }
+
+        reverse_iterator rend() noexcept {
+            return reverse_iterator(begin());
+        }
+
+        const_reverse_iterator rend() const noexcept {
+            return const_reverse_iterator(begin());
+        }
+
+        // capacity:
+        size_type size() const noexcept {
+            return element_count;
+        }
+
+        bool empty() const noexcept {
+            return element_count == 0;
+        }
+
+        size_type max_size() const noexcept {
+            return SIZE_MAX / sizeof(T);
+        }
+
+        /**
+         * 每个节点最多保存的元素个数
+         */
+        static constexpr size_type node_capacity() noexcept {
+            return K;
+        }
+
+        // element access:
+        reference front() {
+            return *begin();
+        }
+
+        const_reference front() const {
+            return *begin();
+        }
+
+        reference back() {
+            return *(--end());
+        }
+
+        const_reference back() const {
+            return *(--end());
+        }
+
+        // modifiers:
+        /**
+         * 在 @arg position 前构造一个元素
+         * 节点有空位时只移动这个节点中position之后的元素；
+         * 节点满了时，如果position在节点开头且前一个节点有空位就放到前一个节点末尾，
+         * 否则在开头时新建一个节点，不在开头时把节点一分为二
+         * @return 指向新元素的迭代器
+         */
+        template<typename... Args>
+        iterator emplace(const_iterator position, Args &&... args) {
+            T value(std::forward<Args>(args)...);
+            unrolled_list_node_base *target = position.node;
+            size_type index = position.index;
+            if (index == 0) {
+                unrolled_list_node_base *before = target->prev;
+                if (before != &sentinel && as_node(before)->count < K) {
+                    // 放到前一个节点的末尾
+                    target = before;
+                    index = as_node(before)->count;
+                } else if (target == &sentinel || as_node(target)->count == K) {
+                    node_type *new_node = create_node();
+                    link_before(target, new_node);
+                    target = new_node;
+                }
+            } else if (as_node(target)->count == K) {
+                size_type half = K / 2;
+                node_type *right = split(as_node(target), half);
+                if (index > half) {
+                    target = right;
+                    index -= half;
+                }
+            }
+            put_into(as_node(target), index, std::move(value));
+            ++element_count;
+            return iterator(target, index);
+        }
+
+        iterator insert(const_iterator position, const T &value) {
+            return emplace(position, value);
+        }
+
+        iterator insert(const_iterator position, T &&value) {
+            return emplace(position, std::move(value));
+        }
+
+        template<typename... Args>
+        void emplace_back(Args &&... args) {
+            emplace(end(), std::forward<Args>(args)...);
+        }
+
+        template<typename... Args>
+        void emplace_front(Args &&... args) {
+            emplace(begin(), std::forward<Args>(args)...);
+        }
+
+        void push_back(const T &value) {
+            emplace(end(), value);
+        }
+
+        void push_back(T &&value) {
+            emplace(end(), std::move(value));
+        }
+
+        void push_front(const T &value) {
+            emplace(begin(), value);
+        }
+
+        void push_front(T &&value) {
+            emplace(begin(), std::move(value));
+        }
+
+        /**
+         * 删除 @arg position 处的元素
+         * 节点空了就释放；不到半满且能和下一个节点合并时，把下一个节点并进来
+         * @return 指向被删除元素之后的元素的迭代器
+         */
+        iterator erase(const_iterator position) {
+            node_type *the_node = as_node(position.node);
+            size_type index = position.index;
+            T *items = the_node->items();
+            for (size_type i = index; i + 1 < the_node->count; ++i) {
+                items[i] = std::move(items[i + 1]);
+            }
+            --the_node->count;
+            Readable::destroy(items + the_node->count);
+            --element_count;
+            unrolled_list_node_base *next = the_node->next;
+            if (the_node->count == 0) {
+                unlink(the_node);
+                destroy_node(the_node);
+                return iterator(next, 0);
+            }
+            if (the_node->count < K / 2 && next != &sentinel && the_node->count + as_node(next)->count <= K) {
+                absorb(the_node, as_node(next));
+            }
+            if (index < the_node->count) {
+                return iterator(the_node, index);
+            }
+            return iterator(the_node->next, 0);
+        }
+
+        iterator erase(const_iterator first, const_iterator last) {
+            // 合并节点可能使last失效，因此先数出要删除的个数
+            auto n = Readable::distance(first, last);
+            iterator it(first.node, first.index);
+            while (n-- > 0) {
+                it = erase(it);
+            }
+            return it;
+        }
+
+        void pop_back() {
+            erase(--end());
+        }
+
+        void pop_front() {
+            erase(begin());
+        }
+
+        void clear() noexcept {
+            auto cursor = sentinel.next;
+            while (cursor != &sentinel) {
+                auto next = cursor->next;
+                destroy_node(as_node(cursor));
+                cursor = next;
+            }
+            sentinel.prev = &sentinel;
+            sentinel.next = &sentinel;
+            element_count = 0;
+        }
+
+        void swap(unrolled_list &other) noexcept {
+            // 哨兵的地址不能交换，只能交换哨兵的链接，再让首尾节点指回新的哨兵
+            std::swap(sentinel.prev, other.sentinel.prev);
+            std::swap(sentinel.next, other.sentinel.next);
+            std::swap(element_count, other.element_count);
+            relink_sentinel(&other.sentinel);
+            other.relink_sentinel(&sentinel);
+        }
+
+        // list operations:
+        /**
+         * 把 @arg other 的[first, last)移到 @arg position 之前
+         * 范围的两端和position不在节点开头时，先把所在的节点一分为二，然后只需要重新链接节点，不移动其余元素
+         * 被分裂的节点中元素的迭代器会失效
+         */
+        void splice(const_iterator position, unrolled_list &other, const_iterator first, const_iterator last) {
+            if (first == last) {
+                return;
+            }
+            // 先在last处分裂，这样first所在的节点和下标不受影响
+            unrolled_list_node_base *last_node = other.split_before(last);
+            // 同一个链表中拼接时position可能和first、last在同一个节点，每次分裂后都要修正
+            follow_split(first, last, last_node);
+            follow_split(position, last, last_node);
+            unrolled_list_node_base *first_node = other.split_before(first);
+            follow_split(position, first, first_node);
+            unrolled_list_node_base *before_last = last_node->prev;
+            size_type moved_count = 0;
+            if (&other != this) {
+                for (auto cursor = first_node; cursor != last_node; cursor = cursor->next) {
+                    moved_count += as_node(cursor)->count;
+                }
+            }
+            unrolled_list_node_base *position_node = split_before(position);
+            if (position_node == first_node || position_node == last_node) {
+                return;
+            }
+            // 从原来的位置摘下[first_node, before_last]
+            first_node->prev->next = last_node;
+            last_node->prev = first_node->prev;
+            // 接到position_node之前
+            first_node->prev = position_node->prev;
+            before_last->next = position_node;
+            position_node->prev->next = first_node;
+            position_node->prev = before_last;
+            other.element_count -= moved_count;
+            element_count += moved_count;
+        }
+
+        void splice(const_iterator position, unrolled_list &&other, const_iterator first, const_iterator last) {
+            splice(position, other, first, last);
+        }
+
+        void splice(const_iterator position, unrolled_list &other) {
+            if (&other != this) {
+                splice(position, other, other.begin(), other.end());
+            }
+        }
+
+        void splice(const_iterator position, unrolled_list &&other) {
+            splice(position, other);
+        }
+    };
+}
+
+#endif //STL_FROM_SCRATCH_UNROLLED_LIST_H
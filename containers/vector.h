@@ -45,6 +45,15 @@ namespace Readable {
             start = allocator_type::allocate(count);
             finish = start;
             end_of_storage = finish + count;
+            try {
+                for (; finish != end_of_storage; ++finish) {
+                    allocator_type::construct(finish);
+                }
+            } catch (...) {
+                Readable::destroy(start, finish);
+                allocator_type::deallocate(start, count);
+                throw;
+            }
         }
 
     private:
@@ -57,8 +66,7 @@ namespace Readable {
         }
 
 
-        template<class Integer>
-        void initialize(Integer n, Integer value, Readable::true_type) {
+        void initialize(size_type n, const T &value, Readable::true_type) {
             start = allocator_type::allocate(n);
             end_of_storage = start + n;
             finish = uninitialized_fill_n(start, n, value);
@@ -102,8 +110,10 @@ namespace Readable {
         void expand_space_to(size_type capacity_want) {
             if (capacity_want > capacity()) {
                 auto new_start = allocator_type::allocate(capacity_want);
-                finish = Readable::uninitialized_move(begin(), end(), new_start);
+                auto new_finish = Readable::uninitialized_move(begin(), end(), new_start);
+                Readable::destroy(start, finish);
                 allocator_type::deallocate(start, end_of_storage - start);
+                finish = new_finish;
                 start = new_start;
                 end_of_storage = start + capacity_want;
             }
@@ -274,7 +284,7 @@ namespace Readable {
         void reserve(size_type need) {
             auto now_capacity = capacity();
             if (now_capacity == 0) {
-                expand_space_to(1);
+                expand_space_to(need > 1 ? need : 1);
             } else if (now_capacity < need) {
                 while (now_capacity < need) {
                     now_capacity *= 2;
@@ -402,7 +412,7 @@ namespace Readable {
 
         void push_back(const T &value) {
             reserve(size() + 1);
-            *finish = value;
+            allocator_type::construct(finish, value);
             ++finish;
         }
 
@@ -415,7 +425,7 @@ namespace Readable {
             reserve(size() + 1);
             allocator_type::construct(finish, std::forward<Args>(args)...);
             ++finish;
-            return *finish;
+            return *(finish - 1);
         }
 
         void pop_back() {
@@ -6,6 +6,8 @@
 #define STL_FROM_SCRATCH_ITERATOR_H
 
 #include <cstddef>
+#include <type_traits>
+#include <utility>
 #include "./iterator_traits.h"
 #include "../memory/memory.h"
 
@@ -26,9 +28,23 @@ namespace Readable {
         typedef Reference reference;
     };
 
+    /**
+     * 反向迭代器的类型和原迭代器相同，但连续迭代器反向之后地址是递减的，只能算随机访问迭代器
+     */
+    template<typename Category>
+    struct reverse_iterator_category {
+        typedef Category type;
+    };
+
+    template<>
+    struct reverse_iterator_category<contiguous_iterator_tag> {
+        typedef random_access_iterator_tag type;
+    };
+
     template<typename Iterator>
     class reverse_iterator : public Readable::iterator<
-            typename Readable::iterator_traits<Iterator>::iterator_category,
+            typename reverse_iterator_category<
+                    typename Readable::iterator_traits<Iterator>::iterator_category>::type,
             typename Readable::iterator_traits<Iterator>::value_type,
             typename Readable::iterator_traits<Iterator>::difference_type,
             typename Readable::iterator_traits<Iterator>::pointer,
@@ -146,5 +162,44 @@ namespace Readable {
                     const reverse_iterator<Iterator2> &rhs) {
         return lhs.base() <= rhs.base();
     };
+
+    template<typename Iterator1, typename Iterator2>
+    auto operator-(const reverse_iterator<Iterator1> &lhs,
+                   const reverse_iterator<Iterator2> &rhs) -> decltype(rhs.base() - lhs.base()) {
+        return rhs.base() - lhs.base();
+    };
+
+    template<typename Iterator>
+    reverse_iterator<Iterator> operator+(typename reverse_iterator<Iterator>::difference_type n,
+                                         const reverse_iterator<Iterator> &it) {
+        return it + n;
+    };
+
+    /**
+     * 把迭代器指向的元素转换成右值，std::move(*it)的推广
+     * 解引用得到左值时就是std::move(*it)；得到的是临时值时原样返回，不能返回它的引用
+     */
+    template<typename Iterator>
+    struct iter_rvalue_reference {
+        typedef typename iterator_traits<Iterator>::reference reference;
+        typedef typename std::conditional<std::is_lvalue_reference<reference>::value,
+                typename std::remove_reference<reference>::type &&, reference>::type type;
+    };
+
+    /**
+     * 把*it的值移动出来，算法中移动元素时应当用iter_move(it)而不是std::move(*it)
+     * 解引用得到代理对象的迭代器（比如zip_iterator）会重载这个函数，移动代理对象引用的元素，而不是代理对象本身
+     * @note 在namespace Readable中不加限定地调用，使得迭代器所在命名空间中的重载可以被找到
+     */
+    template<typename Iterator>
+    typename iter_rvalue_reference<Iterator>::type iter_move(const Iterator &it) {
+        return std::move(*it);
+    }
+
+    template<typename Iterator>
+    auto iter_move(const reverse_iterator<Iterator> &it) -> decltype(iter_move(std::declval<const Iterator &>())) {
+        Iterator tmp = it.base();
+        return iter_move(--tmp);
+    }
 };
 #endif //STL_FROM_SCRATCH_ITERATOR_H
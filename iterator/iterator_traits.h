@@ -7,6 +7,7 @@
 
 #include <cstddef>
 #include <iterator>
+#include "../type_traits/is_same.h"
 
 namespace Readable {
     /**
@@ -22,6 +23,13 @@ namespace Readable {
     };
     struct random_access_iterator_tag : public bidirectional_iterator_tag {
     };
+    /**
+     * 连续迭代器（C++20中才加入标准）：除了随机访问之外，还保证相邻元素在内存中也相邻，
+     * 即 *(it + n) 和 *(addressof(*it) + n) 是同一个对象，原生指针和vector的迭代器都是
+     * 算法据此可以把整个区间当成一块内存，用memmove、memcmp等一次处理
+     */
+    struct contiguous_iterator_tag : public random_access_iterator_tag {
+    };
     /**
      * 最普通的iterator traits，迭代器的信息由迭代器自己的实现给出
      * @tparam Iterator 一个容器内部实现的迭代器
@@ -45,7 +53,7 @@ namespace Readable {
         typedef T value_type;
         typedef T *pointer;
         typedef T &reference;
-        typedef Readable::random_access_iterator_tag iterator_category;
+        typedef Readable::contiguous_iterator_tag iterator_category;
     };
     /**
      * iterator traits针对原生pointer-to-const的特化，迭代器的信息已经知道了
@@ -56,7 +64,16 @@ namespace Readable {
         typedef T value_type;
         typedef const T *pointer;
         typedef const T &reference;
-        typedef Readable::random_access_iterator_tag iterator_category;
+        typedef Readable::contiguous_iterator_tag iterator_category;
+    };
+
+    /**
+     * 判断Iterator是否是连续迭代器
+     */
+    template<typename Iterator>
+    struct is_contiguous_iterator : public Readable::is_same<
+            typename iterator_traits<Iterator>::iterator_category,
+            contiguous_iterator_tag> {
     };
 
     /**
@@ -131,7 +148,7 @@ namespace Readable {
      */
     template<typename ForwardIt>
     ForwardIt next(ForwardIt it, typename Readable::iterator_traits<ForwardIt>::difference_type n = 1) {
-        advance(it, n);
+        Readable::advance(it, n);
         return it;
     }
 
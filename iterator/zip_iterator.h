@@ -0,0 +1,313 @@
+#ifndef STL_FROM_SCRATCH_ZIP_ITERATOR_H
+#define STL_FROM_SCRATCH_ZIP_ITERATOR_H
+
+#include <cstddef>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include "./iterator.h"
+#include "../utility/utility.h"
+
+namespace Readable {
+    namespace zip_detail {
+        // C++11没有折叠表达式，借助数组初始化对参数包中的每一项求值
+        typedef int expand[];
+
+        template<typename Tuple1, typename Tuple2, std::size_t... Indices>
+        void assign(Tuple1 &to, Tuple2 &&from, index_sequence<Indices...>) {
+            (void) expand{0, ((void) (std::get<Indices>(to) = std::get<Indices>(std::forward<Tuple2>(from))), 0)...};
+        }
+
+        template<typename Tuple, std::size_t... Indices>
+        void swap(const Tuple &a, const Tuple &b, index_sequence<Indices...>) {
+            using std::swap;
+            (void) expand{0, ((void) swap(std::get<Indices>(a), std::get<Indices>(b)), 0)...};
+        }
+    }
+
+    /**
+     * zip_iterator解引用得到的代理对象，保存对各个序列中对应元素的引用
+     * 对它赋值、交换就是对所引用的元素赋值、交换，因此算法可以像操作普通元素一样同步地重排多个序列
+     * 可以隐式转换成保存元素副本的值类型std::tuple<...>，也可以和它互相比较（按字典序）
+     * @tparam References 各个序列的引用类型
+     */
+    template<typename... References>
+    class zip_reference {
+    public:
+        typedef std::tuple<typename std::decay<References>::type...> value_type;
+        typedef std::tuple<References...> tuple_type;
+    private:
+        tuple_type refs;
+
+    public:
+        explicit zip_reference(References... references) : refs(std::forward<References>(references)...) {}
+
+        zip_reference(const zip_reference &) = default;
+
+        /**
+         * 代理对象之间的赋值是对元素赋值，不是让代理对象引用别的元素
+         * @note 不能用默认的复制赋值，代理对象往往是临时对象，*a = *b要作用到元素上
+         */
+        zip_reference &operator=(const zip_reference &other) {
+            zip_detail::assign(refs, other.refs, make_index_sequence<sizeof...(References)>());
+            return *this;
+        }
+
+        /**
+         * 从std::tuple赋值：左值逐个复制，右值（值类型或iter_move得到的右值引用）逐个移动
+         */
+        template<typename... Types>
+        zip_reference &operator=(const std::tuple<Types...> &values) {
+            zip_detail::assign(refs, values, make_index_sequence<sizeof...(References)>());
+            return *this;
+        }
+
+        template<typename... Types>
+        zip_reference &operator=(std::tuple<Types...> &&values) {
+            zip_detail::assign(refs, std::move(values), make_index_sequence<sizeof...(References)>());
+            return *this;
+        }
+
+        operator value_type() const {
+            return value_type(refs);
+        }
+
+        const tuple_type &as_tuple() const {
+            return refs;
+        }
+
+        friend void swap(const zip_reference &a, const zip_reference &b) {
+            zip_detail::swap(a.refs, b.refs, make_index_sequence<sizeof...(References)>());
+        }
+    };
+
+    /**
+     * 取出代理对象中第Index个序列的元素
+     */
+    template<std::size_t Index, typename... References>
+    typename std::tuple_element<Index, std::tuple<References...> >::type get(const zip_reference<References...> &ref) {
+        return std::get<Index>(ref.as_tuple());
+    }
+
+    namespace zip_detail {
+        template<typename T>
+        struct is_zip_reference : public std::false_type {
+        };
+
+        template<typename... References>
+        struct is_zip_reference<zip_reference<References...> > : public std::true_type {
+        };
+
+        template<typename... References>
+        const std::tuple<References...> &as_tuple(const zip_reference<References...> &ref) {
+            return ref.as_tuple();
+        }
+
+        template<typename... Types>
+        const std::tuple<Types...> &as_tuple(const std::tuple<Types...> &values) {
+            return values;
+        }
+
+        template<typename T1, typename T2>
+        struct enable_if_compares_zip : public std::enable_if<
+                is_zip_reference<T1>::value || is_zip_reference<T2>::value, bool> {
+        };
+    }
+
+    /**
+     * 代理对象和代理对象、代理对象和值类型之间的比较，按字典序比较各个元素
+     */
+    template<typename T1, typename T2>
+    typename zip_detail::enable_if_compares_zip<T1, T2>::type operator==(const T1 &lhs, const T2 &rhs) {
+        return zip_detail::as_tuple(lhs) == zip_detail::as_tuple(rhs);
+    }
+
+    template<typename T1, typename T2>
+    typename zip_detail::enable_if_compares_zip<T1, T2>::type operator!=(const T1 &lhs, const T2 &rhs) {
+        return zip_detail::as_tuple(lhs) != zip_detail::as_tuple(rhs);
+    }
+
+    template<typename T1, typename T2>
+    typename zip_detail::enable_if_compares_zip<T1, T2>::type operator<(const T1 &lhs, const T2 &rhs) {
+        return zip_detail::as_tuple(lhs) < zip_detail::as_tuple(rhs);
+    }
+
+    template<typename T1, typename T2>
+    typename zip_detail::enable_if_compares_zip<T1, T2>::type operator>(const T1 &lhs, const T2 &rhs) {
+        return zip_detail::as_tuple(lhs) > zip_detail::as_tuple(rhs);
+    }
+
+    template<typename T1, typename T2>
+    typename zip_detail::enable_if_compares_zip<T1, T2>::type operator<=(const T1 &lhs, const T2 &rhs) {
+        return zip_detail::as_tuple(lhs) <= zip_detail::as_tuple(rhs);
+    }
+
+    template<typename T1, typename T2>
+    typename zip_detail::enable_if_compares_zip<T1, T2>::type operator>=(const T1 &lhs, const T2 &rhs) {
+        return zip_detail::as_tuple(lhs) >= zip_detail::as_tuple(rhs);
+    }
+
+    /**
+     * 同步遍历多个随机访问序列的迭代器，第i个位置的"元素"是各个序列第i个元素组成的zip_reference
+     * 用于把分开存放的键和附带数据（struct of arrays）一起排序、反转、求排列，不需要先拼成std::pair的数组再拆回去
+     * 所有序列都用同一个位置前进，比较和求距离时只看第一个迭代器
+     * @note 算法中移动元素时要用iter_move(it)，std::move(*it)只会得到代理对象本身
+     * @tparam Iterators 各个序列的迭代器，都必须是随机访问迭代器
+     */
+    template<typename... Iterators>
+    class zip_iterator : public Readable::iterator<
+            random_access_iterator_tag,
+            std::tuple<typename iterator_traits<Iterators>::value_type...>,
+            std::ptrdiff_t,
+            void,
+            zip_reference<typename iterator_traits<Iterators>::reference...> > {
+    public:
+        typedef zip_iterator<Iterators...> self_type;
+        typedef zip_reference<typename iterator_traits<Iterators>::reference...> reference;
+        typedef std::tuple<typename iter_rvalue_reference<Iterators>::type...> rvalue_reference;
+        typedef std::ptrdiff_t difference_type;
+        typedef std::tuple<Iterators...> iterator_tuple;
+    private:
+        typedef make_index_sequence<sizeof...(Iterators)> indices;
+
+        iterator_tuple iterators;
+
+        template<std::size_t... Indices>
+        reference dereference(difference_type n, index_sequence<Indices...>) const {
+            return reference(std::get<Indices>(iterators)[n]...);
+        }
+
+        template<std::size_t... Indices>
+        rvalue_reference move_out(index_sequence<Indices...>) const {
+            return rvalue_reference(iter_move(std::get<Indices>(iterators))...);
+        }
+
+        template<std::size_t... Indices>
+        void advance_all(difference_type n, index_sequence<Indices...>) {
+            (void) zip_detail::expand{0, ((void) (std::get<Indices>(iterators) += n), 0)...};
+        }
+
+    public:
+        zip_iterator() = default;
+
+        explicit zip_iterator(Iterators... its) : iterators(its...) {}
+
+        const iterator_tuple &base() const {
+            return iterators;
+        }
+
+        reference operator*() const {
+            return dereference(0, indices());
+        }
+
+        reference operator[](difference_type n) const {
+            return dereference(n, indices());
+        }
+
+        /**
+         * iter_move的实现，得到各个元素的右值引用
+         */
+        rvalue_reference move_element() const {
+            return move_out(indices());
+        }
+
+        self_type &operator++() {
+            advance_all(1, indices());
+            return *this;
+        }
+
+        self_type operator++(int) {
+            self_type origin_this = *this;
+            advance_all(1, indices());
+            return origin_this;
+        }
+
+        self_type &operator--() {
+            advance_all(-1, indices());
+            return *this;
+        }
+
+        self_type operator--(int) {
+            self_type origin_this = *this;
+            advance_all(-1, indices());
+            return origin_this;
+        }
+
+        self_type &operator+=(difference_type n) {
+            advance_all(n, indices());
+            return *this;
+        }
+
+        self_type &operator-=(difference_type n) {
+            advance_all(-n, indices());
+            return *this;
+        }
+
+        self_type operator+(difference_type n) const {
+            self_type result = *this;
+            return result += n;
+        }
+
+        self_type operator-(difference_type n) const {
+            self_type result = *this;
+            return result -= n;
+        }
+
+        difference_type operator-(const self_type &other) const {
+            return std::get<0>(iterators) - std::get<0>(other.iterators);
+        }
+
+        bool operator==(const self_type &other) const {
+            return std::get<0>(iterators) == std::get<0>(other.iterators);
+        }
+
+        bool operator!=(const self_type &other) const {
+            return std::get<0>(iterators) != std::get<0>(other.iterators);
+        }
+
+        bool operator<(const self_type &other) const {
+            return std::get<0>(iterators) < std::get<0>(other.iterators);
+        }
+
+        bool operator>(const self_type &other) const {
+            return std::get<0>(iterators) > std::get<0>(other.iterators);
+        }
+
+        bool operator<=(const self_type &other) const {
+            return std::get<0>(iterators) <= std::get<0>(other.iterators);
+        }
+
+        bool operator>=(const self_type &other) const {
+            return std::get<0>(iterators) >= std::get<0>(other.iterators);
+        }
+    };
+
+    template<typename... Iterators>
+    zip_iterator<Iterators...> operator+(std::ptrdiff_t n, const zip_iterator<Iterators...> &it) {
+        return it + n;
+    }
+
+    template<typename... Iterators>
+    typename zip_iterator<Iterators...>::rvalue_reference iter_move(const zip_iterator<Iterators...> &it) {
+        return it.move_element();
+    }
+
+    template<typename... Iterators>
+    zip_iterator<Iterators...> make_zip_iterator(Iterators... its) {
+        return zip_iterator<Iterators...>(its...);
+    }
+
+    /**
+     * 只按第Index个序列的元素比较，用于把第Index个序列当作键排序
+     * 参数可以是zip_reference，也可以是它的值类型std::tuple
+     */
+    template<std::size_t Index>
+    struct zip_key_less {
+        template<typename T1, typename T2>
+        bool operator()(const T1 &lhs, const T2 &rhs) const {
+            return std::get<Index>(zip_detail::as_tuple(lhs)) < std::get<Index>(zip_detail::as_tuple(rhs));
+        }
+    };
+}
+
+#endif //STL_FROM_SCRATCH_ZIP_ITERATOR_H
@@ -1,7 +1,28 @@
 #include <iostream>
+#include <algorithm>
+#include <cassert>
+#include <chrono>
+#include <thread>
+#include <mutex>
+#include <string>
 #include "containers/vector.h"
 #include "containers/forward_list.h"
 #include "containers/list.h"
+#include "containers/ring_buffer.h"
+#include "containers/unrolled_list.h"
+#include "containers/intrusive_list.h"
+#include "containers/intrusive_forward_list.h"
+#include "containers/index_list.h"
+#include "algorithm/algorithm.h"
+#include "algorithm/parallel_list_sort.h"
+#include "algorithm/node_prefetch.h"
+#include "ranges/views.h"
+#include "iterator/zip_iterator.h"
+#include "concurrency/spsc_queue.h"
+#include "concurrency/mpmc_queue.h"
+#include "concurrency/treiber_stack.h"
+#include "concurrency/mpsc_queue.h"
+#include "concurrency/thread_pool.h"
 //#include "containers/deque.h"
 using namespace Readable;
 
@@ -111,6 +132,1723 @@ void test_list() {
     std::cout << std::endl;
 }
 
+void test_ring_buffer() {
+    Readable::ring_buffer<int> r(4);
+    for (int i = 0; i < 6; ++i) {
+        r.push_back(i);
+    }
+    for (auto val:r) {
+        std::cout << val << ',';
+    }
+    std::cout << std::endl;
+    auto spans = r.readable_spans();
+    std::cout << spans.first.size << ' ' << spans.second.size << std::endl;
+
+    // 写满后覆盖最老的元素，而新元素正是从最老的元素复制来的
+    Readable::ring_buffer<std::string> strings(2);
+    strings.push_back(std::string(64, 'a'));
+    strings.push_back(std::string(64, 'b'));
+    strings.push_back(strings.front());
+    assert(strings.size() == 2);
+    assert(strings[0] == std::string(64, 'b') && strings[1] == std::string(64, 'a'));
+    strings.push_back(strings.back());
+    assert(strings[0] == std::string(64, 'a') && strings[1] == std::string(64, 'a'));
+
+    // 被移走后容量为0：写入失败而不是写到空指针上，赋值后又可以正常使用
+    Readable::ring_buffer<std::string> moved(std::move(strings));
+    assert(moved.size() == 2 && strings.empty() && strings.capacity() == 0);
+    bool pushed = strings.push_back(std::string(64, 'c'));
+    assert(!pushed && strings.empty());
+    auto moved_spans = strings.writable_spans();
+    assert(moved_spans.first.size == 0 && moved_spans.second.size == 0);
+    strings = Readable::ring_buffer<std::string>(2, Readable::ring_buffer_overflow::reject_when_full);
+    strings.push_back(std::string(64, 'd'));
+    assert(strings.size() == 1 && strings.front() == std::string(64, 'd'));
+    std::cout << "moved-from ring_buffer push: " << (pushed ? "written" : "rejected") << ", writable "
+              << moved_spans.first.size + moved_spans.second.size << std::endl;
+}
+
+void test_spsc_queue() {
+    const int item_count = 1000000;
+    Readable::spsc_queue<int> queue(1024);
+    auto start = std::chrono::steady_clock::now();
+    std::thread producer([&queue, item_count]() {
+        for (int i = 0; i < item_count;) {
+            if (queue.try_push(i)) {
+                ++i;
+            }
+        }
+    });
+    long long sum = 0;
+    int buffer[64];
+    for (int received = 0; received < item_count;) {
+        auto count = queue.try_pop_n(buffer, 64);
+        for (size_t i = 0; i < count; ++i) {
+            sum += buffer[i];
+        }
+        received += count;
+    }
+    producer.join();
+    auto used = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start);
+    std::cout << sum << ' ' << used.count() / item_count << "ns/item" << std::endl;
+}
+
+void test_mpmc_queue() {
+    const int item_count_per_producer = 100000;
+    unsigned max_threads = std::thread::hardware_concurrency();
+    if (max_threads == 0) {
+        max_threads = 1;
+    }
+    for (unsigned thread_count = 1; thread_count <= max_threads; ++thread_count) {
+        Readable::mpmc_queue<int> queue(4096);
+        // 按2的幂分桶统计每次push的耗时，用于估计p99
+        std::atomic<long long> latency_histogram[64];
+        for (auto &bucket: latency_histogram) {
+            bucket.store(0);
+        }
+        auto start = std::chrono::steady_clock::now();
+        Readable::vector<std::thread> threads;
+        for (unsigned i = 0; i < thread_count; ++i) {
+            threads.push_back(std::thread([&queue, &latency_histogram, item_count_per_producer]() {
+                for (int j = 0; j < item_count_per_producer; ++j) {
+                    auto push_start = std::chrono::steady_clock::now();
+                    queue.push(j);
+                    auto used = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                            std::chrono::steady_clock::now() - push_start).count();
+                    int bucket = 0;
+                    while (used > 1) {
+                        used >>= 1;
+                        ++bucket;
+                    }
+                    ++latency_histogram[bucket];
+                }
+            }));
+            threads.push_back(std::thread([&queue, item_count_per_producer]() {
+                int value;
+                for (int j = 0; j < item_count_per_producer; ++j) {
+                    queue.pop(value);
+                }
+            }));
+        }
+        for (auto &thread: threads) {
+            thread.join();
+        }
+        auto used = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start);
+        long long total_ops = 2LL * thread_count * item_count_per_producer;
+        long long seen = 0;
+        int p99_bucket = 0;
+        for (; p99_bucket < 64; ++p99_bucket) {
+            seen += latency_histogram[p99_bucket];
+            if (seen * 100 >= total_ops / 2 * 99) {
+                break;
+            }
+        }
+        std::cout << thread_count << " producers/" << thread_count << " consumers: "
+                  << total_ops * 1000000000LL / (used.count() + 1) << " ops/s, p99 push < "
+                  << (2LL << p99_bucket) << "ns" << std::endl;
+    }
+}
+
+/**
+ * 用互斥锁保护的forward_list，作为无锁栈的对照
+ */
+struct locked_forward_list_stack {
+    std::mutex mutex;
+    Readable::forward_list<int> items;
+
+    void push(int value) {
+        std::lock_guard<std::mutex> guard(mutex);
+        items.push_front(value);
+    }
+
+    bool try_pop(int &out) {
+        std::lock_guard<std::mutex> guard(mutex);
+        if (items.empty()) {
+            return false;
+        }
+        out = items.front();
+        items.pop_front();
+        return true;
+    }
+};
+
+/**
+ * 每个线程反复取出一个空闲对象再还回去，返回每秒完成的操作数
+ */
+template<typename Stack, typename Operation>
+long long measure_free_list(Stack &stack, unsigned thread_count, int rounds_per_thread, Operation operation) {
+    for (int i = 0; i < 1024; ++i) {
+        stack.push(i);
+    }
+    auto start = std::chrono::steady_clock::now();
+    Readable::vector<std::thread> threads;
+    for (unsigned i = 0; i < thread_count; ++i) {
+        threads.push_back(std::thread([&stack, &operation, rounds_per_thread]() {
+            for (int j = 0; j < rounds_per_thread; ++j) {
+                operation(stack);
+            }
+        }));
+    }
+    for (auto &thread: threads) {
+        thread.join();
+    }
+    auto used = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start);
+    return 2LL * thread_count * rounds_per_thread * 1000000000LL / (used.count() + 1);
+}
+
+void test_treiber_stack() {
+    const int rounds_per_thread = 1000000;
+    const int batch_size = 8;
+    unsigned max_threads = std::thread::hardware_concurrency();
+    if (max_threads == 0) {
+        max_threads = 1;
+    }
+    for (unsigned thread_count = 1; thread_count <= max_threads; ++thread_count) {
+        locked_forward_list_stack locked;
+        auto locked_ops = measure_free_list(locked, thread_count, rounds_per_thread, [](locked_forward_list_stack &s) {
+            int value;
+            if (s.try_pop(value)) {
+                s.push(value);
+            }
+        });
+        Readable::treiber_stack<int> lock_free;
+        auto lock_free_ops = measure_free_list(lock_free, thread_count, rounds_per_thread,
+                                               [](Readable::treiber_stack<int> &s) {
+                                                   int value;
+                                                   if (s.try_pop(value)) {
+                                                       s.push(value);
+                                                   }
+                                               });
+        Readable::treiber_stack<int> batched;
+        auto batched_ops = measure_free_list(batched, thread_count, rounds_per_thread / batch_size,
+                                             [](Readable::treiber_stack<int> &s) {
+                                                 int values[batch_size];
+                                                 auto count = s.try_pop_n(values, batch_size);
+                                                 s.push_range(values, values + count);
+                                             }) * batch_size;
+        std::cout << thread_count << " threads: mutex + forward_list " << locked_ops << " ops/s, treiber_stack "
+                  << lock_free_ops << " ops/s, batches of " << batch_size << ' ' << batched_ops << " ops/s"
+                  << std::endl;
+    }
+}
+
+struct posted_event : Readable::atomic_forward_list_node_base {
+    int payload;
+};
+
+void test_mpsc_queue() {
+    const int events_per_producer = 500000;
+    unsigned max_threads = std::thread::hardware_concurrency();
+    if (max_threads == 0) {
+        max_threads = 1;
+    }
+    for (unsigned producer_count = 1; producer_count <= max_threads; ++producer_count) {
+        const long long total = 1LL * producer_count * events_per_producer;
+
+        // 对照：每次投递都在锁内分配一个list节点，消费者在锁内把整个链表换出来
+        std::mutex mutex;
+        Readable::list<int> pending;
+        auto start = std::chrono::steady_clock::now();
+        Readable::vector<std::thread> producers;
+        for (unsigned i = 0; i < producer_count; ++i) {
+            producers.push_back(std::thread([&mutex, &pending, events_per_producer]() {
+                for (int j = 0; j < events_per_producer; ++j) {
+                    std::lock_guard<std::mutex> guard(mutex);
+                    pending.push_back(j);
+                }
+            }));
+        }
+        long long locked_sum = 0;
+        for (long long received = 0; received < total;) {
+            Readable::list<int> batch;
+            {
+                std::lock_guard<std::mutex> guard(mutex);
+                batch.swap(pending);
+            }
+            for (auto value: batch) {
+                locked_sum += value;
+            }
+            received += batch.size();
+        }
+        for (auto &thread: producers) {
+            thread.join();
+        }
+        auto locked_used = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                std::chrono::steady_clock::now() - start);
+
+        // 事件对象预先分配好（比如在对象池中），投递不分配内存
+        Readable::intrusive_mpsc_queue<posted_event> queue;
+        Readable::vector<posted_event> events(total);
+        start = std::chrono::steady_clock::now();
+        producers.clear();
+        for (unsigned i = 0; i < producer_count; ++i) {
+            posted_event *own_events = &events[i * events_per_producer];
+            producers.push_back(std::thread([&queue, own_events, events_per_producer]() {
+                for (int j = 0; j < events_per_producer; ++j) {
+                    own_events[j].payload = j;
+                    queue.push(own_events[j]);
+                }
+            }));
+        }
+        long long queue_sum = 0;
+        for (long long received = 0; received < total;) {
+            received += queue.drain([&queue_sum](posted_event &event) { queue_sum += event.payload; }, 256);
+        }
+        for (auto &thread: producers) {
+            thread.join();
+        }
+        auto queue_used = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                std::chrono::steady_clock::now() - start);
+        assert(locked_sum == queue_sum);
+        std::cout << producer_count << " producers: mutex + list " << total * 1000000000LL / (locked_used.count() + 1)
+                  << " events/s, intrusive_mpsc_queue " << total * 1000000000LL / (queue_used.count() + 1)
+                  << " events/s" << std::endl;
+    }
+}
+
+long parallel_fib(Readable::work_stealing_pool &pool, int n) {
+    if (n < 20) {
+        return n < 2 ? n : parallel_fib(pool, n - 1) + parallel_fib(pool, n - 2);
+    }
+    long a = 0, b = 0;
+    Readable::task_group group;
+    pool.spawn(group, [&pool, &a, n]() { a = parallel_fib(pool, n - 1); });
+    b = parallel_fib(pool, n - 2);
+    pool.sync(group);
+    return a + b;
+}
+
+void parallel_quicksort(Readable::work_stealing_pool &pool, int *first, int *last) {
+    while (last - first > 1) {
+        int pivot = first[(last - first) / 2];
+        int *left = first, *right = last - 1;
+        while (left <= right) {
+            while (*left < pivot) ++left;
+            while (pivot < *right) --right;
+            if (left <= right) {
+                Readable::iter_swap(left++, right--);
+            }
+        }
+        if (last - first < 10000) {
+            parallel_quicksort(pool, first, right + 1);
+            first = left;
+            continue;
+        }
+        Readable::task_group group;
+        pool.spawn(group, [&pool, first, right]() { parallel_quicksort(pool, first, right + 1); });
+        parallel_quicksort(pool, left, last);
+        pool.sync(group);
+        return;
+    }
+}
+
+void test_work_stealing_pool() {
+    unsigned max_threads = std::thread::hardware_concurrency();
+    if (max_threads == 0) {
+        max_threads = 1;
+    }
+    for (unsigned thread_count = 1; thread_count <= max_threads; ++thread_count) {
+        Readable::work_stealing_pool pool(thread_count);
+        auto start = std::chrono::steady_clock::now();
+        long fib = parallel_fib(pool, 32);
+        auto fib_used = std::chrono::duration_cast<std::chrono::milliseconds>(
+                std::chrono::steady_clock::now() - start);
+
+        Readable::vector<int> numbers;
+        unsigned seed = 1;
+        for (int i = 0; i < 2000000; ++i) {
+            seed = seed * 1103515245 + 12345;
+            numbers.push_back(static_cast<int>(seed >> 8));
+        }
+        start = std::chrono::steady_clock::now();
+        parallel_quicksort(pool, numbers.begin(), numbers.end());
+        auto sort_used = std::chrono::duration_cast<std::chrono::milliseconds>(
+                std::chrono::steady_clock::now() - start);
+        std::cout << thread_count << " threads: fib(32)=" << fib << " in " << fib_used.count()
+                  << "ms, quicksort in " << sort_used.count() << "ms" << std::endl;
+    }
+}
+
+void test_list_sort() {
+    const int node_count = 10000000;
+    const char *names[] = {"random", "sorted", "reverse sorted"};
+    for (int kind = 0; kind < 3; ++kind) {
+        Readable::list<int> l;
+        unsigned seed = 1;
+        for (int i = 0; i < node_count; ++i) {
+            seed = seed * 1103515245 + 12345;
+            l.push_back(kind == 0 ? static_cast<int>(seed >> 8) : kind == 1 ? i : node_count - i);
+        }
+        auto start = std::chrono::steady_clock::now();
+        l.sort();
+        auto used = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start);
+        std::cout << "list::sort " << names[kind] << ": " << used.count() << "ms" << std::endl;
+    }
+}
+
+void test_forward_list_sort() {
+    const int node_count = 10000000;
+    const char *names[] = {"random", "sorted", "reverse sorted"};
+    for (int kind = 0; kind < 3; ++kind) {
+        Readable::forward_list<int> l;
+        unsigned seed = 1;
+        for (int i = 0; i < node_count; ++i) {
+            seed = seed * 1103515245 + 12345;
+            l.push_front(kind == 0 ? static_cast<int>(seed >> 8) : kind == 1 ? node_count - i : i);
+        }
+        auto start = std::chrono::steady_clock::now();
+        l.sort();
+        auto used = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start);
+        std::cout << "forward_list::sort " << names[kind] << ": " << used.count() << "ms" << std::endl;
+    }
+}
+
+void test_parallel_list_sort() {
+    const int node_count = 10000000;
+    Readable::work_stealing_pool pool;
+    for (int relocate = 0; relocate < 2; ++relocate) {
+        Readable::list<int> sequential;
+        Readable::list<int> parallel;
+        unsigned seed = 1;
+        for (int i = 0; i < node_count; ++i) {
+            seed = seed * 1103515245 + 12345;
+            sequential.push_back(static_cast<int>(seed >> 8));
+            parallel.push_back(static_cast<int>(seed >> 8));
+        }
+        auto start = std::chrono::steady_clock::now();
+        sequential.sort();
+        auto sequential_used = std::chrono::duration_cast<std::chrono::milliseconds>(
+                std::chrono::steady_clock::now() - start);
+        start = std::chrono::steady_clock::now();
+        Readable::parallel_stable_sort(Readable::parallel_policy(pool, relocate != 0), parallel);
+        auto parallel_used = std::chrono::duration_cast<std::chrono::milliseconds>(
+                std::chrono::steady_clock::now() - start);
+        for (auto it1 = sequential.begin(), it2 = parallel.begin(); it1 != sequential.end(); ++it1, ++it2) {
+            assert(*it1 == *it2);
+        }
+        std::cout << "list::sort sequential: " << sequential_used.count() << "ms, "
+                  << pool.thread_count() << " threads" << (relocate ? " with relocation: " : ": ")
+                  << parallel_used.count() << "ms" << std::endl;
+    }
+}
+
+template<typename Container>
+long long traverse_sum(const Container &container, int rounds, long long &ms) {
+    long long sum = 0;
+    auto start = std::chrono::steady_clock::now();
+    for (int round = 0; round < rounds; ++round) {
+        for (auto &value: container) {
+            sum += value;
+        }
+    }
+    ms = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start).count();
+    return sum;
+}
+
+void test_list_defragment() {
+    const int node_count = 4000000;
+    Readable::list<int> l;
+    Readable::forward_list<int> fl;
+    unsigned seed = 1;
+    for (int i = 0; i < node_count; ++i) {
+        seed = seed * 1103515245 + 12345;
+        l.push_back(static_cast<int>(seed >> 8));
+        fl.push_front(static_cast<int>(seed >> 8));
+    }
+    // 按随机值排序只改指针，遍历顺序和节点的地址顺序就完全无关了
+    l.sort();
+    fl.sort();
+    long long before, after;
+    auto sum_before = traverse_sum(l, 5, before);
+    l.defragment();
+    auto sum_after = traverse_sum(l, 5, after);
+    assert(sum_before == sum_after);
+    std::cout << "list traversal before defragment: " << before << "ms (sum " << sum_before << "), after: " << after
+              << "ms (sum " << sum_after << ")" << std::endl;
+    sum_before = traverse_sum(fl, 5, before);
+    fl.defragment();
+    sum_after = traverse_sum(fl, 5, after);
+    assert(sum_before == sum_after);
+    std::cout << "forward_list traversal before defragment: " << before << "ms (sum " << sum_before << "), after: "
+              << after << "ms (sum " << sum_after << ")" << std::endl;
+}
+
+/**
+ * 每个元素上的计算：一串互相依赖的乘加，大约几百个时钟周期，和一次内存访问的延迟相当
+ */
+long long node_prefetch_work(int value, int rounds) {
+    unsigned long long x = static_cast<unsigned>(value);
+    for (int i = 0; i < rounds; ++i) {
+        x = x * 6364136223846793005ULL + 1442695040888963407ULL;
+    }
+    return static_cast<long long>(x >> 40);
+}
+
+void test_node_prefetch() {
+    // 每个节点32字节，800万个节点远大于末级缓存
+    const int node_count = 8000000;
+    Readable::list<int> l;
+    unsigned seed = 1;
+    for (int i = 0; i < node_count; ++i) {
+        seed = seed * 1103515245 + 12345;
+        l.push_back(static_cast<int>(seed >> 8));
+    }
+    // 打乱节点的地址顺序
+    l.sort();
+    // 只做加法时前哨和遍历位置都在等同一串指针，预取没有收益；每个元素的计算越多，前哨越能走在前面
+    for (int rounds = 0; rounds <= 256; rounds = rounds ? rounds * 4 : 16) {
+        auto start = std::chrono::steady_clock::now();
+        long long plain_sum = 0;
+        for (auto value: l) {
+            plain_sum += node_prefetch_work(value, rounds);
+        }
+        auto used = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start);
+        // 输出和，否则NDEBUG下plain_sum没有用处，整个循环会被优化掉
+        std::cout << "work " << rounds << " (sum " << plain_sum << ") plain for: " << used.count() << "ms";
+        for (std::size_t distance = 2; distance <= 32; distance *= 4) {
+            long long sum = 0;
+            start = std::chrono::steady_clock::now();
+            Readable::prefetch_for_each(l.begin(), l.end(), [&sum, rounds](int value) {
+                sum += node_prefetch_work(value, rounds);
+            }, distance);
+            used = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start);
+            assert(sum == plain_sum);
+            std::cout << ", prefetch_for_each distance " << distance << ": " << used.count() << "ms"
+                      << (sum == plain_sum ? "" : " (wrong sum)");
+        }
+        std::cout << std::endl;
+    }
+
+    // 其余的算法：结果与不带预取的版本一致
+    long long expected_sum = 0;
+    for (auto value: l) {
+        expected_sum += value;
+    }
+    assert(Readable::prefetch_accumulate(l.begin(), l.end(), 0LL) == expected_sum);
+    assert(Readable::prefetch_accumulate(l.begin(), l.end(), 0LL, [](long long a, int b) { return a + b; }, 0) ==
+           expected_sum);
+    auto middle = Readable::next(l.begin(), node_count / 2);
+    int target = *middle;
+    auto first_match = l.begin();
+    while (*first_match != target) {
+        ++first_match;
+    }
+    assert(Readable::prefetch_find_if(l.begin(), l.end(), [target](int value) { return value == target; }) ==
+           first_match);
+    assert(Readable::prefetch_find_if(l.begin(), l.end(), [](int value) { return value < 0; }, 32) == l.end());
+
+    Readable::list<int> small_list;
+    Readable::forward_list<int> small_forward_list;
+    for (int i = 0; i < 1000; ++i) {
+        small_list.push_back(i);
+        small_forward_list.push_front(i);
+    }
+    assert(Readable::prefetch_accumulate(small_forward_list.begin(), small_forward_list.end(), 0) == 999 * 1000 / 2);
+    assert(*Readable::prefetch_find_if(small_forward_list.begin(), small_forward_list.end(),
+                                       [](int value) { return value < 500; }) == 499);
+    // 删除不能写在assert里，否则NDEBUG下不会执行
+    std::size_t removed_total = 0;
+    for (std::size_t distance: {0, 1, 8, 2000}) {
+        Readable::list<int> odd_list(small_list);
+        Readable::forward_list<int> odd_forward_list(small_forward_list.begin(), small_forward_list.end());
+        auto is_even = [](int value) { return value % 2 == 0; };
+        removed_total += Readable::prefetch_remove_if(odd_list, is_even, distance);
+        removed_total += Readable::prefetch_remove_if(odd_forward_list, is_even, distance);
+        assert(odd_list.size() == 500 && odd_forward_list.size() == 500);
+        assert(odd_list.front() == 1 && odd_list.back() == 999);
+        assert(odd_forward_list.front() == 999);
+        for (auto value: odd_list) {
+            assert(value % 2 == 1);
+        }
+        for (auto value: odd_forward_list) {
+            assert(value % 2 == 1);
+        }
+        auto everything = [](int) { return true; };
+        removed_total += Readable::prefetch_remove_if(odd_list, everything, distance);
+        removed_total += Readable::prefetch_remove_if(odd_forward_list, everything, distance);
+        assert(odd_list.empty() && odd_forward_list.empty());
+        assert(odd_list.begin() == odd_list.end() && odd_forward_list.begin() == odd_forward_list.end());
+    }
+    assert(removed_total == 4 * 2 * 1000);
+    std::cout << "prefetch_remove_if removed " << removed_total << " elements" << std::endl;
+}
+
+void test_forward_list_merge() {
+    const int node_count = 4000000;
+    Readable::forward_list<int> a, b, copy_a, copy_b;
+    for (int i = node_count - 1; i >= 0; --i) {
+        (i % 2 ? a : b).push_front(i);
+        (i % 2 ? copy_a : copy_b).push_front(i);
+    }
+    // 原来的做法：把other中的元素逐个复制进来再clear
+    auto start = std::chrono::steady_clock::now();
+    auto this_now = copy_a.before_begin();
+    auto other_next = copy_b.begin();
+    while (Readable::next(this_now) != copy_a.end() && other_next != copy_b.end()) {
+        if (*Readable::next(this_now) < *other_next) {
+            ++this_now;
+        } else {
+            this_now = copy_a.insert_after(this_now, *other_next++);
+        }
+    }
+    copy_a.insert_after(this_now, other_next, copy_b.end());
+    copy_b.clear();
+    auto copying_used = std::chrono::duration_cast<std::chrono::milliseconds>(
+            std::chrono::steady_clock::now() - start);
+    start = std::chrono::steady_clock::now();
+    a.merge(b);
+    auto relinking_used = std::chrono::duration_cast<std::chrono::milliseconds>(
+            std::chrono::steady_clock::now() - start);
+    assert(a.size() == static_cast<std::size_t>(node_count) && b.empty());
+    std::cout << "forward_list::merge copying: " << copying_used.count() << "ms, relinking: "
+              << relinking_used.count() << "ms" << std::endl;
+
+    const int list_count = 64;
+    Readable::vector<Readable::forward_list<int>> lists(list_count);
+    for (int i = node_count - 1; i >= 0; --i) {
+        lists[i % list_count].push_front(i);
+    }
+    Readable::forward_list<int> all;
+    start = std::chrono::steady_clock::now();
+    all.merge_all(lists.begin(), lists.end());
+    auto used = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start);
+    assert(all.size() == static_cast<std::size_t>(node_count));
+    std::cout << "forward_list::merge_all of " << list_count << " lists: " << used.count() << "ms" << std::endl;
+}
+
+void test_list_bulk_construct() {
+    const int node_count = 10000000;
+    Readable::vector<int> source;
+    source.reserve(node_count);
+    for (int i = 0; i < node_count; ++i) {
+        source.push_back(i);
+    }
+    auto start = std::chrono::steady_clock::now();
+    Readable::list<int> one_by_one;
+    for (auto value: source) {
+        one_by_one.push_back(value);
+    }
+    auto one_by_one_used = std::chrono::duration_cast<std::chrono::milliseconds>(
+            std::chrono::steady_clock::now() - start);
+    start = std::chrono::steady_clock::now();
+    Readable::list<int> bulk(source.begin(), source.end());
+    auto bulk_used = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start);
+    long long one_by_one_traverse, bulk_traverse;
+    auto sum1 = traverse_sum(one_by_one, 5, one_by_one_traverse);
+    auto sum2 = traverse_sum(bulk, 5, bulk_traverse);
+    assert(sum1 == sum2);
+    std::cout << "list build push_back: " << one_by_one_used.count() << "ms (traverse " << one_by_one_traverse
+              << "ms), range constructor: " << bulk_used.count() << "ms (traverse " << bulk_traverse << "ms)"
+              << std::endl;
+}
+
+/**
+ * 同一个节点块中的节点被splice到两个链表中后，两个链表在两个线程上清空
+ * 节点不记录自己所在的块，节点的大小与单独分配时一样
+ */
+void test_list_slab_sharing() {
+    static_assert(sizeof(Readable::list_node<int>) == 2 * sizeof(void *) + sizeof(void *),
+                  "list_node<int> should only hold two links and the value");
+    static_assert(sizeof(Readable::forward_list_node<int>) == 2 * sizeof(void *),
+                  "forward_list_node<int> should only hold one link and the value");
+    Readable::vector<int> source;
+    for (int i = 0; i < 100000; ++i) {
+        source.push_back(i);
+    }
+    for (int round = 0; round < 20; ++round) {
+        Readable::list<int> first(source.begin(), source.end());
+        Readable::list<int> second;
+        auto middle = first.begin();
+        for (int i = 0; i < 50000; ++i) {
+            ++middle;
+        }
+        second.splice(second.end(), first, middle, first.end());
+        assert(first.size() == 50000 && second.size() == 50000);
+        assert(second.front() == 50000 && first.back() == 49999);
+        std::thread clear_second([&second] { second.clear(); });
+        first.clear();
+        clear_second.join();
+        assert(first.empty() && second.empty());
+
+        Readable::forward_list<int> forward_first(source.begin(), source.end());
+        forward_first.defragment();
+        Readable::forward_list<int> forward_second;
+        auto forward_middle = forward_first.before_begin();
+        for (int i = 0; i < 50000; ++i) {
+            ++forward_middle;
+        }
+        forward_second.splice_after(forward_second.before_begin(), forward_first, forward_middle,
+                                    forward_first.end());
+        assert(forward_first.size() == 50000 && forward_second.size() == 50000);
+        assert(forward_second.front() == 50000);
+        std::thread clear_forward_second([&forward_second] { forward_second.clear(); });
+        forward_first.clear();
+        clear_forward_second.join();
+    }
+    // 交换、归并后删除节点仍然能按地址找到它所在的块
+    Readable::list<int> bulk(source.begin(), source.end());
+    Readable::list<int> single;
+    single.push_back(-1);
+    bulk.swap(single);
+    assert(bulk.size() == 1 && bulk.front() == -1 && single.size() == 100000 && single.back() == 99999);
+    single.erase(single.begin());
+    bulk.merge(single);
+    assert(bulk.size() == 100000 && single.empty());
+}
+
+/**
+ * 统计分配了多少字节的空间配置器，用来比较容器的内存占用
+ */
+struct allocation_counter {
+    static std::size_t live_bytes;
+    static std::size_t live_allocations;
+};
+
+std::size_t allocation_counter::live_bytes = 0;
+std::size_t allocation_counter::live_allocations = 0;
+
+template<typename T>
+struct counting_allocator : Readable::allocator<T> {
+    template<typename U>
+    struct rebind {
+        typedef counting_allocator<U> other;
+    };
+
+    static T *allocate(std::size_t n) {
+        allocation_counter::live_bytes += n * sizeof(T);
+        ++allocation_counter::live_allocations;
+        return Readable::allocator<T>::allocate(n);
+    }
+
+    static void deallocate(T *p, std::size_t n) {
+        if (!p) {
+            return;
+        }
+        allocation_counter::live_bytes -= n * sizeof(T);
+        --allocation_counter::live_allocations;
+        Readable::allocator<T>::deallocate(p, n);
+    }
+};
+
+/**
+ * 节点块中最后一个节点被删除时整块内存立即归还：反复整批插入再逐个删空，内存不会累积
+ * 节点被splice到另一个链表后再删除也一样
+ */
+void test_list_slab_release() {
+    typedef Readable::list<int, counting_allocator<int>> counted_list;
+    typedef Readable::forward_list<int, counting_allocator<int>> counted_forward_list;
+    Readable::vector<int> source;
+    for (int i = 0; i < 10000; ++i) {
+        source.push_back(i);
+    }
+    std::size_t bytes_before = allocation_counter::live_bytes;
+    std::size_t allocations_before = allocation_counter::live_allocations;
+    counted_list queue;
+    std::size_t peak_bytes = 0;
+    for (int round = 0; round < 2000; ++round) {
+        queue.insert(queue.end(), source.begin(), source.end());
+        // 一万个节点只分配一次
+        assert(allocation_counter::live_allocations == allocations_before + 1);
+        if (allocation_counter::live_bytes - bytes_before > peak_bytes) {
+            peak_bytes = allocation_counter::live_bytes - bytes_before;
+        }
+        while (!queue.empty()) {
+            queue.pop_front();
+        }
+        assert(allocation_counter::live_bytes == bytes_before);
+    }
+    std::cout << "list queue of " << source.size() << " nodes, 2000 rounds: peak " << peak_bytes << " bytes"
+              << std::endl;
+
+    {
+        counted_list first(source.begin(), source.end());
+        counted_list second;
+        auto middle = first.begin();
+        for (int i = 0; i < 5000; ++i) {
+            ++middle;
+        }
+        second.splice(second.end(), first, middle, first.end());
+        first.clear();
+        // 块中还有second的节点
+        assert(allocation_counter::live_allocations == allocations_before + 1);
+        while (second.size() > 1) {
+            second.pop_back();
+        }
+        assert(allocation_counter::live_allocations == allocations_before + 1);
+        second.pop_back();
+        assert(allocation_counter::live_bytes == bytes_before);
+    }
+    {
+        counted_forward_list forward(source.begin(), source.end());
+        forward.defragment();
+        assert(allocation_counter::live_allocations == allocations_before + 1);
+        while (!forward.empty()) {
+            forward.pop_front();
+        }
+        assert(allocation_counter::live_bytes == bytes_before);
+    }
+    // 节点太少时逐个分配，不占用整页
+    counted_list small(source.begin(), source.begin() + 3);
+    assert(allocation_counter::live_allocations == allocations_before + 3);
+}
+
+template<typename Container>
+void report_footprint(const char *name, int element_count) {
+    std::size_t bytes_before = allocation_counter::live_bytes;
+    std::size_t allocations_before = allocation_counter::live_allocations;
+    {
+        Container container;
+        for (int i = 0; i < element_count; ++i) {
+            container.push_back(i);
+        }
+        std::cout << name << ": " << allocation_counter::live_bytes - bytes_before << " bytes in "
+                  << allocation_counter::live_allocations - allocations_before << " allocations" << std::endl;
+    }
+}
+
+template<typename Container>
+void report_middle_insertion(const char *name, int base_count, int insert_count) {
+    Container container;
+    for (int i = 0; i < base_count; ++i) {
+        container.push_back(i);
+    }
+    auto middle = container.begin();
+    for (int i = 0; i < base_count / 2; ++i) {
+        ++middle;
+    }
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < insert_count; ++i) {
+        middle = container.insert(middle, i);
+    }
+    auto used = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start);
+    std::cout << name << " middle insertion: " << used.count() << "ms" << std::endl;
+}
+
+/**
+ * 在同一个链表中拼接：position和first、last可能在同一个节点中
+ */
+void test_unrolled_list_splice() {
+    typedef Readable::unrolled_list<int, 8> small_list;
+    small_list l{1, 2, 3, 4, 5};
+    l.splice(Readable::next(l.begin(), 4), l, l.begin(), Readable::next(l.begin(), 2));
+    int expected[] = {3, 4, 1, 2, 5};
+    assert(l.size() == 5 && std::equal(l.begin(), l.end(), expected));
+
+    small_list backward{1, 2, 3, 4, 5};
+    backward.splice(Readable::next(backward.begin(), 1), backward, Readable::next(backward.begin(), 3),
+                    backward.end());
+    int backward_expected[] = {1, 4, 5, 2, 3};
+    assert(backward.size() == 5 && std::equal(backward.begin(), backward.end(), backward_expected));
+
+    // 跨越多个节点的各种范围，和在数组上旋转的结果比较
+    const int n = 20;
+    for (int first = 0; first < n; ++first) {
+        for (int last = first; last <= n; ++last) {
+            for (int position = 0; position <= n; ++position) {
+                if (position > first && position < last) {
+                    continue;
+                }
+                small_list u;
+                int reference[n];
+                for (int i = 0; i < n; ++i) {
+                    u.push_back(i);
+                    reference[i] = i;
+                }
+                u.splice(Readable::next(u.begin(), position), u, Readable::next(u.begin(), first),
+                         Readable::next(u.begin(), last));
+                if (position <= first) {
+                    std::rotate(reference + position, reference + first, reference + last);
+                } else {
+                    std::rotate(reference + first, reference + last, reference + position);
+                }
+                assert(u.size() == static_cast<std::size_t>(n) && std::equal(u.begin(), u.end(), reference));
+            }
+        }
+    }
+}
+
+void test_unrolled_list() {
+    test_unrolled_list_splice();
+    Readable::unrolled_list<int> filled(5, 3);
+    assert(filled.size() == 5 && filled.front() == 3 && filled.back() == 3);
+
+    // swap只交换哨兵的链接，正反两个方向都要能遍历到对方原来的元素
+    Readable::unrolled_list<int, 4> many, few{7}, none;
+    for (int i = 0; i < 10; ++i) {
+        many.push_back(i);
+    }
+    many.swap(few);
+    assert(many.size() == 1 && many.front() == 7 && many.back() == 7);
+    assert(few.size() == 10 && few.front() == 0 && few.back() == 9 && *few.rbegin() == 9);
+    few.swap(none);
+    assert(few.empty() && few.begin() == few.end() && none.size() == 10 && *(--none.end()) == 9);
+    few.swap(many);
+    assert(few.size() == 1 && many.empty() && many.begin() == many.end());
+    Readable::unrolled_list<int, 4> moved(std::move(none));
+    assert(none.empty() && moved.size() == 10);
+    none = std::move(moved);
+    int expected_value = 0;
+    for (auto value: none) {
+        assert(value == expected_value);
+        ++expected_value;
+    }
+    assert(expected_value == 10 && moved.empty());
+    none.push_front(-1);
+    moved.push_back(1);
+    assert(none.front() == -1 && moved.back() == 1);
+
+    const int element_count = 10000000;
+    Readable::list<int> l;
+    Readable::vector<int> v;
+    Readable::unrolled_list<int> u;
+    for (int i = 0; i < element_count; ++i) {
+        l.push_back(i);
+        v.push_back(i);
+        u.push_back(i);
+    }
+    long long list_ms, vector_ms, unrolled_ms;
+    auto list_sum = traverse_sum(l, 5, list_ms);
+    auto vector_sum = traverse_sum(v, 5, vector_ms);
+    auto unrolled_sum = traverse_sum(u, 5, unrolled_ms);
+    assert(list_sum == vector_sum && vector_sum == unrolled_sum);
+    std::cout << "iteration list: " << list_ms << "ms, vector: " << vector_ms << "ms, unrolled_list: "
+              << unrolled_ms << "ms" << std::endl;
+
+    report_middle_insertion<Readable::list<int>>("list", 100000, 10000);
+    report_middle_insertion<Readable::vector<int>>("vector", 100000, 10000);
+    report_middle_insertion<Readable::unrolled_list<int>>("unrolled_list", 100000, 10000);
+
+    const int footprint_count = 1000000;
+    report_footprint<Readable::list<int, counting_allocator<int>>>("list", footprint_count);
+    report_footprint<Readable::vector<int, counting_allocator<int>>>("vector", footprint_count);
+    report_footprint<Readable::unrolled_list<int, Readable::unrolled_list_default_capacity<int>::value,
+            counting_allocator<int>>>("unrolled_list", footprint_count);
+}
+
+void test_index_list() {
+    // 参数引用链表自己的元素，节点数组扩容搬家也不能读到被移走的值
+    Readable::index_list<int> self_copy;
+    self_copy.push_back(43);
+    for (int i = 0; i < 100; ++i) {
+        self_copy.push_back(self_copy.front());
+        self_copy.insert(self_copy.begin(), self_copy.back());
+    }
+    for (auto value: self_copy) {
+        assert(value == 43);
+    }
+    Readable::index_list<int> filled(5, 3);
+    assert(filled.size() == 5 && filled.front() == 3 && filled.back() == 3);
+
+    // 与list相同的接口
+    auto expect = [](const Readable::index_list<int> &actual, std::initializer_list<int> expected) {
+        assert(actual.size() == expected.size());
+        auto it = actual.begin();
+        for (auto value: expected) {
+            assert(*it == value);
+            ++it;
+        }
+    };
+    Readable::index_list<int> api{1, 2, 2, 3, 3, 3};
+    api.unique();
+    expect(api, {1, 2, 3});
+    api.insert(api.begin(), 2, api.back());
+    expect(api, {3, 3, 1, 2, 3});
+    int extra[] = {7, 8};
+    // insert返回第一个插入的元素
+    api.erase(api.insert(api.end(), extra, extra + 2));
+    api.insert(api.begin(), {0});
+    expect(api, {0, 3, 3, 1, 2, 3, 8});
+    api.resize(3);
+    expect(api, {0, 3, 3});
+    api.resize(5, 9);
+    expect(api, {0, 3, 3, 9, 9});
+    api.unique([](int a, int b) { return a + 1 == b || a == b; });
+    expect(api, {0, 3, 9});
+    api.assign(Readable::next(api.begin()), api.end());
+    expect(api, {3, 9});
+    Readable::index_list<int> sorted_other{1, 3, 4, 10};
+    api.merge(sorted_other);
+    expect(api, {1, 3, 3, 4, 9, 10});
+    assert(sorted_other.empty());
+    Readable::index_list<int> tail_part{20, 21};
+    api.splice(api.end(), tail_part);
+    expect(api, {1, 3, 3, 4, 9, 10, 20, 21});
+    assert(tail_part.empty());
+    api.assign(2, 5);
+    expect(api, {5, 5});
+    api = {6};
+    expect(api, {6});
+
+    const int element_count = 4000000;
+    Readable::list<int> l;
+    Readable::index_list<int> il;
+    il.reserve(element_count);
+    // 交替在两端插入，让遍历顺序和节点在内存中的顺序不一致
+    for (int i = 0; i < element_count; ++i) {
+        if (i % 2) {
+            l.push_back(i);
+            il.push_back(i);
+        } else {
+            l.push_front(i);
+            il.push_front(i);
+        }
+    }
+    long long list_ms, index_list_ms, defragmented_ms;
+    auto list_sum = traverse_sum(l, 5, list_ms);
+    auto index_list_sum = traverse_sum(il, 5, index_list_ms);
+    il.defragment();
+    auto defragmented_sum = traverse_sum(il, 5, defragmented_ms);
+    assert(list_sum == index_list_sum && index_list_sum == defragmented_sum);
+    std::cout << "iteration list: " << list_ms << "ms, index_list: " << index_list_ms
+              << "ms, index_list after defragment: " << defragmented_ms << "ms" << std::endl;
+
+    auto start = std::chrono::steady_clock::now();
+    l.sort();
+    auto list_sort = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start);
+    start = std::chrono::steady_clock::now();
+    il.sort();
+    auto index_list_sort = std::chrono::duration_cast<std::chrono::milliseconds>(
+            std::chrono::steady_clock::now() - start);
+    auto il_it = il.begin();
+    bool same_order = true;
+    for (auto value: l) {
+        same_order = same_order && value == *il_it;
+        ++il_it;
+    }
+    assert(same_order);
+    std::cout << "sort list: " << list_sort.count() << "ms, index_list: " << index_list_sort.count() << "ms"
+              << (same_order ? "" : " (different order)") << std::endl;
+
+    const int footprint_count = 1000000;
+    report_footprint<Readable::list<int, counting_allocator<int>>>("list", footprint_count);
+    report_footprint<Readable::index_list<int, counting_allocator<int>>>("index_list", footprint_count);
+}
+
+/**
+ * 重复执行 @arg f 共 @arg rounds 次，返回耗时（微秒）
+ */
+template<typename Function>
+long long time_rounds(int rounds, Function f) {
+    auto start = std::chrono::steady_clock::now();
+    for (int round = 0; round < rounds; ++round) {
+        f();
+    }
+    return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count();
+}
+
+/**
+ * 可以平凡复制，但有const成员，不能赋值
+ */
+struct const_member_record {
+    const int id;
+};
+
+/**
+ * 可以平凡复制，但不能复制构造和复制赋值，只能移动
+ */
+struct move_only_record {
+    int id;
+
+    move_only_record() = default;
+
+    move_only_record(const move_only_record &) = delete;
+
+    move_only_record(move_only_record &&) = default;
+
+    move_only_record &operator=(const move_only_record &) = delete;
+
+    move_only_record &operator=(move_only_record &&) = default;
+};
+
+void test_contiguous_dispatch() {
+    // 平凡复制只说明复制等价于复制字节，按内存块处理还要求这个操作本身是允许的
+    static_assert(!bitwise_copy_detail::is_bitwise_copy_assignable<const_member_record *, const_member_record *>::value &&
+                  !bitwise_copy_detail::is_bitwise_move_assignable<const_member_record *, const_member_record *>::value &&
+                  bitwise_copy_detail::is_bitwise_copy_constructible<const_member_record *, const_member_record *>::value,
+                  "const members can be constructed but not assigned");
+    static_assert(!bitwise_copy_detail::is_bitwise_copy_assignable<move_only_record *, move_only_record *>::value &&
+                  bitwise_copy_detail::is_bitwise_move_assignable<move_only_record *, move_only_record *>::value &&
+                  !bitwise_copy_detail::is_bitwise_copy_constructible<move_only_record *, move_only_record *>::value &&
+                  bitwise_copy_detail::is_bitwise_move_constructible<move_only_record *, move_only_record *>::value,
+                  "move-only records can only be moved");
+    // 数据放得进L1/L2缓存，比较的是处理速度而不是内存带宽
+    const int element_count = 1 << 12;
+    const int rounds = 200000;
+    Readable::vector<int> source(element_count), target(element_count);
+    for (int i = 0; i < element_count; ++i) {
+        source[i] = i;
+    }
+    // 同样的区间，分别走按元素循环的实现和按内存块处理的实现
+    auto loop_copy = time_rounds(rounds, [&]() {
+        modifying_sequence_detail::copy(source.begin(), source.end(), target.begin(), Readable::false_type());
+    });
+    auto bulk_copy = time_rounds(rounds, [&]() {
+        Readable::copy(source.begin(), source.end(), target.begin());
+    });
+    auto loop_uninitialized_copy = time_rounds(rounds, [&]() {
+        uninitialized_memory_detail::uninitialized_copy(source.begin(), source.end(), target.begin(),
+                                                        Readable::false_type());
+    });
+    auto bulk_uninitialized_copy = time_rounds(rounds, [&]() {
+        Readable::uninitialized_copy(source.begin(), source.end(), target.begin());
+    });
+    bool same = true;
+    auto loop_equal = time_rounds(rounds, [&]() {
+        same &= non_modifying_sequence_detail::equal(source.begin(), source.end(), target.begin(),
+                                                     Readable::false_type());
+    });
+    auto bulk_equal = time_rounds(rounds, [&]() {
+        same &= Readable::equal(source.begin(), source.end(), target.begin());
+    });
+    assert(same);
+    Readable::vector<char> bytes(element_count);
+    auto loop_fill = time_rounds(rounds, [&]() {
+        modifying_sequence_detail::fill(bytes.begin(), bytes.end(), 'x', Readable::false_type());
+    });
+    auto bulk_fill = time_rounds(rounds, [&]() {
+        Readable::fill(bytes.begin(), bytes.end(), 'y');
+    });
+    assert(bytes[element_count - 1] == 'y');
+    std::cout << "copy " << loop_copy << "us -> " << bulk_copy << "us, uninitialized_copy "
+              << loop_uninitialized_copy << "us -> " << bulk_uninitialized_copy << "us, equal " << loop_equal << "us -> "
+              << bulk_equal << "us, fill " << loop_fill << "us -> " << bulk_fill << "us" << std::endl;
+}
+
+void test_range_views() {
+    const int element_count = 1 << 16;
+    const int rounds = 2000;
+    Readable::vector<int> source(element_count);
+    for (int i = 0; i < element_count; ++i) {
+        source[i] = i;
+    }
+    auto is_odd = [](int x) { return x % 2 != 0; };
+    auto square = [](int x) { return (long long) x * x; };
+    // 每一步都生成一个中间容器
+    long long eager_sum = 0;
+    auto eager = time_rounds(rounds, [&]() {
+        Readable::vector<int> odd;
+        for (int x : source) {
+            if (is_odd(x)) {
+                odd.push_back(x);
+            }
+        }
+        Readable::vector<long long> squares;
+        for (int x : odd) {
+            squares.push_back(square(x));
+        }
+        for (std::size_t i = 0; i < squares.size() && i < element_count / 4; ++i) {
+            eager_sum += squares[i];
+        }
+    });
+    // 视图在一次遍历中完成所有步骤，不分配内存
+    long long lazy_sum = 0;
+    auto lazy = time_rounds(rounds, [&]() {
+        for (long long x : source | Readable::views::filter(is_odd) | Readable::views::transform(square)
+                           | Readable::views::take(element_count / 4)) {
+            lazy_sum += x;
+        }
+    });
+    assert(eager_sum == lazy_sum);
+    // 视图不改变元素的访问方式：连续的区间经过take、drop之后仍是连续的
+    auto middle = source | Readable::views::drop(16) | Readable::views::take(element_count / 2);
+    static_assert(Readable::is_contiguous_iterator<decltype(middle.begin())>::value,
+                  "take/drop keep contiguous iterators");
+    assert(middle.size() == element_count / 2 && middle[0] == 16);
+    Readable::list<int> numbers;
+    for (int i = 0; i < 100; ++i) {
+        numbers.push_back(i);
+    }
+    int chunk_sum = 0;
+    for (auto chunk : numbers | Readable::views::reversed | Readable::views::chunk(8)) {
+        chunk_sum += *chunk.begin();
+    }
+    int stride_sum = 0;
+    for (int x : numbers | Readable::views::stride(8)) {
+        stride_sum += x;
+    }
+    // 逆序后每块的第一个是99, 91, ..., 3，正序每隔8个是0, 8, ..., 96
+    assert(chunk_sum == 663 && stride_sum == 624);
+    std::cout << "filter|transform|take: eager " << eager << "us, lazy " << lazy << "us" << std::endl;
+}
+
+/**
+ * 有重复元素时只枚举不同的排列，与std::next_permutation逐个对照
+ */
+void test_permutation() {
+    int step[] = {1, 2, 1};
+    assert(Readable::next_permutation(step, step + 3));
+    assert(step[0] == 2 && step[1] == 1 && step[2] == 1);
+    assert(Readable::prev_permutation(step, step + 3));
+    assert(step[0] == 1 && step[1] == 2 && step[2] == 1);
+
+    int values[] = {1, 1, 2, 2, 3}, expected[] = {1, 1, 2, 2, 3};
+    int forward_count = 1;
+    bool more = true;
+    while (more) {
+        more = Readable::next_permutation(values, values + 5);
+        bool expected_more = std::next_permutation(expected, expected + 5);
+        assert(more == expected_more && Readable::equal(values, values + 5, expected));
+        forward_count += more;
+    }
+    // 回到了第一个排列，倒过来再数一遍
+    Readable::reverse(values, values + 5);
+    Readable::reverse(expected, expected + 5);
+    int backward_count = 1;
+    more = true;
+    while (more) {
+        more = Readable::prev_permutation(values, values + 5);
+        bool expected_more = std::prev_permutation(expected, expected + 5);
+        assert(more == expected_more && Readable::equal(values, values + 5, expected));
+        backward_count += more;
+    }
+    // 5! / (2! * 2!) = 30
+    assert(forward_count == 30 && backward_count == 30);
+    std::cout << "permutations of 1,1,2,2,3: " << forward_count << " forward, " << backward_count << " backward"
+              << std::endl;
+}
+
+void test_zip_iterator() {
+    const int element_count = 1000000;
+    Readable::vector<int> keys(element_count);
+    Readable::vector<double> payloads(element_count);
+    unsigned seed = 1;
+    for (int i = 0; i < element_count; ++i) {
+        seed = seed * 1103515245 + 12345;
+        keys[i] = static_cast<int>(seed >> 8);
+        payloads[i] = keys[i] * 0.5;
+    }
+    Readable::vector<int> pair_keys(element_count);
+    Readable::vector<double> pair_payloads(element_count);
+    Readable::copy(keys.begin(), keys.end(), pair_keys.begin());
+    Readable::copy(payloads.begin(), payloads.end(), pair_payloads.begin());
+    Readable::work_stealing_pool pool(1);
+    // 拼成pair的数组排序，再拆回两个数组
+    auto start = std::chrono::steady_clock::now();
+    Readable::vector<std::pair<int, double> > pairs(element_count);
+    for (int i = 0; i < element_count; ++i) {
+        pairs[i] = std::make_pair(pair_keys[i], pair_payloads[i]);
+    }
+    Readable::parallel_stable_sort(Readable::parallel_policy(pool), pairs.begin(), pairs.end(),
+                                   [](const std::pair<int, double> &a, const std::pair<int, double> &b) {
+                                       return a.first < b.first;
+                                   });
+    for (int i = 0; i < element_count; ++i) {
+        pair_keys[i] = pairs[i].first;
+        pair_payloads[i] = pairs[i].second;
+    }
+    auto pair_used = std::chrono::duration_cast<std::chrono::milliseconds>(
+            std::chrono::steady_clock::now() - start);
+    // 直接在两个数组上同步排序
+    start = std::chrono::steady_clock::now();
+    auto first = Readable::make_zip_iterator(keys.begin(), payloads.begin());
+    Readable::parallel_stable_sort(Readable::parallel_policy(pool), first, first + element_count,
+                                   Readable::zip_key_less<0>());
+    auto zip_used = std::chrono::duration_cast<std::chrono::milliseconds>(
+            std::chrono::steady_clock::now() - start);
+    for (int i = 0; i < element_count; ++i) {
+        assert(keys[i] == pair_keys[i] && payloads[i] == pair_payloads[i]);
+    }
+    // 其他算法同样作用在所有数组上
+    Readable::reverse(first, first + element_count);
+    assert(keys[0] == pair_keys[element_count - 1] && payloads[0] == keys[0] * 0.5);
+    Readable::sort(first, first + element_count, Readable::zip_key_less<0>());
+    for (int i = 0; i < element_count; ++i) {
+        assert(keys[i] == pair_keys[i] && payloads[i] == keys[i] * 0.5);
+    }
+    Readable::reverse(first, first + element_count);
+    Readable::sort(first, first + element_count);
+    for (int i = 0; i < element_count; ++i) {
+        assert(keys[i] == pair_keys[i] && payloads[i] == keys[i] * 0.5);
+    }
+
+    // stable_sort：键相同的元素保持原来的相对顺序，负载记录原来的下标
+    const int stable_count = 100000;
+    Readable::vector<int> stable_keys(stable_count), original_index(stable_count);
+    for (int i = 0; i < stable_count; ++i) {
+        stable_keys[i] = (i * 7919) % 97;
+        original_index[i] = i;
+    }
+    auto stable_first = Readable::make_zip_iterator(stable_keys.begin(), original_index.begin());
+    Readable::stable_sort(stable_first, stable_first + stable_count, Readable::zip_key_less<0>());
+    for (int i = 0; i < stable_count; ++i) {
+        assert(stable_keys[i] == (original_index[i] * 7919) % 97);
+        assert(i == 0 || stable_keys[i - 1] < stable_keys[i] ||
+               (stable_keys[i - 1] == stable_keys[i] && original_index[i - 1] < original_index[i]));
+    }
+
+    // next_permutation、prev_permutation：每个排列中两个数组都保持对应
+    int permutation_keys[] = {1, 2, 3, 4};
+    char permutation_tags[] = {'a', 'b', 'c', 'd'};
+    auto permutation_first = Readable::make_zip_iterator(permutation_keys + 0, permutation_tags + 0);
+    auto permutation_last = permutation_first + 4;
+    int permutation_count = 1;
+    while (Readable::next_permutation(permutation_first, permutation_last)) {
+        ++permutation_count;
+        for (int i = 0; i < 4; ++i) {
+            assert(permutation_tags[i] == 'a' + permutation_keys[i] - 1);
+        }
+    }
+    assert(permutation_count == 24);
+    assert(permutation_keys[0] == 1 && permutation_keys[3] == 4 && permutation_tags[3] == 'd');
+    // 从最大的排列开始往回数
+    Readable::reverse(permutation_first, permutation_last);
+    int backwards_count = 1;
+    while (Readable::prev_permutation(permutation_first, permutation_last)) {
+        ++backwards_count;
+        for (int i = 0; i < 4; ++i) {
+            assert(permutation_tags[i] == 'a' + permutation_keys[i] - 1);
+        }
+    }
+    assert(backwards_count == 24);
+    std::cout << "zip_iterator permutations: " << permutation_count << " forward, " << backwards_count
+              << " backward" << std::endl;
+    std::cout << "stable sort of keys + payloads: via pair array " << pair_used.count() << "ms, zip_iterator "
+              << zip_used.count() << "ms" << std::endl;
+}
+
+/**
+ * 生成测试排序用的几种输入
+ */
+void fill_sort_input(Readable::vector<int> &data, int pattern) {
+    int size = static_cast<int>(data.size());
+    unsigned seed = 1;
+    for (int i = 0; i < size; ++i) {
+        seed = seed * 1103515245 + 12345;
+        switch (pattern) {
+            case 0: // 随机
+                data[i] = static_cast<int>(seed >> 1);
+                break;
+            case 1: // 有序
+                data[i] = i;
+                break;
+            case 2: // 逆序
+                data[i] = size - i;
+                break;
+            case 3: // 先升后降
+                data[i] = i < size / 2 ? i : size - i;
+                break;
+            case 4: // 有序，末尾追加少量随机元素
+                data[i] = i < size - size / 100 ? i : static_cast<int>(seed >> 1) % size;
+                break;
+            default: // 大量重复
+                data[i] = static_cast<int>(seed >> 16) % 16;
+                break;
+        }
+    }
+}
+
+void test_sort() {
+    const int element_count = 1000000;
+    const char *pattern_names[] = {"random", "sorted", "reversed", "organ pipe", "sorted + 1% random", "16 distinct"};
+    Readable::vector<int> data(element_count), expected(element_count);
+    for (int pattern = 0; pattern < 6; ++pattern) {
+        fill_sort_input(expected, pattern);
+        auto std_used = time_rounds(1, [&]() { std::sort(expected.begin(), expected.end()); });
+        fill_sort_input(data, pattern);
+        auto used = time_rounds(1, [&]() { Readable::sort(data.begin(), data.end()); });
+        assert(Readable::equal(data.begin(), data.end(), expected.begin()));
+        // 自定义比较函数不走分块划分
+        fill_sort_input(data, pattern);
+        auto branchy_used = time_rounds(1, [&]() {
+            Readable::sort(data.begin(), data.end(), [](int a, int b) { return a < b; });
+        });
+        assert(Readable::equal(data.begin(), data.end(), expected.begin()));
+        std::cout << "sort " << pattern_names[pattern] << ": std::sort " << std_used << "us, Readable::sort "
+                  << used << "us, with lambda comparator " << branchy_used << "us" << std::endl;
+    }
+}
+
+/**
+ * 只能移动，而且移动操作没有声明noexcept：parallel_sort会退回到parallel_stable_sort
+ * 移动后源对象的key变成-1，排序中误用了被移走的元素就会被发现
+ */
+struct throwing_move_key {
+    int key;
+
+    throwing_move_key() : key(0) {}
+
+    throwing_move_key(const throwing_move_key &) = delete;
+
+    throwing_move_key(throwing_move_key &&other) noexcept(false) : key(other.key) {
+        other.key = -1;
+    }
+
+    throwing_move_key &operator=(const throwing_move_key &) = delete;
+
+    throwing_move_key &operator=(throwing_move_key &&other) noexcept(false) {
+        key = other.key;
+        other.key = -1;
+        return *this;
+    }
+
+    bool operator<(const throwing_move_key &other) const {
+        return key < other.key;
+    }
+};
+
+void test_parallel_sort() {
+    {
+        const int key_count = 200000;
+        Readable::vector<throwing_move_key> keys(key_count);
+        for (int i = 0; i < key_count; ++i) {
+            keys[i].key = (i * 7919) % key_count;
+        }
+        Readable::work_stealing_pool pool(2);
+        Readable::parallel_sort(Readable::parallel_policy(pool), keys.begin(), keys.end());
+        for (int i = 0; i < key_count; ++i) {
+            assert(keys[i].key == i);
+        }
+        for (int i = 0; i < key_count; ++i) {
+            keys[i].key = key_count - 1 - i;
+        }
+        Readable::parallel_stable_sort(Readable::parallel_policy(pool), keys.begin(), keys.end());
+        for (int i = 0; i < key_count; ++i) {
+            assert(keys[i].key == i);
+        }
+
+        // 移动后源字符串为空，结果中不能出现空串
+        Readable::vector<std::string> words(key_count);
+        for (int i = 0; i < key_count; ++i) {
+            words[i] = std::to_string((i * 7919) % key_count + key_count);
+        }
+        Readable::parallel_stable_sort(Readable::parallel_policy(pool), words.begin(), words.end());
+        for (int i = 0; i < key_count; ++i) {
+            assert(words[i] == std::to_string(i + key_count));
+        }
+    }
+
+    const int element_count = 20000000;
+    Readable::vector<std::uint64_t> source(element_count), data(element_count), expected(element_count);
+    std::uint64_t seed = 1;
+    for (int i = 0; i < element_count; ++i) {
+        seed = seed * 6364136223846793005ULL + 1442695040888963407ULL;
+        source[i] = seed;
+    }
+    Readable::copy(source.begin(), source.end(), expected.begin());
+    auto sequential_used = time_rounds(1, [&]() { Readable::sort(expected.begin(), expected.end()); });
+    std::cout << "sort " << element_count << " uint64: sequential " << sequential_used / 1000 << "ms" << std::endl;
+    unsigned max_threads = std::thread::hardware_concurrency();
+    if (max_threads == 0) {
+        max_threads = 1;
+    }
+    for (unsigned threads = 1; threads <= max_threads; ++threads) {
+        Readable::work_stealing_pool pool(threads);
+        Readable::copy(source.begin(), source.end(), data.begin());
+        auto unstable_used = time_rounds(1, [&]() {
+            Readable::parallel_sort(Readable::parallel_policy(pool), data.begin(), data.end());
+        });
+        assert(Readable::equal(data.begin(), data.end(), expected.begin()));
+        Readable::copy(source.begin(), source.end(), data.begin());
+        auto stable_used = time_rounds(1, [&]() {
+            Readable::parallel_stable_sort(Readable::parallel_policy(pool), data.begin(), data.end());
+        });
+        assert(Readable::equal(data.begin(), data.end(), expected.begin()));
+        std::cout << threads << " threads: parallel_sort " << unstable_used / 1000 << "ms (x"
+                  << (double) sequential_used / unstable_used << "), parallel_stable_sort " << stable_used / 1000
+                  << "ms (x" << (double) sequential_used / stable_used << ")" << std::endl;
+    }
+}
+
+struct sort_record {
+    double score;
+    int id;
+};
+
+/**
+ * 整数、浮点数和按字段排序的结构体：比较排序和基数排序
+ */
+void test_radix_sort() {
+    const int element_count = 1 << 16;
+    const int rounds = 20;
+    Readable::vector<std::uint32_t> source(element_count), data(element_count), expected(element_count);
+    Readable::vector<double> double_source(element_count), doubles(element_count), double_expected(element_count);
+    Readable::vector<sort_record> record_source(element_count), records(element_count);
+    std::uint64_t seed = 1;
+    for (int i = 0; i < element_count; ++i) {
+        seed = seed * 6364136223846793005ULL + 1442695040888963407ULL;
+        source[i] = static_cast<std::uint32_t>(seed >> 32);
+        double_source[i] = static_cast<double>(static_cast<std::int64_t>(seed)) / 1e9;
+        record_source[i].score = double_source[i];
+        record_source[i].id = i;
+    }
+
+    auto std_used = time_rounds(rounds, [&]() {
+        Readable::copy(source.begin(), source.end(), expected.begin());
+        std::sort(expected.begin(), expected.end());
+    });
+    auto radix_used = time_rounds(rounds, [&]() {
+        Readable::copy(source.begin(), source.end(), data.begin());
+        Readable::radix_sort(data.begin(), data.end());
+    });
+    assert(Readable::equal(data.begin(), data.end(), expected.begin()));
+    auto flag_used = time_rounds(rounds, [&]() {
+        Readable::copy(source.begin(), source.end(), data.begin());
+        Readable::american_flag_sort(data.begin(), data.end());
+    });
+    assert(Readable::equal(data.begin(), data.end(), expected.begin()));
+    std::cout << element_count << " uint32: std::sort " << std_used << "us, radix_sort " << radix_used
+              << "us, american_flag_sort " << flag_used << "us" << std::endl;
+
+    // 不连续的迭代器只能原地排序；反向迭代器和本库的算法在同一个命名空间中，实参依赖查找不能产生歧义
+    typedef Readable::reverse_iterator<std::uint32_t *> reversed;
+    reversed data_rbegin(data.begin() + element_count), data_rend(data.begin());
+    Readable::copy(source.begin(), source.end(), data.begin());
+    Readable::radix_sort(data_rbegin, data_rend);
+    assert(Readable::equal(data_rbegin, data_rend, expected.begin()));
+    Readable::copy(source.begin(), source.end(), data.begin());
+    Readable::radix_sort(data_rbegin, data_rend, [](std::uint32_t value) { return value; });
+    assert(Readable::equal(data_rbegin, data_rend, expected.begin()));
+
+    std_used = time_rounds(rounds, [&]() {
+        Readable::copy(double_source.begin(), double_source.end(), double_expected.begin());
+        std::sort(double_expected.begin(), double_expected.end(), std::greater<double>());
+    });
+    // Readable::sort对连续存放的浮点数和std::greater自动改用基数排序
+    radix_used = time_rounds(rounds, [&]() {
+        Readable::copy(double_source.begin(), double_source.end(), doubles.begin());
+        Readable::sort(doubles.begin(), doubles.end(), std::greater<double>());
+    });
+    assert(Readable::equal(doubles.begin(), doubles.end(), double_expected.begin()));
+    std::cout << element_count << " double descending: std::sort " << std_used << "us, Readable::sort "
+              << radix_used << "us" << std::endl;
+
+    auto by_score = [](const sort_record &a, const sort_record &b) { return a.score < b.score; };
+    std_used = time_rounds(rounds, [&]() {
+        Readable::copy(record_source.begin(), record_source.end(), records.begin());
+        std::stable_sort(records.begin(), records.end(), by_score);
+    });
+    radix_used = time_rounds(rounds, [&]() {
+        Readable::copy(record_source.begin(), record_source.end(), records.begin());
+        Readable::radix_sort(records.begin(), records.end(), [](const sort_record &r) { return r.score; });
+    });
+    assert(Readable::is_sorted(records.begin(), records.end(), by_score));
+    std::cout << element_count << " records by score: std::stable_sort " << std_used << "us, radix_sort "
+              << radix_used << "us" << std::endl;
+}
+
+/**
+ * 申请不到内存的空间配置器，用来测试stable_sort退化为原地归并
+ */
+template<typename T>
+struct no_memory_allocator {
+    T *allocate(std::size_t) {
+        throw std::bad_alloc();
+    }
+
+    void deallocate(T *, std::size_t) {
+    }
+};
+
+/**
+ * 申请不到辅助空间时只用旋转实现的原地归并：长度悬殊的两段旋转时不能递归很深
+ */
+void test_stable_sort_without_buffer() {
+    const int element_count = 1000000;
+    Readable::vector<int> keys(element_count), expected(element_count);
+    for (int pattern = 0; pattern < 7; ++pattern) {
+        if (pattern < 6) {
+            fill_sort_input(keys, pattern);
+        } else {
+            // 有序，只有最后一个元素最小：最后一次归并是一百万个元素和一个元素
+            for (int i = 0; i < element_count; ++i) {
+                keys[i] = i + 1;
+            }
+            keys[element_count - 1] = 0;
+        }
+        Readable::copy(keys.begin(), keys.end(), expected.begin());
+        std::sort(expected.begin(), expected.end());
+        Readable::stable_sort(keys.begin(), keys.end(), Readable::less<int>(), no_memory_allocator<int>());
+        assert(Readable::equal(keys.begin(), keys.end(), expected.begin()));
+    }
+}
+
+/**
+ * 有序的数据后面追加少量元素等接近有序的输入：timsort和std::stable_sort
+ */
+void test_stable_sort() {
+    const int element_count = 1000000;
+    const char *pattern_names[] = {"random", "sorted", "reversed", "organ pipe", "sorted + 1% random", "16 distinct"};
+    Readable::vector<int> keys(element_count);
+    Readable::vector<sort_record> records(element_count), expected(element_count);
+    auto by_score = [](const sort_record &a, const sort_record &b) { return a.score < b.score; };
+    for (int pattern = 0; pattern < 6; ++pattern) {
+        fill_sort_input(keys, pattern);
+        auto fill_records = [&](Readable::vector<sort_record> &to) {
+            for (int i = 0; i < element_count; ++i) {
+                to[i].score = keys[i];
+                to[i].id = i;
+            }
+        };
+        fill_records(expected);
+        auto std_used = time_rounds(1, [&]() { std::stable_sort(expected.begin(), expected.end(), by_score); });
+        fill_records(records);
+        auto used = time_rounds(1, [&]() {
+            Readable::stable_sort(records.begin(), records.end(), by_score, records.get_allocator());
+        });
+        for (int i = 0; i < element_count; ++i) {
+            assert(records[i].score == expected[i].score && records[i].id == expected[i].id);
+        }
+        fill_records(records);
+        auto in_place_used = time_rounds(1, [&]() {
+            Readable::stable_sort(records.begin(), records.end(), by_score, no_memory_allocator<sort_record>());
+        });
+        for (int i = 0; i < element_count; ++i) {
+            assert(records[i].score == expected[i].score && records[i].id == expected[i].id);
+        }
+        std::cout << "stable sort " << pattern_names[pattern] << ": std::stable_sort " << std_used
+                  << "us, Readable::stable_sort " << used << "us, without buffer " << in_place_used << "us"
+                  << std::endl;
+    }
+}
+
+/**
+ * 大量长度固定的小数组：插入排序和排序网络
+ */
+template<int N>
+void test_sorting_network_size() {
+    const int array_count = 1 << 16;
+    Readable::vector<double> source(array_count * N), data(array_count * N), expected(array_count * N);
+    unsigned seed = 1;
+    for (int i = 0; i < array_count * N; ++i) {
+        seed = seed * 1103515245 + 12345;
+        source[i] = static_cast<double>(seed >> 8);
+    }
+    Readable::copy(source.begin(), source.end(), expected.begin());
+    auto std_used = time_rounds(1, [&]() {
+        for (int i = 0; i < array_count; ++i) {
+            std::sort(expected.begin() + i * N, expected.begin() + (i + 1) * N);
+        }
+    });
+    Readable::copy(source.begin(), source.end(), data.begin());
+    auto network_used = time_rounds(1, [&]() {
+        for (int i = 0; i < array_count; ++i) {
+            Readable::sorting_network<N>::sort(data.begin() + i * N);
+        }
+    });
+    assert(Readable::equal(data.begin(), data.end(), expected.begin()));
+    Readable::copy(source.begin(), source.end(), data.begin());
+    auto dispatch_used = time_rounds(1, [&]() {
+        for (int i = 0; i < array_count; ++i) {
+            Readable::small_sort(data.begin() + i * N, data.begin() + (i + 1) * N);
+        }
+    });
+    assert(Readable::equal(data.begin(), data.end(), expected.begin()));
+    std::cout << array_count << " arrays of " << N << " doubles: std::sort " << std_used << "us, sorting_network "
+              << network_used << "us, small_sort " << dispatch_used << "us" << std::endl;
+}
+
+void test_sorting_network() {
+    test_sorting_network_size<4>();
+    test_sorting_network_size<8>();
+    test_sorting_network_size<16>();
+    test_sorting_network_size<32>();
+    int fixed[5] = {3, 1, 4, 1, 5};
+    Readable::network_sort(fixed);
+    assert(Readable::is_sorted(fixed, fixed + 5));
+}
+
+struct lru_tag {
+};
+
+/**
+ * 放在对象池里的连接：同时在"所有连接"和"LRU"两个链表中，空闲时在空闲链表中
+ */
+struct pooled_connection : Readable::intrusive_list_hook<>,
+                           Readable::intrusive_list_hook<lru_tag, true>,
+                           Readable::intrusive_forward_list_hook<> {
+    int id;
+
+    explicit pooled_connection(int the_id = 0) : id(the_id) {}
+};
+
+/**
+ * 按顺序列出链表中的id，如"3 7 1"
+ */
+template<typename List>
+std::string id_sequence(const List &connections) {
+    std::string result;
+    for (auto &connection: connections) {
+        if (!result.empty()) {
+            result += ' ';
+        }
+        result += std::to_string(connection.id);
+    }
+    return result;
+}
+
+void test_intrusive_list() {
+    typedef Readable::intrusive_list_hook<lru_tag, true> lru_hook;
+    Readable::vector<pooled_connection> pool(8);
+    Readable::intrusive_list<pooled_connection> all;
+    Readable::intrusive_list<pooled_connection, lru_hook> lru;
+    Readable::intrusive_forward_list<pooled_connection> free_connections;
+    for (int i = 0; i < 8; ++i) {
+        pool[i].id = i;
+        all.push_back(pool[i]);
+        if (i % 2) {
+            lru.push_back(pool[i]);
+        } else {
+            free_connections.push_front(pool[i]);
+        }
+    }
+    // 最近使用过的移到LRU的末尾，O(1)
+    lru.splice(lru.end(), lru, lru.iterator_to(pool[1]));
+    assert(lru.back().id == 1);
+    // 从任意位置直接摘下，不需要知道它在哪个链表里
+    static_cast<lru_hook &>(pool[5]).unlink();
+    assert(lru.size() == 3 && all.size() == 8 && free_connections.size() == 4);
+    assert(id_sequence(lru) == "3 7 1" && !static_cast<lru_hook &>(pool[5]).is_linked());
+
+    // 摘下元素只是断开链接，元素还在对象池里，其他链表也不受影响
+    all.erase(all.iterator_to(pool[2]));
+    all.remove(pool[3]);
+    assert(!static_cast<Readable::intrusive_list_hook<> &>(pool[2]).is_linked());
+    assert(static_cast<lru_hook &>(pool[3]).is_linked());
+    all.erase(all.begin(), all.iterator_to(pool[5]));
+    assert(id_sequence(all) == "5 6 7" && all.size() == 3 && id_sequence(lru) == "3 7 1");
+
+    // 在两个链表之间移动单个元素、一段元素和整个链表，元素个数跟着走
+    Readable::intrusive_list<pooled_connection> retired;
+    retired.push_back(pool[0]);
+    retired.push_back(pool[2]);
+    all.splice(all.iterator_to(pool[6]), retired, retired.iterator_to(pool[2]));
+    assert(id_sequence(all) == "5 2 6 7" && all.size() == 4 && retired.size() == 1);
+    all.splice(all.end(), retired);
+    assert(id_sequence(all) == "5 2 6 7 0" && all.size() == 5 && retired.empty());
+    retired.splice(retired.end(), all, all.iterator_to(pool[6]), all.end());
+    assert(id_sequence(all) == "5 2" && all.size() == 2 && id_sequence(retired) == "6 7 0" && retired.size() == 3);
+    all.swap(retired);
+    all.sort([](const pooled_connection &a, const pooled_connection &b) { return a.id < b.id; });
+    assert(id_sequence(all) == "0 6 7" && id_sequence(retired) == "5 2");
+
+    // 单向链表：只能在某个元素之后插入、摘下和移动
+    free_connections.pop_front();
+    free_connections.erase_after(free_connections.iterator_to(pool[4]));
+    free_connections.insert_after(free_connections.iterator_to(pool[0]), pool[6]);
+    assert(id_sequence(free_connections) == "4 0 6" && free_connections.size() == 3);
+    Readable::intrusive_forward_list<pooled_connection> reserved;
+    reserved.push_front(pool[2]);
+    reserved.splice_after(reserved.begin(), free_connections, free_connections.iterator_to(pool[0]));
+    assert(id_sequence(reserved) == "2 6" && id_sequence(free_connections) == "4 0");
+    assert(reserved.size() == 2 && free_connections.size() == 2);
+    free_connections.splice_after(free_connections.before_begin(), reserved);
+    free_connections.sort([](const pooled_connection &a, const pooled_connection &b) { return a.id < b.id; });
+    assert(id_sequence(free_connections) == "0 2 4 6" && free_connections.size() == 4 && reserved.empty());
+
+    // AutoUnlink的钩子：链表中的对象析构时自己摘下，链表仍然完好
+    {
+        pooled_connection temporary(100);
+        lru.push_back(temporary);
+        assert(lru.size() == 4 && lru.back().id == 100);
+    }
+    assert(lru.size() == 3 && id_sequence(lru) == "3 7 1");
+    // 复制出的对象不在任何链表中
+    pooled_connection copy(pool[3]);
+    assert(!static_cast<lru_hook &>(copy).is_linked() && lru.size() == 3);
+    std::cout << "all: " << id_sequence(all) << ", lru: " << id_sequence(lru) << ", free: "
+              << id_sequence(free_connections) << ", copy of " << copy.id << std::endl;
+}
+
 int main() {
     vector<int> v{1, 2, 3, 4};
     for (auto val:v) {
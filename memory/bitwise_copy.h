@@ -0,0 +1,175 @@
+#ifndef STL_FROM_SCRATCH_BITWISE_COPY_H
+#define STL_FROM_SCRATCH_BITWISE_COPY_H
+
+#include <cstddef>
+#include <cstring>
+#include <type_traits>
+#include "../iterator/iterator_traits.h"
+#include "../type_traits/type_traits.h"
+
+namespace Readable {
+    /**
+     * copy、move、fill、equal以及uninitialized_*共用的判断和实现：
+     * 区间是连续迭代器、元素又可以平凡复制时，逐个元素的赋值、构造、比较等价于对整块内存做memmove、memset、memcmp，
+     * 后者是C库里用SIMD写好的，比逐个元素的循环快得多
+     */
+    namespace bitwise_copy_detail {
+        template<typename Reference>
+        struct is_writable_reference : public Readable::true_type {
+        };
+
+        template<typename T>
+        struct is_writable_reference<const T &> : public Readable::false_type {
+        };
+
+        template<typename T>
+        struct is_pointer : public Readable::false_type {
+        };
+
+        template<typename T>
+        struct is_pointer<T *> : public Readable::true_type {
+        };
+
+        template<typename Iterator>
+        struct element_type {
+            typedef typename Readable::remove_cv<typename iterator_traits<Iterator>::value_type>::type type;
+        };
+
+        /**
+         * 从InputIt到OutputIt的元素在内存层面能否直接memmove：
+         * 两个都是连续迭代器，元素类型相同且可以平凡复制，目标可写
+         * 平凡复制只说明复制等价于复制字节，不说明这个操作是允许的（比如有const成员的类型不能赋值），
+         * 因此还要按具体的操作检查，见下面的四个判断
+         */
+        template<typename InputIt, typename OutputIt>
+        struct is_bitwise_copyable : public Readable::integral_constant<bool,
+                Readable::is_contiguous_iterator<InputIt>::value &&
+                Readable::is_contiguous_iterator<OutputIt>::value &&
+                Readable::is_same<typename element_type<InputIt>::type, typename element_type<OutputIt>::type>::value &&
+                Readable::is_trivially_copyable<typename element_type<OutputIt>::type>::value &&
+                is_writable_reference<typename iterator_traits<OutputIt>::reference>::value> {
+        };
+
+        /**
+         * copy、copy_backward：元素还要可以复制赋值
+         */
+        template<typename InputIt, typename OutputIt>
+        struct is_bitwise_copy_assignable : public Readable::integral_constant<bool,
+                is_bitwise_copyable<InputIt, OutputIt>::value &&
+                std::is_copy_assignable<typename element_type<OutputIt>::type>::value> {
+        };
+
+        /**
+         * move、move_backward：元素还要可以移动赋值
+         */
+        template<typename InputIt, typename OutputIt>
+        struct is_bitwise_move_assignable : public Readable::integral_constant<bool,
+                is_bitwise_copyable<InputIt, OutputIt>::value &&
+                std::is_move_assignable<typename element_type<OutputIt>::type>::value> {
+        };
+
+        /**
+         * uninitialized_copy、uninitialized_copy_n：元素还要可以复制构造
+         */
+        template<typename InputIt, typename OutputIt>
+        struct is_bitwise_copy_constructible : public Readable::integral_constant<bool,
+                is_bitwise_copyable<InputIt, OutputIt>::value &&
+                std::is_copy_constructible<typename element_type<OutputIt>::type>::value> {
+        };
+
+        /**
+         * uninitialized_move：元素还要可以移动构造
+         */
+        template<typename InputIt, typename OutputIt>
+        struct is_bitwise_move_constructible : public Readable::integral_constant<bool,
+                is_bitwise_copyable<InputIt, OutputIt>::value &&
+                std::is_move_constructible<typename element_type<OutputIt>::type>::value> {
+        };
+
+        /**
+         * 两个区间能否用memcmp比较是否相等：
+         * 连续迭代器，元素类型相同，并且==就是逐字节相等（整数和指针；浮点数的0.0 == -0.0，NaN != NaN，不行）
+         */
+        template<typename InputIt1, typename InputIt2>
+        struct is_bitwise_comparable : public Readable::integral_constant<bool,
+                Readable::is_contiguous_iterator<InputIt1>::value &&
+                Readable::is_contiguous_iterator<InputIt2>::value &&
+                Readable::is_same<typename element_type<InputIt1>::type, typename element_type<InputIt2>::type>::value &&
+                (Readable::is_integral<typename element_type<InputIt1>::type>::value ||
+                 is_pointer<typename element_type<InputIt1>::type>::value)> {
+        };
+
+        /**
+         * 能否用memset填充：连续迭代器，元素是单字节的整数（各种char、bool）
+         */
+        template<typename ForwardIt>
+        struct is_byte_fillable : public Readable::integral_constant<bool,
+                Readable::is_contiguous_iterator<ForwardIt>::value &&
+                sizeof(typename element_type<ForwardIt>::type) == 1 &&
+                Readable::is_integral<typename element_type<ForwardIt>::type>::value &&
+                is_writable_reference<typename iterator_traits<ForwardIt>::reference>::value> {
+        };
+
+        /**
+         * 连续迭代器指向的地址，不解引用迭代器，因此对超尾迭代器也可以使用
+         */
+        template<typename T>
+        T *to_address(T *p) {
+            return p;
+        }
+
+        template<typename ContiguousIt>
+        auto to_address(const ContiguousIt &it) -> decltype(it.operator->()) {
+            return it.operator->();
+        }
+
+        /**
+         * 把[first, last)复制到d_first开始的位置，两个区间可以重叠
+         * @return 目标区间的超尾
+         */
+        template<typename InputIt, typename OutputIt>
+        OutputIt copy_bytes(InputIt first, InputIt last, OutputIt d_first) {
+            auto count = last - first;
+            if (count > 0) {
+                std::memmove(to_address(d_first), to_address(first),
+                             static_cast<std::size_t>(count) * sizeof(typename element_type<OutputIt>::type));
+            }
+            return d_first + count;
+        }
+
+        /**
+         * 把[first, last)复制到以d_last结尾的位置，两个区间可以重叠
+         * @return 目标区间的开头
+         */
+        template<typename InputIt, typename OutputIt>
+        OutputIt copy_bytes_backward(InputIt first, InputIt last, OutputIt d_last) {
+            auto count = last - first;
+            if (count > 0) {
+                std::memmove(to_address(d_last - count), to_address(first),
+                             static_cast<std::size_t>(count) * sizeof(typename element_type<OutputIt>::type));
+            }
+            return d_last - count;
+        }
+
+        template<typename ForwardIt, typename T>
+        void fill_bytes(ForwardIt first, ForwardIt last, const T &value) {
+            auto count = last - first;
+            if (count > 0) {
+                typename element_type<ForwardIt>::type converted = value;
+                unsigned char byte;
+                std::memcpy(&byte, &converted, 1);
+                std::memset(to_address(first), byte, static_cast<std::size_t>(count));
+            }
+        }
+
+        template<typename InputIt1, typename InputIt2>
+        bool equal_bytes(InputIt1 first1, InputIt1 last1, InputIt2 first2) {
+            auto count = last1 - first1;
+            return count <= 0 ||
+                   std::memcmp(to_address(first1), to_address(first2),
+                               static_cast<std::size_t>(count) * sizeof(typename element_type<InputIt1>::type)) == 0;
+        }
+    }
+}
+
+#endif //STL_FROM_SCRATCH_BITWISE_COPY_H
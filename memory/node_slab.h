@@ -0,0 +1,240 @@
+#ifndef STL_FROM_SCRATCH_NODE_SLAB_H
+#define STL_FROM_SCRATCH_NODE_SLAB_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include "./allocator.h"
+
+namespace Readable {
+    /**
+     * 节点块的块头
+     * 一个节点块是一次分配出来的一段连续内存，占据若干个完整的页，块头后面紧跟着若干个节点
+     * 节点本身不记录自己在哪个块中，由页表（node_slab::find）按地址查出来
+     * 块中的节点可能被splice到别的容器、在别的线程上删除，所以存活节点数是原子的
+     */
+    struct node_slab {
+        // 块中还没有删除的节点个数，降为0时整块内存立即释放
+        std::atomic<std::size_t> live_count;
+        // 分配到的原始内存，块头在其中第一个页边界处
+        unsigned char *raw;
+        std::size_t raw_size;
+        // 块占据的页数
+        std::size_t page_count;
+        // 归还整块内存，由分配这个块的node_slab_allocator提供
+        void (*deallocate)(node_slab *);
+
+        /**
+         * 节点 @arg p 所在的块，单独分配的节点返回nullptr
+         * 只读几个原子变量，不加锁
+         */
+        static node_slab *find(const void *p) noexcept;
+
+        /**
+         * 块中的一个节点被删除，最后一个节点被删除时释放整块内存
+         */
+        void release_node() noexcept {
+            if (live_count.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+                deallocate(this);
+            }
+        }
+    };
+
+    namespace node_slab_detail {
+        const unsigned page_shift = 12;
+        const std::size_t page_size = std::size_t(1) << page_shift;
+        const unsigned level_bits = 12;
+        const std::size_t level_size = std::size_t(1) << level_bits;
+        // 页表能记录的页号位数，页号更大的内存不用来放节点块
+        const unsigned page_number_bits = 3 * level_bits;
+        // 节点至少能占满这么多个页时才放进节点块，否则页边界对齐浪费的内存太多
+        const std::size_t min_slab_pages = 4;
+
+        struct page_map_leaf {
+            std::atomic<node_slab *> slabs[level_size];
+        };
+
+        struct page_map_middle {
+            std::atomic<page_map_leaf *> leaves[level_size];
+        };
+
+        inline std::uint64_t page_number(const void *p) noexcept {
+            return static_cast<std::uint64_t>(reinterpret_cast<std::uintptr_t>(p)) >> page_shift;
+        }
+
+        /**
+         * 页号到节点块的三级页表，类似tcmalloc的pagemap
+         * 读不加锁；只有创建、释放节点块时才加锁修改，中间层和叶子层分配后不再释放
+         */
+        class page_map {
+        private:
+            std::atomic<page_map_middle *> root[level_size];
+            std::mutex write_mutex;
+
+            page_map() = default;
+
+            /**
+             * 页号 @arg page 所在的叶子，不存在时创建，分配失败时抛出异常
+             */
+            page_map_leaf &leaf_for(std::uint64_t page) {
+                auto &middle_slot = root[page >> (2 * level_bits)];
+                page_map_middle *middle = middle_slot.load(std::memory_order_relaxed);
+                if (!middle) {
+                    middle = new page_map_middle();
+                    middle_slot.store(middle, std::memory_order_release);
+                }
+                auto &leaf_slot = middle->leaves[(page >> level_bits) & (level_size - 1)];
+                page_map_leaf *leaf = leaf_slot.load(std::memory_order_relaxed);
+                if (!leaf) {
+                    leaf = new page_map_leaf();
+                    leaf_slot.store(leaf, std::memory_order_release);
+                }
+                return *leaf;
+            }
+
+        public:
+            static page_map &instance() {
+                static page_map map;
+                return map;
+            }
+
+            node_slab *find(const void *p) noexcept {
+                std::uint64_t page = page_number(p);
+                if (page >> page_number_bits) {
+                    return nullptr;
+                }
+                page_map_middle *middle = root[page >> (2 * level_bits)].load(std::memory_order_acquire);
+                if (!middle) {
+                    return nullptr;
+                }
+                page_map_leaf *leaf = middle->leaves[(page >> level_bits) & (level_size - 1)]
+                        .load(std::memory_order_acquire);
+                if (!leaf) {
+                    return nullptr;
+                }
+                return leaf->slabs[page & (level_size - 1)].load(std::memory_order_acquire);
+            }
+
+            /**
+             * 把 @arg slab 占据的页都指向它；页号超出页表范围时返回false
+             * 先建好所有的叶子再写入，分配失败时页表不变
+             */
+            bool add(node_slab *slab) {
+                std::uint64_t first = page_number(slab);
+                std::uint64_t last = first + slab->page_count;
+                if ((last - 1) >> page_number_bits) {
+                    return false;
+                }
+                std::lock_guard<std::mutex> lock(write_mutex);
+                for (std::uint64_t page = first; page < last; page += level_size - (page & (level_size - 1))) {
+                    leaf_for(page);
+                }
+                for (std::uint64_t page = first; page < last; ++page) {
+                    leaf_for(page).slabs[page & (level_size - 1)].store(slab, std::memory_order_release);
+                }
+                return true;
+            }
+
+            void remove(node_slab *slab) noexcept {
+                std::uint64_t first = page_number(slab);
+                std::uint64_t last = first + slab->page_count;
+                std::lock_guard<std::mutex> lock(write_mutex);
+                for (std::uint64_t page = first; page < last; ++page) {
+                    // add()已经建好了这些页的叶子，这里不会分配
+                    page_map_middle *middle = root[page >> (2 * level_bits)].load(std::memory_order_relaxed);
+                    page_map_leaf *leaf = middle->leaves[(page >> level_bits) & (level_size - 1)]
+                            .load(std::memory_order_relaxed);
+                    leaf->slabs[page & (level_size - 1)].store(nullptr, std::memory_order_release);
+                }
+            }
+        };
+    }
+
+    inline node_slab *node_slab::find(const void *p) noexcept {
+        return node_slab_detail::page_map::instance().find(p);
+    }
+
+    /**
+     * 在节点块中分配节点
+     * 节点块占据的页不和任何其他分配共用，所以按页查到的块一定是节点所在的块；
+     * 容器删除节点时不需要记录节点来自哪里，节点在容器之间splice也不需要任何额外的工作
+     * @tparam Node 节点类型
+     * @tparam Allocator 容器的空间配置器，会被rebind到unsigned char来分配整块内存
+     */
+    template<typename Node, typename Allocator>
+    struct node_slab_allocator {
+    private:
+        typedef typename Allocator::template rebind<unsigned char>::other byte_allocator;
+
+        /**
+         * 块头所占的字节数，向上取整到节点的对齐要求，使第一个节点正确对齐
+         */
+        static std::size_t header_size() {
+            return (sizeof(node_slab) + alignof(Node) - 1) / alignof(Node) * alignof(Node);
+        }
+
+        static void deallocate(node_slab *slab) {
+            node_slab_detail::page_map::instance().remove(slab);
+            unsigned char *raw = slab->raw;
+            std::size_t raw_size = slab->raw_size;
+            slab->~node_slab();
+            byte_allocator::deallocate(raw, raw_size);
+        }
+
+    public:
+        /**
+         * 分配一个能放下 @arg capacity 个节点的块，节点都还没有被使用
+         * 存活节点数就是capacity，调用者构造元素失败时用destroy直接归还
+         * @return 节点太少、不值得占用整页，或者内存地址超出页表范围时返回nullptr，调用者改为逐个分配节点
+         */
+        static node_slab *create(std::size_t capacity) {
+            using node_slab_detail::page_size;
+            if (capacity * sizeof(Node) < node_slab_detail::min_slab_pages * page_size) {
+                return nullptr;
+            }
+            std::size_t page_count = (header_size() + capacity * sizeof(Node) + page_size - 1) / page_size;
+            // 多分配不到一页，使块从页边界开始并占满整页
+            std::size_t raw_size = page_count * page_size + page_size - 1;
+            unsigned char *raw = byte_allocator::allocate(raw_size);
+            auto address = reinterpret_cast<std::uintptr_t>(raw);
+            auto slab = reinterpret_cast<node_slab *>((address + page_size - 1) & ~(std::uintptr_t) (page_size - 1));
+            ::new((void *) slab) node_slab();
+            slab->live_count.store(capacity, std::memory_order_relaxed);
+            slab->raw = raw;
+            slab->raw_size = raw_size;
+            slab->page_count = page_count;
+            slab->deallocate = &deallocate;
+            bool added;
+            try {
+                added = node_slab_detail::page_map::instance().add(slab);
+            } catch (...) {
+                slab->~node_slab();
+                byte_allocator::deallocate(raw, raw_size);
+                throw;
+            }
+            if (!added) {
+                slab->~node_slab();
+                byte_allocator::deallocate(raw, raw_size);
+                return nullptr;
+            }
+            return slab;
+        }
+
+        /**
+         * 块中第 @arg index 个节点的地址，只是一块未构造的内存
+         */
+        static Node *node_at(node_slab *slab, std::size_t index) {
+            return (Node *) ((unsigned char *) slab + header_size()) + index;
+        }
+
+        /**
+         * 直接归还整块内存，用于块中的节点还没有交给容器时
+         */
+        static void destroy(node_slab *slab) {
+            deallocate(slab);
+        }
+    };
+}
+
+#endif //STL_FROM_SCRATCH_NODE_SLAB_H
@@ -7,8 +7,135 @@
 
 #include "../iterator/iterator_traits.h"
 #include "./memory.h"
+#include "./bitwise_copy.h"
 
 namespace Readable {
+    namespace uninitialized_memory_detail {
+        template<typename InputIt, typename ForwardIt>
+        ForwardIt uninitialized_copy(InputIt first, InputIt last, ForwardIt desination_first, Readable::true_type) {
+            return bitwise_copy_detail::copy_bytes(first, last, desination_first);
+        }
+
+        template<typename InputIt, typename ForwardIt>
+        ForwardIt uninitialized_copy(InputIt first, InputIt last, ForwardIt desination_first, Readable::false_type) {
+            // 注释一个，另外几个同理
+            typedef typename Readable::iterator_traits<ForwardIt>::value_type Value;
+            // 现在复制到的位置
+            ForwardIt current = desination_first;
+            try {
+                // 复制
+                for (; first != last; ++first, ++current) {
+                    // 用new运算符复制元素
+                    // addressof即取地址
+                    // 不用&为的是防止用户重载&运算符，造成&意义改变
+                    ::new(static_cast<void *>(Readable::addressof(*current))) Value(*first);
+                }
+                return current;
+            } catch (...) {
+                // 构造失败
+                // 根据官方文档，需要回滚操作
+                for (; desination_first != current; ++desination_first) {
+                    desination_first->~Value();
+                }
+                throw;
+            }
+        }
+
+        template<typename InputIt, typename ForwardIt>
+        ForwardIt uninitialized_move(InputIt first, InputIt last, ForwardIt desination_first, Readable::true_type) {
+            return bitwise_copy_detail::copy_bytes(first, last, desination_first);
+        }
+
+        template<typename InputIt, typename ForwardIt>
+        ForwardIt uninitialized_move(InputIt first, InputIt last, ForwardIt desination_first, Readable::false_type) {
+            typedef typename Readable::iterator_traits<ForwardIt>::value_type Value;
+            ForwardIt current = desination_first;
+            try {
+                for (; first != last; ++first, ++current) {
+                    ::new(static_cast<void *>(Readable::addressof(*current))) Value(std::move(*first));
+                }
+                return current;
+            } catch (...) {
+                for (; desination_first != current; ++desination_first) {
+                    desination_first->~Value();
+                }
+                throw;
+            }
+        }
+
+        template<typename ForwardIt, typename T>
+        void uninitialized_fill(ForwardIt first, ForwardIt last, const T &value, Readable::true_type) {
+            bitwise_copy_detail::fill_bytes(first, last, value);
+        }
+
+        template<typename ForwardIt, typename T>
+        void uninitialized_fill(ForwardIt first, ForwardIt last, const T &value, Readable::false_type) {
+            typedef typename std::iterator_traits<ForwardIt>::value_type Value;
+            ForwardIt current = first;
+            try {
+                for (; current != last; ++current) {
+                    ::new(static_cast<void *>(Readable::addressof(*current))) Value(value);
+                }
+            } catch (...) {
+                for (; first != current; ++first) {
+                    first->~Value();
+                }
+                throw;
+            }
+        }
+
+        template<typename InputIt, typename Size, typename ForwardIt>
+        ForwardIt uninitialized_copy_n(InputIt first, Size count, ForwardIt desination_first, Readable::true_type) {
+            if (count <= 0) {
+                return desination_first;
+            }
+            return bitwise_copy_detail::copy_bytes(first, first + count, desination_first);
+        }
+
+        template<typename InputIt, typename Size, typename ForwardIt>
+        ForwardIt uninitialized_copy_n(InputIt first, Size count, ForwardIt desination_first, Readable::false_type) {
+            typedef typename std::iterator_traits<ForwardIt>::value_type Value;
+            ForwardIt current = desination_first;
+            try {
+                for (; count > 0; ++first, ++current, --count) {
+                    ::new(static_cast<void *>(Readable::addressof(*current))) Value(*first);
+                }
+            } catch (...) {
+                for (; desination_first != current; ++desination_first) {
+                    desination_first->~Value();
+                }
+                throw;
+            }
+            return current;
+        }
+
+        template<typename ForwardIt, typename Size, typename T>
+        ForwardIt uninitialized_fill_n(ForwardIt first, Size count, const T &value, Readable::true_type) {
+            if (count <= 0) {
+                return first;
+            }
+            bitwise_copy_detail::fill_bytes(first, first + count, value);
+            return first + count;
+        }
+
+        template<typename ForwardIt, typename Size, typename T>
+        ForwardIt uninitialized_fill_n(ForwardIt first, Size count, const T &value, Readable::false_type) {
+            typedef typename std::iterator_traits<ForwardIt>::value_type Value;
+            ForwardIt current = first;
+            try {
+                for (; count > 0; ++current, --count) {
+                    ::new(static_cast<void *>(Readable::addressof(*current))) Value(value);
+                }
+                return current;
+            } catch (...) {
+                for (; first != current; ++first) {
+                    first->~Value();
+                }
+                throw;
+            }
+        }
+    }
+
     /**
      * 将 [@arg first,@arg last) 之间的元素复制到未初始化过的@arg desination_first开始的地址中
      * @tparam ForwardIt 符合InpytIterator要求的迭代器
@@ -20,27 +147,9 @@ namespace Readable {
      */
     template<typename InputIt, typename ForwardIt>
     ForwardIt uninitialized_copy(InputIt first, InputIt last, ForwardIt desination_first) {
-        // 注释一个，另外几个同理
-        typedef typename Readable::iterator_traits<ForwardIt>::value_type Value;
-        // 现在复制到的位置
-        ForwardIt current = desination_first;
-        try {
-            // 复制
-            for (; first != last; ++first, ++current) {
-                // 用new运算符复制元素
-                // addressof即取地址
-                // 不用&为的是防止用户重载&运算符，造成&意义改变
-                ::new(static_cast<void *>(Readable::addressof(*current))) Value(*first);
-            }
-            return current;
-        } catch (...) {
-            // 构造失败
-            // 根据官方文档，需要回滚操作
-            for (; desination_first != current; ++desination_first) {
-                desination_first->~Value();
-            }
-            throw;
-        }
+        typedef Readable::integral_constant<bool,
+                bitwise_copy_detail::is_bitwise_copy_constructible<InputIt, ForwardIt>::value> bitwise;
+        return uninitialized_memory_detail::uninitialized_copy(first, last, desination_first, bitwise());
     }
 
     /**
@@ -54,20 +163,10 @@ namespace Readable {
      */
     template<typename InputIt, typename ForwardIt>
     ForwardIt uninitialized_move(InputIt first, InputIt last, ForwardIt desination_first) {
-        typedef typename Readable::iterator_traits<ForwardIt>::value_type Value;
-        ForwardIt current = desination_first;
-        try {
-            for (; first != last; ++first, ++current) {
-                ::new(static_cast<void *>(Readable::addressof(*current))) Value(std::move(*first));
-            }
-            return current;
-        } catch (...) {
-            for (; desination_first != current; ++desination_first) {
-                desination_first->~Value();
-            }
-            throw;
-        }
-    };
+        typedef Readable::integral_constant<bool,
+                bitwise_copy_detail::is_bitwise_move_constructible<InputIt, ForwardIt>::value> bitwise;
+        return uninitialized_memory_detail::uninitialized_move(first, last, desination_first, bitwise());
+    }
 
     /**
      * 将未初始化过的地址[@arg first,@arg last) 之间的空间用@arg value填充
@@ -79,18 +178,9 @@ namespace Readable {
      */
     template<typename ForwardIt, typename T>
     void uninitialized_fill(ForwardIt first, ForwardIt last, const T &value) {
-        typedef typename std::iterator_traits<ForwardIt>::value_type Value;
-        ForwardIt current = first;
-        try {
-            for (; current != last; ++current) {
-                ::new(static_cast<void *>(Readable::addressof(*current))) Value(value);
-            }
-        } catch (...) {
-            for (; first != current; ++first) {
-                first->~Value();
-            }
-            throw;
-        }
+        typedef Readable::integral_constant<bool,
+                bitwise_copy_detail::is_byte_fillable<ForwardIt>::value> bitwise;
+        uninitialized_memory_detail::uninitialized_fill(first, last, value, bitwise());
     }
 
     /**
@@ -105,19 +195,9 @@ namespace Readable {
      */
     template<typename InputIt, typename Size, typename ForwardIt>
     ForwardIt uninitialized_copy_n(InputIt first, Size count, ForwardIt desination_first) {
-        typedef typename std::iterator_traits<ForwardIt>::value_type Value;
-        ForwardIt current = desination_first;
-        try {
-            for (; count > 0; ++first, ++current, --count) {
-                ::new(static_cast<void *>(Readable::addressof(*current))) Value(*first);
-            }
-        } catch (...) {
-            for (; desination_first != current; ++desination_first) {
-                desination_first->~Value();
-            }
-            throw;
-        }
-        return current;
+        typedef Readable::integral_constant<bool,
+                bitwise_copy_detail::is_bitwise_copy_constructible<InputIt, ForwardIt>::value> bitwise;
+        return uninitialized_memory_detail::uninitialized_copy_n(first, count, desination_first, bitwise());
     }
 
     /**
@@ -132,19 +212,9 @@ namespace Readable {
      */
     template<typename ForwardIt, typename Size, typename T>
     ForwardIt uninitialized_fill_n(ForwardIt first, Size count, const T &value) {
-        typedef typename std::iterator_traits<ForwardIt>::value_type Value;
-        ForwardIt current = first;
-        try {
-            for (; count > 0; ++current, --count) {
-                ::new(static_cast<void *>(Readable::addressof(*current))) Value(value);
-            }
-            return current;
-        } catch (...) {
-            for (; first != current; ++first) {
-                first->~Value();
-            }
-            throw;
-        }
+        typedef Readable::integral_constant<bool,
+                bitwise_copy_detail::is_byte_fillable<ForwardIt>::value> bitwise;
+        return uninitialized_memory_detail::uninitialized_fill_n(first, count, value, bitwise());
     }
 
     /**
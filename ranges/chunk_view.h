@@ -0,0 +1,46 @@
+#ifndef STL_FROM_SCRATCH_CHUNK_VIEW_H
+#define STL_FROM_SCRATCH_CHUNK_VIEW_H
+
+#include "./stride_view.h"
+
+namespace Readable {
+    /**
+     * 把底层视图按顺序分成每块n个元素的视图，最后一块可能不足n个
+     * 每一块是一个iterator_range，在解引用时才构造，不复制元素
+     * 迭代器最多是随机访问迭代器
+     * @tparam View 底层视图
+     */
+    template<typename View>
+    class chunk_view : public ranges_detail::basic_stride_view<View, true> {
+    public:
+        chunk_view(View base_view_, typename ranges_detail::basic_stride_view<View, true>::difference_type n) :
+                ranges_detail::basic_stride_view<View, true>(std::move(base_view_), n) {}
+    };
+
+    namespace views {
+        template<typename Range>
+        chunk_view<typename view_of<Range>::type> chunk(Range &&range, std::ptrdiff_t n) {
+            return chunk_view<typename view_of<Range>::type>(views::all(std::forward<Range>(range)), n);
+        }
+
+        struct chunk_adaptor : public range_adaptor_base {
+            std::ptrdiff_t n;
+
+            explicit chunk_adaptor(std::ptrdiff_t n_) : n(n_) {}
+
+            template<typename Range>
+            chunk_view<typename view_of<Range>::type> operator()(Range &&range) const {
+                return views::chunk(std::forward<Range>(range), n);
+            }
+        };
+
+        /**
+         * 用于 range | views::chunk(n)
+         */
+        inline chunk_adaptor chunk(std::ptrdiff_t n) {
+            return chunk_adaptor(n);
+        }
+    }
+}
+
+#endif //STL_FROM_SCRATCH_CHUNK_VIEW_H
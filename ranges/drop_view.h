@@ -0,0 +1,83 @@
+#ifndef STL_FROM_SCRATCH_DROP_VIEW_H
+#define STL_FROM_SCRATCH_DROP_VIEW_H
+
+#include "./iterator_range.h"
+
+namespace Readable {
+    /**
+     * 跳过底层视图的前n个元素得到的视图，不足n个时为空
+     * 迭代器就是底层迭代器，类型不变
+     * @note 底层迭代器不是随机访问迭代器时，begin()需要O(n)，遍历时应当只调用一次
+     * @tparam View 底层视图
+     */
+    template<typename View>
+    class drop_view : public view_base {
+    public:
+        typedef typename ranges_detail::range_iterator<const View>::type iterator;
+        typedef typename iterator_traits<iterator>::value_type value_type;
+        typedef typename iterator_traits<iterator>::reference reference;
+        typedef typename iterator_traits<iterator>::difference_type difference_type;
+    private:
+        View base_view;
+        difference_type count;
+
+    public:
+        drop_view(View base_view_, difference_type count_) :
+                base_view(std::move(base_view_)), count(count_ < 0 ? 0 : count_) {}
+
+        iterator begin() const {
+            iterator first = base_view.begin();
+            ranges_detail::advance_bounded(first, count, base_view.end());
+            return first;
+        }
+
+        iterator end() const {
+            return base_view.end();
+        }
+
+        bool empty() const {
+            return begin() == end();
+        }
+
+        /**
+         * @note 底层迭代器不是随机访问迭代器时需要O(n)
+         */
+        difference_type size() const {
+            return Readable::distance(begin(), end());
+        }
+
+        /**
+         * @note 只用于随机访问迭代器
+         */
+        reference operator[](difference_type n) const {
+            return begin()[n];
+        }
+    };
+
+    namespace views {
+        template<typename Range>
+        drop_view<typename view_of<Range>::type> drop(Range &&range, std::ptrdiff_t count) {
+            return drop_view<typename view_of<Range>::type>(views::all(std::forward<Range>(range)), count);
+        }
+
+        struct drop_adaptor : public range_adaptor_base {
+            std::ptrdiff_t count;
+
+            explicit drop_adaptor(std::ptrdiff_t count_) : count(count_) {}
+
+            template<typename Range>
+            drop_view<typename view_of<Range>::type> operator()(Range &&range) const {
+                return views::drop(std::forward<Range>(range), count);
+            }
+        };
+
+        /**
+         * 用于 range | views::drop(n)
+         */
+        inline drop_adaptor drop(std::ptrdiff_t count) {
+            return drop_adaptor(count);
+        }
+    }
+}
+
+#endif //STL_FROM_SCRATCH_DROP_VIEW_H
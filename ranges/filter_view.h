@@ -0,0 +1,146 @@
+#ifndef STL_FROM_SCRATCH_FILTER_VIEW_H
+#define STL_FROM_SCRATCH_FILTER_VIEW_H
+
+#include "./iterator_range.h"
+
+namespace Readable {
+    template<typename Iterator, typename Predicate>
+    class filter_iterator : public Readable::iterator<
+            typename ranges_detail::weaker_category<
+                    typename iterator_traits<Iterator>::iterator_category, bidirectional_iterator_tag>::type,
+            typename iterator_traits<Iterator>::value_type,
+            typename iterator_traits<Iterator>::difference_type,
+            typename iterator_traits<Iterator>::pointer,
+            typename iterator_traits<Iterator>::reference> {
+    public:
+        typedef filter_iterator<Iterator, Predicate> self_type;
+        typedef typename iterator_traits<Iterator>::reference reference;
+        typedef typename iterator_traits<Iterator>::pointer pointer;
+    private:
+        Iterator current;
+        Iterator last;
+        // 谓词保存在视图中，迭代器只在视图存在期间有效
+        const Predicate *pred;
+
+        void skip_forward() {
+            while (current != last && !(*pred)(*current)) {
+                ++current;
+            }
+        }
+
+    public:
+        filter_iterator() = default;
+
+        filter_iterator(Iterator current_, Iterator last_, const Predicate *pred_) :
+                current(current_), last(last_), pred(pred_) {
+            skip_forward();
+        }
+
+        Iterator base() const {
+            return current;
+        }
+
+        bool operator==(const self_type &other) const { return current == other.current; }
+
+        bool operator!=(const self_type &other) const { return current != other.current; }
+
+        reference operator*() const {
+            return *current;
+        }
+
+        pointer operator->() const {
+            return Readable::addressof(operator*());
+        }
+
+        self_type &operator++() {
+            ++current;
+            skip_forward();
+            return *this;
+        }
+
+        self_type operator++(int) {
+            self_type origin_this = *this;
+            ++*this;
+            return origin_this;
+        }
+
+        /**
+         * 后退到前一个满足谓词的元素，调用者保证存在这样的元素
+         */
+        self_type &operator--() {
+            do {
+                --current;
+            } while (!(*pred)(*current));
+            return *this;
+        }
+
+        self_type operator--(int) {
+            self_type origin_this = *this;
+            --*this;
+            return origin_this;
+        }
+    };
+
+    /**
+     * 只包含底层视图中满足谓词的元素的视图
+     * 元素在遍历时才被检查，不会复制到新的容器中；迭代器最多是双向的
+     * @note begin()要找到第一个满足谓词的元素，每次调用都是O(n)，遍历时应当只调用一次
+     * @tparam View 底层视图
+     * @tparam Predicate 一元谓词
+     */
+    template<typename View, typename Predicate>
+    class filter_view : public view_base {
+    public:
+        typedef filter_iterator<typename ranges_detail::range_iterator<const View>::type, Predicate> iterator;
+        typedef typename iterator_traits<iterator>::value_type value_type;
+        typedef typename iterator_traits<iterator>::reference reference;
+    private:
+        View base_view;
+        Predicate pred;
+
+    public:
+        filter_view(View base_view_, Predicate pred_) : base_view(std::move(base_view_)), pred(std::move(pred_)) {}
+
+        iterator begin() const {
+            return iterator(base_view.begin(), base_view.end(), Readable::addressof(pred));
+        }
+
+        iterator end() const {
+            return iterator(base_view.end(), base_view.end(), Readable::addressof(pred));
+        }
+
+        bool empty() const {
+            return begin() == end();
+        }
+    };
+
+    namespace views {
+        template<typename Range, typename Predicate>
+        filter_view<typename view_of<Range>::type, Predicate> filter(Range &&range, Predicate pred) {
+            return filter_view<typename view_of<Range>::type, Predicate>(views::all(std::forward<Range>(range)),
+                                                                          std::move(pred));
+        }
+
+        template<typename Predicate>
+        struct filter_adaptor : public range_adaptor_base {
+            Predicate pred;
+
+            explicit filter_adaptor(Predicate pred_) : pred(std::move(pred_)) {}
+
+            template<typename Range>
+            filter_view<typename view_of<Range>::type, Predicate> operator()(Range &&range) const {
+                return views::filter(std::forward<Range>(range), pred);
+            }
+        };
+
+        /**
+         * 用于 range | views::filter(pred)
+         */
+        template<typename Predicate>
+        filter_adaptor<Predicate> filter(Predicate pred) {
+            return filter_adaptor<Predicate>(std::move(pred));
+        }
+    }
+}
+
+#endif //STL_FROM_SCRATCH_FILTER_VIEW_H
@@ -0,0 +1,188 @@
+#ifndef STL_FROM_SCRATCH_ITERATOR_RANGE_H
+#define STL_FROM_SCRATCH_ITERATOR_RANGE_H
+
+#include <cstddef>
+#include <type_traits>
+#include <utility>
+#include "../iterator/iterator.h"
+
+namespace Readable {
+    /**
+     * 所有视图的基类，只用来标记"这是一个视图"
+     * 视图不拥有元素，只记录怎样从底层区间得到元素，复制的代价很小，因此组合时按值保存；
+     * 其他区间（容器）则只保存它的一对迭代器
+     */
+    struct view_base {
+    };
+
+    /**
+     * 由一对迭代器表示的区间，是最简单的视图
+     * @tparam Iterator 迭代器类型
+     */
+    template<typename Iterator>
+    class iterator_range : public view_base {
+    public:
+        typedef Iterator iterator;
+        typedef typename iterator_traits<Iterator>::value_type value_type;
+        typedef typename iterator_traits<Iterator>::reference reference;
+        typedef typename iterator_traits<Iterator>::difference_type difference_type;
+    private:
+        Iterator first;
+        Iterator last;
+
+    public:
+        iterator_range() = default;
+
+        iterator_range(Iterator first_, Iterator last_) : first(first_), last(last_) {}
+
+        Iterator begin() const {
+            return first;
+        }
+
+        Iterator end() const {
+            return last;
+        }
+
+        bool empty() const {
+            return first == last;
+        }
+
+        /**
+         * @note 迭代器不是随机访问迭代器时需要O(n)
+         */
+        difference_type size() const {
+            return Readable::distance(first, last);
+        }
+
+        /**
+         * @note 只用于随机访问迭代器
+         */
+        reference operator[](difference_type n) const {
+            return first[n];
+        }
+    };
+
+    template<typename Iterator>
+    iterator_range<Iterator> make_iterator_range(Iterator first, Iterator last) {
+        return iterator_range<Iterator>(first, last);
+    }
+
+    namespace ranges_detail {
+        /**
+         * 迭代器类型 @arg Category 和 @arg Limit 中较弱的一种
+         * 视图的迭代器最多只能提供底层迭代器的能力，而有的视图本身又只能支持到某一种（比如filter最多是双向的）
+         */
+        template<typename Category, typename Limit>
+        struct weaker_category {
+            typedef typename std::conditional<std::is_convertible<Category *, Limit *>::value,
+                    Limit, Category>::type type;
+        };
+
+        template<typename Iterator>
+        struct is_random_access : public std::is_convertible<
+                typename iterator_traits<Iterator>::iterator_category *, random_access_iterator_tag *> {
+        };
+
+        template<typename Range>
+        struct range_iterator {
+            typedef decltype(std::declval<Range &>().begin()) type;
+        };
+
+        template<typename Iterator>
+        typename iterator_traits<Iterator>::difference_type
+        advance_bounded(Iterator &it, typename iterator_traits<Iterator>::difference_type n, Iterator last,
+                        std::true_type) {
+            auto remaining = last - it;
+            if (n > remaining) {
+                it = last;
+                return n - remaining;
+            }
+            it += n;
+            return 0;
+        }
+
+        template<typename Iterator>
+        typename iterator_traits<Iterator>::difference_type
+        advance_bounded(Iterator &it, typename iterator_traits<Iterator>::difference_type n, Iterator last,
+                        std::false_type) {
+            for (; n > 0 && it != last; --n) {
+                ++it;
+            }
+            return n;
+        }
+
+        /**
+         * 让 @arg it 前进 @arg n 步，但不超过 @arg last
+         * @return 因为到达last而没有走的步数
+         */
+        template<typename Iterator>
+        typename iterator_traits<Iterator>::difference_type
+        advance_bounded(Iterator &it, typename iterator_traits<Iterator>::difference_type n, Iterator last) {
+            return advance_bounded(it, n, last, is_random_access<Iterator>());
+        }
+    }
+
+    /**
+     * 判断Range是否是视图
+     */
+    template<typename Range>
+    struct is_view : public std::is_base_of<view_base, typename std::decay<Range>::type> {
+    };
+
+    /**
+     * 把一个区间当作视图时的类型：视图按值保存，其他区间（容器等）转换成由它的迭代器构成的iterator_range
+     */
+    template<typename Range, bool IsView = is_view<Range>::value>
+    struct view_of {
+        typedef typename std::decay<Range>::type type;
+    };
+
+    template<typename Range>
+    struct view_of<Range, false> {
+        typedef iterator_range<typename ranges_detail::range_iterator<Range>::type> type;
+    };
+
+    namespace ranges_detail {
+        template<typename Range>
+        typename view_of<Range>::type to_view(Range &&range, std::true_type) {
+            return std::forward<Range>(range);
+        }
+
+        template<typename Range>
+        typename view_of<Range>::type to_view(Range &&range, std::false_type) {
+            return typename view_of<Range>::type(range.begin(), range.end());
+        }
+    }
+
+    namespace views {
+        /**
+         * 把 @arg range 转换成视图
+         * 容器只能以左值传入：视图不拥有元素，临时容器在表达式结束时就析构了
+         */
+        template<typename Range>
+        typename view_of<Range>::type all(Range &&range) {
+            static_assert(is_view<Range>::value || std::is_lvalue_reference<Range>::value,
+                          "a view cannot refer to a temporary container");
+            return ranges_detail::to_view(std::forward<Range>(range), is_view<Range>());
+        }
+
+        /**
+         * 视图适配器的基类，标记可以用在 range | adaptor 中的对象
+         * 派生类需要提供 operator()(Range &&)，返回对应的视图
+         */
+        struct range_adaptor_base {
+        };
+
+        /**
+         * range | views::filter(pred) | views::transform(f) 等价于 views::transform(views::filter(range, pred), f)
+         */
+        template<typename Range, typename Adaptor>
+        auto operator|(Range &&range, const Adaptor &adaptor)
+        -> typename std::enable_if<std::is_base_of<range_adaptor_base, Adaptor>::value,
+                decltype(adaptor(std::forward<Range>(range)))>::type {
+            return adaptor(std::forward<Range>(range));
+        }
+    }
+}
+
+#endif //STL_FROM_SCRATCH_ITERATOR_RANGE_H
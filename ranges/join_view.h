@@ -0,0 +1,150 @@
+#ifndef STL_FROM_SCRATCH_JOIN_VIEW_H
+#define STL_FROM_SCRATCH_JOIN_VIEW_H
+
+#include "./iterator_range.h"
+
+namespace Readable {
+    namespace ranges_detail {
+        template<typename OuterIterator>
+        struct join_iterator_types {
+            typedef decltype((*std::declval<OuterIterator>()).begin()) inner_iterator;
+            typedef typename weaker_category<
+                    typename iterator_traits<inner_iterator>::iterator_category,
+                    typename weaker_category<
+                            typename iterator_traits<OuterIterator>::iterator_category,
+                            forward_iterator_tag>::type>::type category;
+        };
+    }
+
+    /**
+     * 依次遍历外层区间中每个内层区间的元素，跳过空的内层区间
+     * 最多是前向迭代器
+     * @note 内层迭代器在外层迭代器移走之后仍被使用：外层区间解引用得到的应当是引用（比如容器的容器），
+     * 或者是迭代器不依赖它自身存在的视图（比如chunk_view得到的iterator_range），不能是按值返回的容器
+     */
+    template<typename OuterIterator>
+    class join_iterator : public Readable::iterator<
+            typename ranges_detail::join_iterator_types<OuterIterator>::category,
+            typename iterator_traits<typename ranges_detail::join_iterator_types<OuterIterator>::inner_iterator>::value_type,
+            typename iterator_traits<typename ranges_detail::join_iterator_types<OuterIterator>::inner_iterator>::difference_type,
+            typename iterator_traits<typename ranges_detail::join_iterator_types<OuterIterator>::inner_iterator>::pointer,
+            typename iterator_traits<typename ranges_detail::join_iterator_types<OuterIterator>::inner_iterator>::reference> {
+    public:
+        typedef join_iterator<OuterIterator> self_type;
+        typedef typename ranges_detail::join_iterator_types<OuterIterator>::inner_iterator inner_iterator;
+        typedef typename iterator_traits<inner_iterator>::reference reference;
+        typedef typename iterator_traits<inner_iterator>::pointer pointer;
+    private:
+        OuterIterator outer;
+        OuterIterator outer_last;
+        inner_iterator inner;
+        inner_iterator inner_last;
+
+        /**
+         * 从outer开始找到第一个非空的内层区间
+         */
+        void satisfy() {
+            for (; outer != outer_last; ++outer) {
+                auto &&inner_range = *outer;
+                inner = inner_range.begin();
+                inner_last = inner_range.end();
+                if (inner != inner_last) {
+                    return;
+                }
+            }
+        }
+
+    public:
+        join_iterator() = default;
+
+        join_iterator(OuterIterator outer_, OuterIterator outer_last_) : outer(outer_), outer_last(outer_last_) {
+            satisfy();
+        }
+
+        OuterIterator outer_base() const {
+            return outer;
+        }
+
+        bool operator==(const self_type &other) const {
+            return outer == other.outer && (outer == outer_last || inner == other.inner);
+        }
+
+        bool operator!=(const self_type &other) const {
+            return !(*this == other);
+        }
+
+        reference operator*() const {
+            return *inner;
+        }
+
+        pointer operator->() const {
+            return Readable::addressof(operator*());
+        }
+
+        self_type &operator++() {
+            if (++inner == inner_last) {
+                ++outer;
+                satisfy();
+            }
+            return *this;
+        }
+
+        self_type operator++(int) {
+            self_type origin_this = *this;
+            ++*this;
+            return origin_this;
+        }
+    };
+
+    /**
+     * 把区间的区间展开成一层的视图
+     * @note begin()要找到第一个非空的内层区间，遍历时应当只调用一次
+     * @tparam View 底层视图，元素也是区间
+     */
+    template<typename View>
+    class join_view : public view_base {
+    public:
+        typedef join_iterator<typename ranges_detail::range_iterator<const View>::type> iterator;
+        typedef typename iterator_traits<iterator>::value_type value_type;
+        typedef typename iterator_traits<iterator>::reference reference;
+        typedef typename iterator_traits<iterator>::difference_type difference_type;
+    private:
+        View base_view;
+
+    public:
+        explicit join_view(View base_view_) : base_view(std::move(base_view_)) {}
+
+        iterator begin() const {
+            return iterator(base_view.begin(), base_view.end());
+        }
+
+        iterator end() const {
+            return iterator(base_view.end(), base_view.end());
+        }
+
+        bool empty() const {
+            return begin() == end();
+        }
+    };
+
+    namespace views {
+        template<typename Range>
+        join_view<typename view_of<Range>::type> join(Range &&range) {
+            return join_view<typename view_of<Range>::type>(views::all(std::forward<Range>(range)));
+        }
+
+        struct join_adaptor : public range_adaptor_base {
+            template<typename Range>
+            join_view<typename view_of<Range>::type> operator()(Range &&range) const {
+                return views::join(std::forward<Range>(range));
+            }
+        };
+
+        /**
+         * 用于 range | views::joined
+         */
+        const join_adaptor joined = join_adaptor();
+    }
+}
+
+#endif //STL_FROM_SCRATCH_JOIN_VIEW_H
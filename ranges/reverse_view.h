@@ -0,0 +1,72 @@
+#ifndef STL_FROM_SCRATCH_REVERSE_VIEW_H
+#define STL_FROM_SCRATCH_REVERSE_VIEW_H
+
+#include "./iterator_range.h"
+
+namespace Readable {
+    /**
+     * 逆序遍历底层视图的视图，底层迭代器至少是双向迭代器
+     * 迭代器是底层迭代器的reverse_iterator（连续迭代器降为随机访问迭代器）
+     * @tparam View 底层视图
+     */
+    template<typename View>
+    class reverse_view : public view_base {
+    public:
+        typedef Readable::reverse_iterator<typename ranges_detail::range_iterator<const View>::type> iterator;
+        typedef typename iterator_traits<iterator>::value_type value_type;
+        typedef typename iterator_traits<iterator>::reference reference;
+        typedef typename iterator_traits<iterator>::difference_type difference_type;
+    private:
+        View base_view;
+
+    public:
+        explicit reverse_view(View base_view_) : base_view(std::move(base_view_)) {}
+
+        iterator begin() const {
+            return iterator(base_view.end());
+        }
+
+        iterator end() const {
+            return iterator(base_view.begin());
+        }
+
+        bool empty() const {
+            return base_view.empty();
+        }
+
+        /**
+         * @note 底层迭代器不是随机访问迭代器时需要O(n)
+         */
+        difference_type size() const {
+            return Readable::distance(base_view.begin(), base_view.end());
+        }
+
+        /**
+         * @note 只用于随机访问迭代器
+         */
+        reference operator[](difference_type n) const {
+            return begin()[n];
+        }
+    };
+
+    namespace views {
+        template<typename Range>
+        reverse_view<typename view_of<Range>::type> reverse(Range &&range) {
+            return reverse_view<typename view_of<Range>::type>(views::all(std::forward<Range>(range)));
+        }
+
+        struct reverse_adaptor : public range_adaptor_base {
+            template<typename Range>
+            reverse_view<typename view_of<Range>::type> operator()(Range &&range) const {
+                return views::reverse(std::forward<Range>(range));
+            }
+        };
+
+        /**
+         * 用于 range | views::reversed
+         */
+        const reverse_adaptor reversed = reverse_adaptor();
+    }
+}
+
+#endif //STL_FROM_SCRATCH_REVERSE_VIEW_H
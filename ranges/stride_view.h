@@ -0,0 +1,253 @@
+#ifndef STL_FROM_SCRATCH_STRIDE_VIEW_H
+#define STL_FROM_SCRATCH_STRIDE_VIEW_H
+
+#include "./iterator_range.h"
+
+namespace Readable {
+    namespace ranges_detail {
+        template<typename Iterator>
+        struct is_bidirectional : public std::is_convertible<
+                typename iterator_traits<Iterator>::iterator_category *, bidirectional_iterator_tag *> {
+        };
+
+        template<typename Iterator, bool Chunked>
+        struct stride_iterator_types {
+            typedef typename iterator_traits<Iterator>::value_type value_type;
+            typedef typename iterator_traits<Iterator>::pointer pointer;
+            typedef typename iterator_traits<Iterator>::reference reference;
+        };
+
+        template<typename Iterator>
+        struct stride_iterator_types<Iterator, true> {
+            typedef iterator_range<Iterator> value_type;
+            typedef void pointer;
+            typedef iterator_range<Iterator> reference;
+        };
+    }
+
+    /**
+     * 每次前进stride步的迭代器，最后一步不足stride时停在last，不足的步数记在missing中，
+     * 这样从末尾后退时仍能回到最后一个元素上
+     * @tparam Chunked 为true时是chunk_view的迭代器，解引用得到从当前位置开始的最多stride个元素
+     */
+    template<typename Iterator, bool Chunked = false>
+    class stride_iterator : public Readable::iterator<
+            typename ranges_detail::weaker_category<
+                    typename iterator_traits<Iterator>::iterator_category, random_access_iterator_tag>::type,
+            typename ranges_detail::stride_iterator_types<Iterator, Chunked>::value_type,
+            typename iterator_traits<Iterator>::difference_type,
+            typename ranges_detail::stride_iterator_types<Iterator, Chunked>::pointer,
+            typename ranges_detail::stride_iterator_types<Iterator, Chunked>::reference> {
+    public:
+        typedef stride_iterator<Iterator, Chunked> self_type;
+        typedef typename ranges_detail::stride_iterator_types<Iterator, Chunked>::reference reference;
+        typedef typename iterator_traits<Iterator>::difference_type difference_type;
+    private:
+        Iterator current;
+        Iterator last;
+        difference_type stride;
+        difference_type missing;
+
+        reference dereference(std::false_type) const {
+            return *current;
+        }
+
+        reference dereference(std::true_type) const {
+            Iterator chunk_last = current;
+            ranges_detail::advance_bounded(chunk_last, stride, last);
+            return reference(current, chunk_last);
+        }
+
+    public:
+        stride_iterator() = default;
+
+        stride_iterator(Iterator current_, Iterator last_, difference_type stride_, difference_type missing_ = 0) :
+                current(current_), last(last_), stride(stride_), missing(missing_) {}
+
+        Iterator base() const {
+            return current;
+        }
+
+        reference operator*() const {
+            return dereference(std::integral_constant<bool, Chunked>());
+        }
+
+        reference operator[](difference_type n) const {
+            return *(*this + n);
+        }
+
+        self_type &operator++() {
+            missing = ranges_detail::advance_bounded(current, stride, last);
+            return *this;
+        }
+
+        self_type operator++(int) {
+            self_type origin_this = *this;
+            ++*this;
+            return origin_this;
+        }
+
+        self_type &operator--() {
+            Readable::advance(current, missing - stride);
+            missing = 0;
+            return *this;
+        }
+
+        self_type operator--(int) {
+            self_type origin_this = *this;
+            --*this;
+            return origin_this;
+        }
+
+        self_type &operator+=(difference_type n) {
+            if (n > 0) {
+                missing = ranges_detail::advance_bounded(current, stride * n, last);
+            } else if (n < 0) {
+                current += stride * n + missing;
+                missing = 0;
+            }
+            return *this;
+        }
+
+        self_type &operator-=(difference_type n) {
+            return *this += -n;
+        }
+
+        self_type operator+(difference_type n) const {
+            self_type result = *this;
+            return result += n;
+        }
+
+        self_type operator-(difference_type n) const {
+            self_type result = *this;
+            return result -= n;
+        }
+
+        difference_type operator-(const self_type &other) const {
+            return (current - other.current + missing - other.missing) / stride;
+        }
+
+        bool operator==(const self_type &other) const { return current == other.current; }
+
+        bool operator!=(const self_type &other) const { return current != other.current; }
+
+        bool operator<(const self_type &other) const { return current < other.current; }
+
+        bool operator>(const self_type &other) const { return current > other.current; }
+
+        bool operator<=(const self_type &other) const { return current <= other.current; }
+
+        bool operator>=(const self_type &other) const { return current >= other.current; }
+    };
+
+    template<typename Iterator, bool Chunked>
+    stride_iterator<Iterator, Chunked> operator+(typename iterator_traits<Iterator>::difference_type n,
+                                                 const stride_iterator<Iterator, Chunked> &it) {
+        return it + n;
+    }
+
+    namespace ranges_detail {
+        /**
+         * stride_view和chunk_view共用的实现，两者只有迭代器解引用的结果不同
+         */
+        template<typename View, bool Chunked>
+        class basic_stride_view : public view_base {
+        public:
+            typedef stride_iterator<typename range_iterator<const View>::type, Chunked> iterator;
+            typedef typename iterator_traits<iterator>::value_type value_type;
+            typedef typename iterator_traits<iterator>::reference reference;
+            typedef typename iterator_traits<iterator>::difference_type difference_type;
+        private:
+            typedef typename range_iterator<const View>::type base_iterator;
+
+            View base_view;
+            difference_type stride;
+
+            // 末尾迭代器要能后退，需要知道最后一步少走了几步
+            iterator make_end(std::true_type) const {
+                difference_type remainder = Readable::distance(base_view.begin(), base_view.end()) % stride;
+                return iterator(base_view.end(), base_view.end(), stride, remainder == 0 ? 0 : stride - remainder);
+            }
+
+            iterator make_end(std::false_type) const {
+                return iterator(base_view.end(), base_view.end(), stride);
+            }
+
+        public:
+            /**
+             * @param stride_ 必须大于0
+             */
+            basic_stride_view(View base_view_, difference_type stride_) :
+                    base_view(std::move(base_view_)), stride(stride_) {}
+
+            iterator begin() const {
+                return iterator(base_view.begin(), base_view.end(), stride);
+            }
+
+            /**
+             * @note 底层迭代器是双向迭代器（但不是随机访问迭代器）时需要O(n)
+             */
+            iterator end() const {
+                return make_end(is_bidirectional<base_iterator>());
+            }
+
+            bool empty() const {
+                return base_view.empty();
+            }
+
+            /**
+             * @note 底层迭代器不是随机访问迭代器时需要O(n)
+             */
+            difference_type size() const {
+                difference_type n = Readable::distance(base_view.begin(), base_view.end());
+                return (n + stride - 1) / stride;
+            }
+
+            /**
+             * @note 只用于随机访问迭代器
+             */
+            reference operator[](difference_type n) const {
+                return begin()[n];
+            }
+        };
+    }
+
+    /**
+     * 底层视图中每隔stride个取一个元素得到的视图：第0, stride, 2*stride...个元素
+     * 迭代器最多是随机访问迭代器
+     * @tparam View 底层视图
+     */
+    template<typename View>
+    class stride_view : public ranges_detail::basic_stride_view<View, false> {
+    public:
+        stride_view(View base_view_, typename ranges_detail::basic_stride_view<View, false>::difference_type stride_) :
+                ranges_detail::basic_stride_view<View, false>(std::move(base_view_), stride_) {}
+    };
+
+    namespace views {
+        template<typename Range>
+        stride_view<typename view_of<Range>::type> stride(Range &&range, std::ptrdiff_t n) {
+            return stride_view<typename view_of<Range>::type>(views::all(std::forward<Range>(range)), n);
+        }
+
+        struct stride_adaptor : public range_adaptor_base {
+            std::ptrdiff_t n;
+
+            explicit stride_adaptor(std::ptrdiff_t n_) : n(n_) {}
+
+            template<typename Range>
+            stride_view<typename view_of<Range>::type> operator()(Range &&range) const {
+                return views::stride(std::forward<Range>(range), n);
+            }
+        };
+
+        /**
+         * 用于 range | views::stride(n)
+         */
+        inline stride_adaptor stride(std::ptrdiff_t n) {
+            return stride_adaptor(n);
+        }
+    }
+}
+
+#endif //STL_FROM_SCRATCH_STRIDE_VIEW_H
@@ -0,0 +1,171 @@
+#ifndef STL_FROM_SCRATCH_TAKE_VIEW_H
+#define STL_FROM_SCRATCH_TAKE_VIEW_H
+
+#include "./iterator_range.h"
+
+namespace Readable {
+    /**
+     * 带计数的迭代器，用于在不是随机访问的区间上取前n个元素：计数减到0时就到达了末尾
+     */
+    template<typename Iterator>
+    class counted_iterator : public Readable::iterator<
+            typename ranges_detail::weaker_category<
+                    typename iterator_traits<Iterator>::iterator_category, forward_iterator_tag>::type,
+            typename iterator_traits<Iterator>::value_type,
+            typename iterator_traits<Iterator>::difference_type,
+            typename iterator_traits<Iterator>::pointer,
+            typename iterator_traits<Iterator>::reference> {
+    public:
+        typedef counted_iterator<Iterator> self_type;
+        typedef typename iterator_traits<Iterator>::reference reference;
+        typedef typename iterator_traits<Iterator>::pointer pointer;
+        typedef typename iterator_traits<Iterator>::difference_type difference_type;
+    private:
+        Iterator current;
+        difference_type remaining;
+
+    public:
+        counted_iterator() = default;
+
+        counted_iterator(Iterator current_, difference_type remaining_) : current(current_), remaining(remaining_) {}
+
+        Iterator base() const {
+            return current;
+        }
+
+        /**
+         * 计数到0，或者底层区间先走到了末尾，都算到达末尾
+         */
+        bool operator==(const self_type &other) const {
+            return remaining == other.remaining || current == other.current;
+        }
+
+        bool operator!=(const self_type &other) const {
+            return !(*this == other);
+        }
+
+        reference operator*() const {
+            return *current;
+        }
+
+        pointer operator->() const {
+            return Readable::addressof(operator*());
+        }
+
+        self_type &operator++() {
+            ++current;
+            --remaining;
+            return *this;
+        }
+
+        self_type operator++(int) {
+            self_type origin_this = *this;
+            ++*this;
+            return origin_this;
+        }
+    };
+
+    namespace ranges_detail {
+        template<typename View>
+        struct take_view_iterator {
+            typedef typename range_iterator<const View>::type base_iterator;
+            // 随机访问的区间可以直接算出末尾，迭代器的类型不变（连续迭代器仍然是连续的）
+            typedef typename std::conditional<is_random_access<base_iterator>::value,
+                    base_iterator, counted_iterator<base_iterator> >::type type;
+        };
+    }
+
+    /**
+     * 底层视图的前n个元素，不足n个时就是整个底层视图
+     * 底层迭代器是随机访问迭代器时，视图的迭代器就是底层迭代器；否则是counted_iterator
+     * @tparam View 底层视图
+     */
+    template<typename View>
+    class take_view : public view_base {
+    public:
+        typedef typename ranges_detail::take_view_iterator<View>::type iterator;
+        typedef typename iterator_traits<iterator>::value_type value_type;
+        typedef typename iterator_traits<iterator>::reference reference;
+        typedef typename iterator_traits<iterator>::difference_type difference_type;
+    private:
+        typedef typename ranges_detail::take_view_iterator<View>::base_iterator base_iterator;
+
+        View base_view;
+        difference_type count;
+
+        iterator make_begin(std::true_type) const {
+            return base_view.begin();
+        }
+
+        iterator make_begin(std::false_type) const {
+            return iterator(base_view.begin(), count);
+        }
+
+        iterator make_end(std::true_type) const {
+            base_iterator last = base_view.begin();
+            ranges_detail::advance_bounded(last, count, base_view.end());
+            return last;
+        }
+
+        iterator make_end(std::false_type) const {
+            return iterator(base_view.end(), 0);
+        }
+
+    public:
+        take_view(View base_view_, difference_type count_) :
+                base_view(std::move(base_view_)), count(count_ < 0 ? 0 : count_) {}
+
+        iterator begin() const {
+            return make_begin(ranges_detail::is_random_access<base_iterator>());
+        }
+
+        iterator end() const {
+            return make_end(ranges_detail::is_random_access<base_iterator>());
+        }
+
+        bool empty() const {
+            return count == 0 || base_view.empty();
+        }
+
+        /**
+         * @note 底层迭代器不是随机访问迭代器时需要O(n)
+         */
+        difference_type size() const {
+            return Readable::distance(begin(), end());
+        }
+
+        /**
+         * @note 只用于随机访问迭代器
+         */
+        reference operator[](difference_type n) const {
+            return begin()[n];
+        }
+    };
+
+    namespace views {
+        template<typename Range>
+        take_view<typename view_of<Range>::type> take(Range &&range, std::ptrdiff_t count) {
+            return take_view<typename view_of<Range>::type>(views::all(std::forward<Range>(range)), count);
+        }
+
+        struct take_adaptor : public range_adaptor_base {
+            std::ptrdiff_t count;
+
+            explicit take_adaptor(std::ptrdiff_t count_) : count(count_) {}
+
+            template<typename Range>
+            take_view<typename view_of<Range>::type> operator()(Range &&range) const {
+                return views::take(std::forward<Range>(range), count);
+            }
+        };
+
+        /**
+         * 用于 range | views::take(n)
+         */
+        inline take_adaptor take(std::ptrdiff_t count) {
+            return take_adaptor(count);
+        }
+    }
+}
+
+#endif //STL_FROM_SCRATCH_TAKE_VIEW_H
@@ -0,0 +1,191 @@
+#ifndef STL_FROM_SCRATCH_TRANSFORM_VIEW_H
+#define STL_FROM_SCRATCH_TRANSFORM_VIEW_H
+
+#include "./iterator_range.h"
+
+namespace Readable {
+    namespace ranges_detail {
+        template<typename Iterator, typename Function>
+        struct transform_iterator_types {
+            typedef decltype(std::declval<const Function &>()(*std::declval<Iterator>())) reference;
+            typedef typename std::decay<reference>::type value_type;
+            // 函数的结果不在底层区间中，迭代器不再是连续的
+            typedef typename weaker_category<
+                    typename iterator_traits<Iterator>::iterator_category, random_access_iterator_tag>::type category;
+        };
+    }
+
+    template<typename Iterator, typename Function>
+    class transform_iterator : public Readable::iterator<
+            typename ranges_detail::transform_iterator_types<Iterator, Function>::category,
+            typename ranges_detail::transform_iterator_types<Iterator, Function>::value_type,
+            typename iterator_traits<Iterator>::difference_type,
+            void,
+            typename ranges_detail::transform_iterator_types<Iterator, Function>::reference> {
+    public:
+        typedef transform_iterator<Iterator, Function> self_type;
+        typedef typename ranges_detail::transform_iterator_types<Iterator, Function>::reference reference;
+        typedef typename iterator_traits<Iterator>::difference_type difference_type;
+    private:
+        Iterator current;
+        // 函数保存在视图中，迭代器只在视图存在期间有效
+        const Function *function;
+
+    public:
+        transform_iterator() = default;
+
+        transform_iterator(Iterator current_, const Function *function_) : current(current_), function(function_) {}
+
+        Iterator base() const {
+            return current;
+        }
+
+        reference operator*() const {
+            return (*function)(*current);
+        }
+
+        reference operator[](difference_type n) const {
+            return (*function)(current[n]);
+        }
+
+        self_type &operator++() {
+            ++current;
+            return *this;
+        }
+
+        self_type operator++(int) {
+            self_type origin_this = *this;
+            ++current;
+            return origin_this;
+        }
+
+        self_type &operator--() {
+            --current;
+            return *this;
+        }
+
+        self_type operator--(int) {
+            self_type origin_this = *this;
+            --current;
+            return origin_this;
+        }
+
+        self_type &operator+=(difference_type n) {
+            current += n;
+            return *this;
+        }
+
+        self_type &operator-=(difference_type n) {
+            current -= n;
+            return *this;
+        }
+
+        self_type operator+(difference_type n) const {
+            return self_type(current + n, function);
+        }
+
+        self_type operator-(difference_type n) const {
+            return self_type(current - n, function);
+        }
+
+        difference_type operator-(const self_type &other) const {
+            return current - other.current;
+        }
+
+        bool operator==(const self_type &other) const { return current == other.current; }
+
+        bool operator!=(const self_type &other) const { return current != other.current; }
+
+        bool operator<(const self_type &other) const { return current < other.current; }
+
+        bool operator>(const self_type &other) const { return current > other.current; }
+
+        bool operator<=(const self_type &other) const { return current <= other.current; }
+
+        bool operator>=(const self_type &other) const { return current >= other.current; }
+    };
+
+    template<typename Iterator, typename Function>
+    transform_iterator<Iterator, Function> operator+(typename iterator_traits<Iterator>::difference_type n,
+                                                     const transform_iterator<Iterator, Function> &it) {
+        return it + n;
+    }
+
+    /**
+     * 对底层视图的每个元素调用函数得到的视图，函数在解引用时才调用，结果不会保存
+     * 迭代器的类型和底层迭代器相同（连续迭代器降为随机访问迭代器）
+     * @tparam View 底层视图
+     * @tparam Function 一元函数
+     */
+    template<typename View, typename Function>
+    class transform_view : public view_base {
+    public:
+        typedef transform_iterator<typename ranges_detail::range_iterator<const View>::type, Function> iterator;
+        typedef typename iterator_traits<iterator>::value_type value_type;
+        typedef typename iterator_traits<iterator>::reference reference;
+        typedef typename iterator_traits<iterator>::difference_type difference_type;
+    private:
+        View base_view;
+        Function function;
+
+    public:
+        transform_view(View base_view_, Function function_) :
+                base_view(std::move(base_view_)), function(std::move(function_)) {}
+
+        iterator begin() const {
+            return iterator(base_view.begin(), Readable::addressof(function));
+        }
+
+        iterator end() const {
+            return iterator(base_view.end(), Readable::addressof(function));
+        }
+
+        bool empty() const {
+            return base_view.empty();
+        }
+
+        /**
+         * @note 底层迭代器不是随机访问迭代器时需要O(n)
+         */
+        difference_type size() const {
+            return Readable::distance(base_view.begin(), base_view.end());
+        }
+
+        /**
+         * @note 只用于随机访问迭代器
+         */
+        reference operator[](difference_type n) const {
+            return begin()[n];
+        }
+    };
+
+    namespace views {
+        template<typename Range, typename Function>
+        transform_view<typename view_of<Range>::type, Function> transform(Range &&range, Function function) {
+            return transform_view<typename view_of<Range>::type, Function>(views::all(std::forward<Range>(range)),
+                                                                            std::move(function));
+        }
+
+        template<typename Function>
+        struct transform_adaptor : public range_adaptor_base {
+            Function function;
+
+            explicit transform_adaptor(Function function_) : function(std::move(function_)) {}
+
+            template<typename Range>
+            transform_view<typename view_of<Range>::type, Function> operator()(Range &&range) const {
+                return views::transform(std::forward<Range>(range), function);
+            }
+        };
+
+        /**
+         * 用于 range | views::transform(f)
+         */
+        template<typename Function>
+        transform_adaptor<Function> transform(Function function) {
+            return transform_adaptor<Function>(std::move(function));
+        }
+    }
+}
+
+#endif //STL_FROM_SCRATCH_TRANSFORM_VIEW_H
@@ -0,0 +1,14 @@
+#ifndef STL_FROM_SCRATCH_VIEWS_H
+#define STL_FROM_SCRATCH_VIEWS_H
+
+#include "./iterator_range.h"
+#include "./filter_view.h"
+#include "./transform_view.h"
+#include "./take_view.h"
+#include "./drop_view.h"
+#include "./reverse_view.h"
+#include "./stride_view.h"
+#include "./chunk_view.h"
+#include "./join_view.h"
+
+#endif //STL_FROM_SCRATCH_VIEWS_H
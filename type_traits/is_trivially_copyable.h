@@ -0,0 +1,24 @@
+#ifndef STL_FROM_SCRATCH_IS_TRIVIALLY_COPYABLE_H
+#define STL_FROM_SCRATCH_IS_TRIVIALLY_COPYABLE_H
+
+#include <type_traits>
+#include "./integral_constant.h"
+
+namespace Readable {
+    /**
+     * 判断T是否可以平凡复制，即可以直接用memcpy/memmove复制它的对象表示
+     * 这个性质无法在语言内判断（需要知道复制构造、赋值、析构函数是不是编译器生成的平凡版本），
+     * 只能借助编译器内置的__is_trivially_copyable，其他编译器上退回到标准库的实现
+     */
+    template<typename T>
+    struct is_trivially_copyable : public Readable::integral_constant<bool,
+#if defined(__GNUC__) || defined(__clang__)
+            __is_trivially_copyable(T)
+#else
+            std::is_trivially_copyable<T>::value
+#endif
+    > {
+    };
+}
+
+#endif //STL_FROM_SCRATCH_IS_TRIVIALLY_COPYABLE_H
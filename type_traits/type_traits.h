@@ -8,5 +8,7 @@
 #include "./integral_constant.h"
 #include "./is_integral.h"
 #include "./is_same.h"
+#include "./remove_cv.h"
+#include "./is_trivially_copyable.h"
 
 #endif //STL_FROM_SCRATCH_TYPE_TRAITS_H
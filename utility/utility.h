@@ -1,5 +1,8 @@
 #ifndef STL_FROM_SCRATCH_UTILITY_H
 #define STL_FROM_SCRATCH_UTILITY_H
+
+#include <cstddef>
+
 namespace Readable {
     template<typename T1, typename T2>
     struct pair {
@@ -14,5 +17,32 @@ namespace Readable {
         return pair<T1, T2>(first, second);
     };
 
+    /**
+     * 编译期的整数序列，用于展开std::tuple等参数包（C++14的std::index_sequence）
+     */
+    template<std::size_t... Indices>
+    struct index_sequence {
+        static constexpr std::size_t size() {
+            return sizeof...(Indices);
+        }
+    };
+
+    namespace utility_detail {
+        template<std::size_t N, std::size_t... Indices>
+        struct make_index_sequence : public make_index_sequence<N - 1, N - 1, Indices...> {
+        };
+
+        template<std::size_t... Indices>
+        struct make_index_sequence<0, Indices...> {
+            typedef index_sequence<Indices...> type;
+        };
+    }
+
+    /**
+     * index_sequence<0, 1, ..., N - 1>
+     */
+    template<std::size_t N>
+    using make_index_sequence = typename utility_detail::make_index_sequence<N>::type;
+
 };
 #endif //STL_FROM_SCRATCH_UTILITY_H